@@ -0,0 +1,515 @@
+/**
+ * Copyright (C) 2025 zhmaksim <zhiharev.maxim.alexandrovich@yandex.ru>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/* Includes ---------------------------------------------------------------- */
+
+#include "bench.h"
+#include "crc.h"
+#include "cache.h"
+
+/* Private macros ---------------------------------------------------------- */
+
+/* Private constants ------------------------------------------------------- */
+
+#define BENCH_CONTROL_STEPS     1000
+#define BENCH_SWITCH_COUNT      1000
+
+#define BENCH_SWITCH_PRIORITY   (tskIDLE_PRIORITY + 2)
+
+#define BENCH_CLOCK_SIZE        0x1000          /* Данные расчета CRC-32 (байт) */
+#define BENCH_CLOCK_PASSES      16
+#define BENCH_CLOCK_HOLD        2000            /* Удержание профиля для измерения потребления (мс) */
+
+#define BENCH_CACHE_LINE        32              /* Строка D-Cache Cortex-M7 (байт) */
+#define BENCH_CACHE_NODES       512             /* Узлы списка: 16KB, помещается в D-Cache 32KB */
+#define BENCH_CACHE_LIST_PASSES 8
+#define BENCH_CACHE_MATRIX      32              /* Матрицы 32 x 32 (3 x 4KB) */
+#define BENCH_CACHE_CRC_SIZE    0x1000          /* Данные табличного CRC-32 (байт) */
+#define BENCH_CACHE_CRC_PASSES  4
+
+/* Private types ----------------------------------------------------------- */
+
+/**
+ * @brief           Определение структуры данных измерения переключения задач
+ */
+struct bench_switch {
+    TaskHandle_t owner;                         /*!< Задача, ожидающая результат */
+
+    TaskHandle_t ping;                          /*!< Задача измерения */
+
+    TaskHandle_t pong;                          /*!< Задача ответа */
+
+    bool fpu;                                   /*!< Задачи выполняют команды FPU */
+
+    uint32_t cycles;                            /*!< Такты CPU на одно переключение */
+};
+
+
+/**
+ * @brief           Определение структуры данных узла списка (узел занимает строку кэша)
+ */
+struct bench_node {
+    struct bench_node *next;                    /*!< Следующий узел */
+
+    uint32_t value;                             /*!< Данные узла */
+
+    uint8_t reserved[BENCH_CACHE_LINE - sizeof(void *) - sizeof(uint32_t)];
+};
+
+/* Private variables ------------------------------------------------------- */
+
+#if defined(__ARM_FP)
+/* Результат вычислений (исключает удаление кода компилятором) */
+static volatile float bench_sink;
+#endif
+
+static uint8_t bench_clock_data[BENCH_CLOCK_SIZE];
+
+static volatile uint32_t bench_clock_sink;
+
+/* Данные измерения кэша (AXI SRAM, кэшируется) */
+static struct bench_node bench_cache_nodes[BENCH_CACHE_NODES] __ALIGNED(BENCH_CACHE_LINE);
+static uint32_t bench_cache_a[BENCH_CACHE_MATRIX][BENCH_CACHE_MATRIX];
+static uint32_t bench_cache_b[BENCH_CACHE_MATRIX][BENCH_CACHE_MATRIX];
+static uint32_t bench_cache_c[BENCH_CACHE_MATRIX][BENCH_CACHE_MATRIX];
+static uint8_t bench_cache_data[BENCH_CACHE_CRC_SIZE];
+
+static volatile uint32_t bench_cache_sink;
+
+/* Private function prototypes --------------------------------------------- */
+
+static uint32_t bench_control(void);
+
+static uint32_t bench_switch(bool fpu);
+
+static void bench_ping(void *argv);
+
+static void bench_pong(void *argv);
+
+static void bench_touch_fpu(bool fpu);
+
+static uint32_t bench_clock_workload(void);
+
+static void bench_cache_prepare(void);
+
+static uint32_t bench_cache_list(void);
+
+static uint32_t bench_cache_matrix(void);
+
+static uint32_t bench_cache_crc(void);
+
+static void bench_cache_measure(struct bench_cache_workload *result, uint32_t (*workload)(void));
+
+/* Private user code ------------------------------------------------------- */
+
+/**
+ * @brief           Измерить производительность FPU
+ *
+ * @param[out]      report: Указатель на структуру данных результатов
+ *
+ * @note            Вызывается из задачи FreeRTOS. Переключение задач
+ *                  измеряется парой задач, передающих друг другу уведомление:
+ *                  с контекстом FPU PendSV дополнительно сохраняет S16-S31,
+ *                  а исключение - S0-S15/FPSCR (лениво, при использовании FPU)
+ */
+void bench_fpu(struct bench_fpu_report *report)
+{
+#if defined(__ARM_PCS_VFP)
+    report->hard_float = true;
+#else
+    report->hard_float = false;
+#endif /* __ARM_PCS_VFP */
+
+    /* Без контекста FPU - до первой команды FPU в задачах измерения */
+    report->switch_cycles = bench_switch(false);
+
+#if defined(__ARM_FP)
+    report->switch_fpu_cycles = bench_switch(true);
+    report->control_cycles = bench_control();
+#endif /* __ARM_FP */
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Измерить профили тактирования
+ *
+ * @param[out]      report: Указатель на структуру данных результатов
+ *
+ * @note            Вызывается из задачи FreeRTOS. Для каждого профиля
+ *                  измеряются длительность переключения и скорость
+ *                  программного CRC-32 (код и данные - в памяти App,
+ *                  ожидание памяти не масштабируется с частотой CPU).
+ *                  Затем профиль удерживается BENCH_CLOCK_HOLD мс для
+ *                  измерения потребления, по завершении восстанавливается
+ *                  исходный профиль
+ */
+void bench_clock(struct bench_clock_report *report)
+{
+    uint32_t initial = rcc_get_profile();
+
+    for (uint32_t i = 0; i < BENCH_CLOCK_SIZE; i++)
+        bench_clock_data[i] = i * 7 + 1;
+
+    for (uint32_t profile = 0; profile < RCC_PROFILE_COUNT; profile++) {
+        struct bench_clock_profile *result = &report->profile[profile];
+
+        if (rcc_set_profile(profile) != RCC_OK)
+            continue;
+
+        uint32_t cpu_mhz = rcc_get_cpu_hz() / 1000000;
+        uint32_t us = bench_clock_workload() / cpu_mhz;
+
+        result->cpu_clock = rcc_get_cpu_hz();
+        result->switch_time = rcc_get_switch_time();
+        result->crc_rate = us != 0 ? (BENCH_CLOCK_SIZE * BENCH_CLOCK_PASSES / 1024) * 1000000 / us : 0;
+        result->crc_rate_per_mhz = result->crc_rate / cpu_mhz;
+
+        vTaskDelay(pdMS_TO_TICKS(BENCH_CLOCK_HOLD));
+    }
+
+    rcc_set_profile(initial < RCC_PROFILE_COUNT ? initial : RCC_PROFILE_600MHZ);
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Измерить нагрузки, чувствительные к кэшу
+ *
+ * @param[out]      report: Указатель на структуру данных результатов
+ *
+ * @note            Вызывается из задачи FreeRTOS. Каждая нагрузка
+ *                  выполняется с включенными I-Cache/D-Cache и с
+ *                  выключенными (cache_deinit) - сравнение до/после
+ *                  cache_init(). Код App выполняется из XSPI (XIP) или
+ *                  ОЗУ, данные - в AXI SRAM. Планировщик приостановлен:
+ *                  другие задачи не выполняются без кэша
+ */
+void bench_cache(struct bench_cache_report *report)
+{
+    bench_cache_prepare();
+
+    bench_cache_measure(&report->list, bench_cache_list);
+    bench_cache_measure(&report->matrix, bench_cache_matrix);
+    bench_cache_measure(&report->crc, bench_cache_crc);
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Измерить шаг контура управления
+ *
+ * @return          Такты CPU на шаг
+ *
+ * @note            ПИД-регулятор управляет объектом - фильтром второго порядка
+ */
+static uint32_t bench_control(void)
+{
+#if defined(__ARM_FP)
+    const float kp = 1.2f, ki = 0.05f, kd = 0.01f;
+    const float b0 = 0.0675f, b1 = 0.1349f, b2 = 0.0675f, a1 = -1.1430f, a2 = 0.4128f;
+
+    float integral = 0.0f, previous = 0.0f;
+    float x1 = 0.0f, x2 = 0.0f, y1 = 0.0f, y2 = 0.0f;
+
+    uint32_t cycles = READ_REG(DWT->CYCCNT);
+
+    for (uint32_t i = 0; i < BENCH_CONTROL_STEPS; i++) {
+        float error = 1.0f - y1;
+
+        integral += ki * error;
+        float u = kp * error + integral + kd * (error - previous);
+        previous = error;
+
+        float y = b0 * u + b1 * x1 + b2 * x2 - a1 * y1 - a2 * y2;
+        x2 = x1;
+        x1 = u;
+        y2 = y1;
+        y1 = y;
+    }
+
+    cycles = READ_REG(DWT->CYCCNT) - cycles;
+
+    bench_sink = y1;
+
+    return cycles / BENCH_CONTROL_STEPS;
+#else
+    return 0;
+#endif /* __ARM_FP */
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Измерить переключение задач
+ *
+ * @param[in]       fpu: Задачи выполняют команды FPU
+ * @return          Такты CPU на одно переключение (с учетом уведомления)
+ */
+static uint32_t bench_switch(bool fpu)
+{
+    struct bench_switch bench = {
+        .owner = xTaskGetCurrentTaskHandle(),
+        .fpu = fpu,
+    };
+
+    if (xTaskCreate(bench_pong, "bench_pong", configMINIMAL_STACK_SIZE,
+                    &bench, BENCH_SWITCH_PRIORITY, &bench.pong) != pdPASS) {
+        return 0;
+    }
+
+    if (xTaskCreate(bench_ping, "bench_ping", configMINIMAL_STACK_SIZE,
+                    &bench, BENCH_SWITCH_PRIORITY, &bench.ping) != pdPASS) {
+        vTaskDelete(bench.pong);
+        return 0;
+    }
+
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+    return bench.cycles;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Задача измерения переключения
+ *
+ * @param[in]       argv: Указатель на структуру данных измерения
+ *
+ * @note            Каждая итерация - два переключения: ping -> pong -> ping
+ */
+static void bench_ping(void *argv)
+{
+    struct bench_switch *bench = argv;
+
+    uint32_t cycles = READ_REG(DWT->CYCCNT);
+
+    for (uint32_t i = 0; i < BENCH_SWITCH_COUNT; i++) {
+        bench_touch_fpu(bench->fpu);
+
+        xTaskNotifyGive(bench->pong);
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    }
+
+    cycles = READ_REG(DWT->CYCCNT) - cycles;
+
+    bench->cycles = cycles / (BENCH_SWITCH_COUNT * 2);
+
+    vTaskDelete(bench->pong);
+    xTaskNotifyGive(bench->owner);
+    vTaskDelete(NULL);
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Задача ответа
+ *
+ * @param[in]       argv: Указатель на структуру данных измерения
+ */
+static void bench_pong(void *argv)
+{
+    struct bench_switch *bench = argv;
+
+    while (true) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        bench_touch_fpu(bench->fpu);
+
+        xTaskNotifyGive(bench->ping);
+    }
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Выполнить команду FPU (задача получает контекст FPU)
+ *
+ * @param[in]       fpu: Выполнить команду
+ */
+static void bench_touch_fpu(bool fpu)
+{
+#if defined(__ARM_FP)
+    if (fpu)
+        bench_sink = bench_sink * 0.5f + 1.0f;
+#endif /* __ARM_FP */
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Выполнить нагрузку измерения профиля тактирования
+ *
+ * @return          Такты CPU
+ */
+static uint32_t bench_clock_workload(void)
+{
+    uint32_t crc = CRC_INITIAL;
+    uint32_t cycles = READ_REG(DWT->CYCCNT);
+
+    for (uint32_t i = 0; i < BENCH_CLOCK_PASSES; i++)
+        crc = crc_calculate_software(crc, bench_clock_data, BENCH_CLOCK_SIZE);
+
+    cycles = READ_REG(DWT->CYCCNT) - cycles;
+
+    bench_clock_sink = crc;
+
+    return cycles;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Подготовить данные измерения кэша
+ *
+ * @note            Узлы списка связываются в один цикл в случайном порядке
+ *                  (алгоритм Саттоло, LCG): соседние узлы не в соседних строках
+ */
+static void bench_cache_prepare(void)
+{
+    static uint32_t order[BENCH_CACHE_NODES];
+    uint32_t seed = 1;
+
+    for (uint32_t i = 0; i < BENCH_CACHE_NODES; i++)
+        order[i] = i;
+
+    for (uint32_t i = BENCH_CACHE_NODES - 1; i > 0; i--) {
+        seed = seed * 1664525 + 1013904223;
+
+        uint32_t j = (seed >> 8) % i;
+        uint32_t swap = order[i];
+
+        order[i] = order[j];
+        order[j] = swap;
+    }
+
+    for (uint32_t i = 0; i < BENCH_CACHE_NODES; i++) {
+        bench_cache_nodes[order[i]].next = &bench_cache_nodes[order[(i + 1) % BENCH_CACHE_NODES]];
+        bench_cache_nodes[order[i]].value = i;
+    }
+
+    for (uint32_t i = 0; i < BENCH_CACHE_MATRIX; i++) {
+        for (uint32_t j = 0; j < BENCH_CACHE_MATRIX; j++) {
+            bench_cache_a[i][j] = i * 3 + j;
+            bench_cache_b[i][j] = i ^ (j * 5);
+        }
+    }
+
+    for (uint32_t i = 0; i < BENCH_CACHE_CRC_SIZE; i++)
+        bench_cache_data[i] = i * 7 + 1;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Обойти связанный список
+ *
+ * @return          Такты CPU
+ */
+static uint32_t bench_cache_list(void)
+{
+    const struct bench_node *node = &bench_cache_nodes[0];
+    uint32_t sum = 0;
+    uint32_t cycles = READ_REG(DWT->CYCCNT);
+
+    for (uint32_t i = 0; i < BENCH_CACHE_NODES * BENCH_CACHE_LIST_PASSES; i++) {
+        sum += node->value;
+        node = node->next;
+    }
+
+    cycles = READ_REG(DWT->CYCCNT) - cycles;
+
+    bench_cache_sink = sum;
+
+    return cycles;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Перемножить матрицы
+ *
+ * @return          Такты CPU
+ */
+static uint32_t bench_cache_matrix(void)
+{
+    uint32_t cycles = READ_REG(DWT->CYCCNT);
+
+    for (uint32_t i = 0; i < BENCH_CACHE_MATRIX; i++) {
+        for (uint32_t j = 0; j < BENCH_CACHE_MATRIX; j++)
+            bench_cache_c[i][j] = 0;
+
+        /* Порядок i-k-j: строки B и C читаются последовательно */
+        for (uint32_t k = 0; k < BENCH_CACHE_MATRIX; k++) {
+            uint32_t a = bench_cache_a[i][k];
+
+            for (uint32_t j = 0; j < BENCH_CACHE_MATRIX; j++)
+                bench_cache_c[i][j] += a * bench_cache_b[k][j];
+        }
+    }
+
+    cycles = READ_REG(DWT->CYCCNT) - cycles;
+
+    bench_cache_sink = bench_cache_c[BENCH_CACHE_MATRIX - 1][BENCH_CACHE_MATRIX - 1];
+
+    return cycles;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Рассчитать табличный CRC-32
+ *
+ * @return          Такты CPU
+ */
+static uint32_t bench_cache_crc(void)
+{
+    uint32_t crc = CRC_INITIAL;
+    uint32_t cycles = READ_REG(DWT->CYCCNT);
+
+    for (uint32_t i = 0; i < BENCH_CACHE_CRC_PASSES; i++)
+        crc = crc_calculate_software(crc, bench_cache_data, BENCH_CACHE_CRC_SIZE);
+
+    cycles = READ_REG(DWT->CYCCNT) - cycles;
+
+    bench_cache_sink = crc;
+
+    return cycles;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Измерить нагрузку с кэшем и без
+ *
+ * @param[out]      result: Указатель на результат нагрузки
+ * @param[in]       workload: Нагрузка, возвращает такты CPU
+ *
+ * @note            Первый запуск с кэшем заполняет его, измеряется второй.
+ *                  Ускорение рассчитывается делением 32 бит (libgcc исключена)
+ */
+static void bench_cache_measure(struct bench_cache_workload *result, uint32_t (*workload)(void))
+{
+    vTaskSuspendAll();
+
+    (void) workload();
+    result->cached_cycles = workload();
+
+    cache_deinit();
+    result->uncached_cycles = workload();
+    cache_init();
+
+    (void) xTaskResumeAll();
+
+    uint32_t cached = result->cached_cycles;
+    uint32_t uncached = result->uncached_cycles;
+
+    while (uncached > UINT32_MAX / 100) {
+        uncached >>= 1;
+        cached >>= 1;
+    }
+
+    result->speedup = cached != 0 ? uncached * 100 / cached : 0;
+}
+/* ------------------------------------------------------------------------- */
@@ -0,0 +1,127 @@
+/**
+ * Copyright (C) 2025 zhmaksim <zhiharev.maxim.alexandrovich@yandex.ru>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef BENCH_H_
+#define BENCH_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/* Includes ---------------------------------------------------------------- */
+
+#include "main.h"
+#include "rcc.h"
+
+/* Exported macros --------------------------------------------------------- */
+
+/* Exported constants ------------------------------------------------------ */
+
+/* Измерения при запуске App (-DBENCH_ENABLE=1): bench_clock() удерживает
+   каждый профиль тактирования BENCH_CLOCK_HOLD мс */
+#ifndef BENCH_ENABLE
+#define BENCH_ENABLE                    0
+#endif /* BENCH_ENABLE */
+
+/* Exported types ---------------------------------------------------------- */
+
+/**
+ * @brief           Определение структуры данных результатов измерения FPU
+ *
+ * @note            Заполняется bench_fpu() для просмотра отладчиком,
+ *                  0 - измерение недоступно в профиле сборки без FPU
+ */
+struct bench_fpu_report {
+    bool hard_float;                            /*!< Профиль сборки -mfloat-abi=hard */
+
+    uint32_t control_cycles;                    /*!< Такты CPU на шаг контура управления (ПИД + биквад, float) */
+
+    uint32_t switch_cycles;                     /*!< Такты CPU на переключение задач без контекста FPU */
+
+    uint32_t switch_fpu_cycles;                 /*!< Такты CPU на переключение задач с контекстом FPU */
+};
+
+
+/**
+ * @brief           Определение структуры данных результатов измерения профиля тактирования
+ */
+struct bench_clock_profile {
+    uint32_t cpu_clock;                         /*!< Частота CPU (Гц) */
+
+    uint32_t switch_time;                       /*!< Длительность переключения в профиль (нс) */
+
+    uint32_t crc_rate;                          /*!< Скорость программного CRC-32 (КБ/с) */
+
+    uint32_t crc_rate_per_mhz;                  /*!< Скорость на 1MHz CPU (КБ/с), падает при ожидании памяти */
+};
+
+
+/**
+ * @brief           Определение структуры данных результатов измерения профилей тактирования
+ *
+ * @note            Заполняется bench_clock() для просмотра отладчиком.
+ *                  Потребление измеряется внешним прибором (IDD) в окнах
+ *                  BENCH_CLOCK_HOLD мс, в которых удерживается каждый профиль
+ */
+struct bench_clock_report {
+    struct bench_clock_profile profile[RCC_PROFILE_COUNT];
+};
+
+
+/**
+ * @brief           Определение структуры данных измерения нагрузки с кэшем и без
+ */
+struct bench_cache_workload {
+    uint32_t cached_cycles;                     /*!< Такты CPU с I-Cache и D-Cache */
+
+    uint32_t uncached_cycles;                   /*!< Такты CPU с выключенными I-Cache и D-Cache */
+
+    uint32_t speedup;                           /*!< Ускорение кэшем (0.01) */
+};
+
+
+/**
+ * @brief           Определение структуры данных результатов измерения кэша
+ *
+ * @note            Заполняется bench_cache() для просмотра отладчиком:
+ *                  сравнение до/после включения кэша (cache_init)
+ */
+struct bench_cache_report {
+    struct bench_cache_workload list;           /*!< Обход связанного списка (зависимые чтения) */
+
+    struct bench_cache_workload matrix;         /*!< Умножение матриц (повторное использование строк) */
+
+    struct bench_cache_workload crc;            /*!< Табличный CRC-32 (состояние в таблице 1KB) */
+};
+
+/* Exported variables ------------------------------------------------------ */
+
+/* Exported function prototypes -------------------------------------------- */
+
+void bench_fpu(struct bench_fpu_report *report);
+
+void bench_clock(struct bench_clock_report *report);
+
+void bench_cache(struct bench_cache_report *report);
+
+/* Exported callback function prototypes ----------------------------------- */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* BENCH_H_ */
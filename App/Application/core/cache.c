@@ -0,0 +1,95 @@
+/**
+ * Copyright (C) 2025 zhmaksim <zhiharev.maxim.alexandrovich@yandex.ru>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/* Includes ---------------------------------------------------------------- */
+
+#include "cache.h"
+
+/* Private macros ---------------------------------------------------------- */
+
+/* Private constants ------------------------------------------------------- */
+
+/* Private types ----------------------------------------------------------- */
+
+/* Private variables ------------------------------------------------------- */
+
+/* Private function prototypes --------------------------------------------- */
+
+/* Private user code ------------------------------------------------------- */
+
+/**
+ * @brief           Включить I-Cache и D-Cache
+ *
+ * @note            Вызывается после mpu_init()
+ */
+void cache_init(void)
+{
+    SCB_EnableICache();
+    SCB_EnableDCache();
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Выключить I-Cache и D-Cache
+ *
+ * @note            Содержимое D-Cache записывается в память перед выключением
+ */
+void cache_deinit(void)
+{
+    SCB_DisableDCache();
+    SCB_DisableICache();
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Записать содержимое D-Cache в память (перед передачей DMA)
+ *
+ * @param[in]       addr: Адрес буфера
+ * @param[in]       size: Размер буфера (байт)
+ */
+void cache_clean(const volatile void *addr, size_t size)
+{
+    SCB_CleanDCache_by_Addr((volatile void *) addr, (int32_t) size);
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Сбросить D-Cache для буфера (после приема DMA)
+ *
+ * @param[in]       addr: Адрес буфера
+ * @param[in]       size: Размер буфера (байт)
+ *
+ * @note            Буфер должен быть выровнен на 32 байта, иначе соседние
+ *                  данные в той же строке кэша будут потеряны
+ */
+void cache_invalidate(volatile void *addr, size_t size)
+{
+    SCB_InvalidateDCache_by_Addr(addr, (int32_t) size);
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Записать в память и сбросить D-Cache для буфера
+ *
+ * @param[in]       addr: Адрес буфера
+ * @param[in]       size: Размер буфера (байт)
+ */
+void cache_clean_invalidate(volatile void *addr, size_t size)
+{
+    SCB_CleanInvalidateDCache_by_Addr(addr, (int32_t) size);
+}
+/* ------------------------------------------------------------------------- */
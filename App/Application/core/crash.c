@@ -0,0 +1,236 @@
+/**
+ * Copyright (C) 2025 zhmaksim <zhiharev.maxim.alexandrovich@yandex.ru>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/* Includes ---------------------------------------------------------------- */
+
+#include "crash.h"
+
+/* Private macros ---------------------------------------------------------- */
+
+/* Private constants ------------------------------------------------------- */
+
+#define CRASH_FRAME_SIZE                0x20            /* Кадр исключения без контекста FPU (байт) */
+#define CRASH_FRAME_FPU_SIZE            0x68            /* Кадр исключения с контекстом FPU (байт) */
+
+#define CRASH_EXC_RETURN_FTYPE          (1UL << 4)      /* EXC_RETURN: кадр без контекста FPU */
+#define CRASH_XPSR_ALIGN                (1UL << 9)      /* xPSR: стек выровнен на 8 байт при входе */
+
+#define CRASH_SRAM_SIZE                 0x72000         /* AXI SRAM (linker_stm32h7s3xx.ld) */
+
+/* Private types ----------------------------------------------------------- */
+
+/* Private variables ------------------------------------------------------- */
+
+static struct crash_record *const record = (struct crash_record *) CRASH_ADDRESS;
+
+static struct crash_record crash;
+
+static bool valid;
+
+/* Private function prototypes --------------------------------------------- */
+
+static bool crash_is_ram(uint32_t address, uint32_t size);
+
+static uint32_t crash_checksum(const struct crash_record *block);
+
+/* Private user code ------------------------------------------------------- */
+
+/**
+ * @brief           Прочитать запись о сбое предыдущего запуска
+ *
+ * @note            Запись копируется и отмечается прочитанной, счетчик
+ *                  сбоев сохраняется до выключения питания
+ */
+void crash_init(void)
+{
+    /* Выключить защиту от записи Backup домена */
+    SET_BIT(PWR->CR1, PWR_CR1_DBP_Msk);
+
+    /* Включить тактирование BKPSRAM */
+    SET_BIT(RCC->AHB4ENR, RCC_AHB4ENR_BKPRAMEN_Msk);
+
+    /* Включить отдельные обработчики MemManage, BusFault и UsageFault
+     * (иначе сбой фиксируется как HardFault без уточнения) */
+    SET_BIT(SCB->SHCSR, SCB_SHCSR_MEMFAULTENA_Msk | SCB_SHCSR_BUSFAULTENA_Msk | SCB_SHCSR_USGFAULTENA_Msk);
+
+    if (record->magic != CRASH_MAGIC
+     || record->version != CRASH_VERSION
+     || record->size != sizeof(struct crash_record)
+     || record->checksum != crash_checksum(record)
+     || record->reported)
+        return;
+
+    crash = *record;
+    valid = true;
+
+    record->reported = true;
+    record->checksum = crash_checksum(record);
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Получить запись о сбое предыдущего запуска
+ *
+ * @return          Указатель на запись (NULL - предыдущий запуск без сбоя)
+ */
+const struct crash_record *crash_get(void)
+{
+    return valid ? &crash : NULL;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Сохранить запись о сбое и перезапустить МК
+ *
+ * @note            Вызывается из обработчика исключения (CRASH_FAULT_ENTRY).
+ *                  Запись занимает единицы микросекунд: без ожидания
+ *                  периферии и без обращения к стеку вне ОЗУ, повторный
+ *                  сбой внутри обработчика исключен. Код выполняется из
+ *                  ITCM (вызываемые функции FreeRTOS - App/itcm_functions.ld):
+ *                  сбой XSPI не повторяется при выборке команд обработчика
+ *
+ * @param[in]       frame: Указатель на кадр исключения
+ * @param[in]       exc_return: Значение EXC_RETURN
+ */
+__ITCM __USED void crash_fault(const uint32_t *frame, uint32_t exc_return)
+{
+    __disable_irq();
+
+    /* Выключить защиту от записи Backup домена */
+    SET_BIT(PWR->CR1, PWR_CR1_DBP_Msk);
+    SET_BIT(RCC->AHB4ENR, RCC_AHB4ENR_BKPRAMEN_Msk);
+
+    bool repeated = record->magic == CRASH_MAGIC
+                 && record->version == CRASH_VERSION
+                 && record->size == sizeof(struct crash_record)
+                 && record->checksum == crash_checksum(record);
+
+    record->magic = CRASH_MAGIC;
+    record->version = CRASH_VERSION;
+    record->size = sizeof(struct crash_record);
+    record->count = repeated ? record->count + 1 : 1;
+    record->reported = false;
+    record->exception = __get_IPSR();
+    record->exc_return = exc_return;
+
+    record->cfsr = READ_REG(SCB->CFSR);
+    record->hfsr = READ_REG(SCB->HFSR);
+    record->mmfar = READ_REG(SCB->MMFAR);
+    record->bfar = READ_REG(SCB->BFAR);
+
+    record->tick = xTaskGetTickCountFromISR();
+
+    /* Кадр исключения (недоступен при переполнении стека) */
+    record->sp = 0;
+    record->r0 = record->r1 = record->r2 = record->r3 = 0;
+    record->r12 = record->lr = record->pc = record->xpsr = 0;
+
+    for (uint32_t i = 0; i < CRASH_STACK_SIZE; i++)
+        record->stack[i] = 0;
+
+    if (crash_is_ram((uint32_t) frame, CRASH_FRAME_SIZE)) {
+        record->r0 = frame[0];
+        record->r1 = frame[1];
+        record->r2 = frame[2];
+        record->r3 = frame[3];
+        record->r12 = frame[4];
+        record->lr = frame[5];
+        record->pc = frame[6];
+        record->xpsr = frame[7];
+
+        /* Стек до исключения: после кадра (с контекстом FPU) и выравнивания */
+        uint32_t sp = (uint32_t) frame
+                    + (READ_BIT(exc_return, CRASH_EXC_RETURN_FTYPE) ? CRASH_FRAME_SIZE : CRASH_FRAME_FPU_SIZE)
+                    + (READ_BIT(record->xpsr, CRASH_XPSR_ALIGN) ? 4 : 0);
+
+        record->sp = sp;
+
+        for (uint32_t i = 0; i < CRASH_STACK_SIZE && crash_is_ram(sp, 4); i++, sp += 4)
+            record->stack[i] = *(const uint32_t *) sp;
+    }
+
+    /* Имя задачи: TCB доступен после запуска планировщика. Сбой мог
+     * повредить pxCurrentTCB - TCB и имя читаются только из ОЗУ App */
+    TaskHandle_t task = xTaskGetCurrentTaskHandle();
+    const char *name = "";
+
+    if (xTaskGetSchedulerState() != taskSCHEDULER_NOT_STARTED
+            && crash_is_ram((uint32_t) task, sizeof(StaticTask_t))) {
+        const char *task_name = pcTaskGetName(task);
+
+        if (crash_is_ram((uint32_t) task_name, configMAX_TASK_NAME_LEN))
+            name = task_name;
+    }
+
+    for (uint32_t i = 0; i < configMAX_TASK_NAME_LEN; i++) {
+        record->task[i] = *name;
+
+        if (*name != '\0')
+            name++;
+    }
+
+    record->checksum = crash_checksum(record);
+
+    /* Перезапустить МК (SRAM_BKP не кэшируется, запись уже в памяти).
+     * NVIC_SystemReset() без встраивания размещается во внешней FLASH */
+    __DSB();
+    WRITE_REG(SCB->AIRCR,
+              0x05FA << SCB_AIRCR_VECTKEY_Pos
+            | READ_BIT(SCB->AIRCR, SCB_AIRCR_PRIGROUP_Msk)
+            | SCB_AIRCR_SYSRESETREQ_Msk);
+    __DSB();
+
+    while (true)
+        __NOP();
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Проверить, что область находится в ОЗУ App
+ *
+ * @param[in]       address: Адрес области
+ * @param[in]       size: Размер области (байт)
+ * @return          Область в DTCM или AXI SRAM и выровнена на слово
+ */
+__ITCM static bool crash_is_ram(uint32_t address, uint32_t size)
+{
+    if (address & 0x03)
+        return false;
+
+    return (address >= DTCM_BASE && address + size <= DTCM_BASE + DTCM_SIZE)
+        || (address >= SRAM1_AXI_BASE && address + size <= SRAM1_AXI_BASE + CRASH_SRAM_SIZE);
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Вычислить контрольную сумму записи
+ *
+ * @param[in]       block: Указатель на запись
+ * @return          Контрольная сумма
+ */
+__ITCM static uint32_t crash_checksum(const struct crash_record *block)
+{
+    const uint32_t *word = (const uint32_t *) block;
+    uint32_t checksum = 0;
+
+    /* Все слова после magic до checksum */
+    for (uint32_t i = 1; i < offsetof(struct crash_record, checksum) / 4; i++)
+        checksum = (checksum << 5 | checksum >> 27) ^ word[i];
+
+    return checksum;
+}
+/* ------------------------------------------------------------------------- */
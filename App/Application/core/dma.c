@@ -0,0 +1,164 @@
+/**
+ * Copyright (C) 2025 zhmaksim <zhiharev.maxim.alexandrovich@yandex.ru>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/* Includes ---------------------------------------------------------------- */
+
+#include "dma.h"
+
+/* Private macros ---------------------------------------------------------- */
+
+/* Private constants ------------------------------------------------------- */
+
+/* Максимальный размер блока (BNDT 16 бит, кратно ширине данных) */
+#define DMA_BLOCK_SIZE          0xFFFC
+#define DMA_BLOCK_SIZE_64       0xFFF8
+
+/* Private types ----------------------------------------------------------- */
+
+/* Private variables ------------------------------------------------------- */
+
+/* Private function prototypes --------------------------------------------- */
+
+static void dma_start_block(struct dma *dma);
+
+/* Private user code ------------------------------------------------------- */
+
+/**
+ * @brief           Инициализировать DMA
+ */
+void dma_init(void)
+{
+    /* Включить тактирование GPDMA1 и HPDMA1 */
+    SET_BIT(RCC->AHB1ENR, RCC_AHB1ENR_GPDMA1EN_Msk);
+    SET_BIT(RCC->AHB5ENR, RCC_AHB5ENR_HPDMA1EN_Msk);
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Запустить передачу память-память (по программному запросу)
+ *
+ * @param[in]       dma: Указатель на структуру данных передачи (с заданным каналом)
+ * @param[in]       src: Адрес источника
+ * @param[in]       dst: Адрес приемника (память или регистр данных периферии)
+ * @param[in]       size: Размер данных (байт, кратно 4 или 8 для DMA_WIDTH_64)
+ * @param[in]       flags: Флаги DMA_SRC_INC, DMA_DST_INC, DMA_WIDTH_64
+ *
+ * @note            Передача разбивается на блоки по DMA_BLOCK_SIZE,
+ *                  продолжение выполняется в dma_process()
+ */
+void dma_start(struct dma *dma, uint32_t src, uint32_t dst, uint32_t size, uint32_t flags)
+{
+    uint32_t width = flags & DMA_WIDTH_64 ? 0x03 : 0x02;
+
+    assert(size % (1 << width) == 0);
+
+    dma->src = src;
+    dma->dst = dst;
+    dma->size = size;
+    dma->flags = flags;
+
+    /* Выключить канал перед настройкой */
+    CLEAR_BIT(dma->channel->CCR, DMA_CCR_EN_Msk);
+
+    /* Настроить ширину данных = 32/64 бит и инкремент адресов */
+    WRITE_REG(dma->channel->CTR1,
+              width << DMA_CTR1_SDW_LOG2_Pos
+            | width << DMA_CTR1_DDW_LOG2_Pos
+            | (flags & DMA_SRC_INC ? DMA_CTR1_SINC_Msk : 0)
+            | (flags & DMA_DST_INC ? DMA_CTR1_DINC_Msk : 0));
+
+    /* Настроить программный запрос (память-память) */
+    WRITE_REG(dma->channel->CTR2, DMA_CTR2_SWREQ_Msk);
+
+    /* Выключить связанный список */
+    CLEAR_REG(dma->channel->CLLR);
+
+    dma_start_block(dma);
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Продолжить передачу
+ *
+ * @param[in]       dma: Указатель на структуру данных передачи
+ * @return          Статус:
+ *                      - DMA_ERROR
+ *                      - DMA_BUSY
+ *                      - DMA_OK
+ */
+int32_t dma_process(struct dma *dma)
+{
+    uint32_t status = READ_REG(dma->channel->CSR);
+
+    if (READ_BIT(status,
+                 DMA_CSR_DTEF_Msk
+               | DMA_CSR_ULEF_Msk
+               | DMA_CSR_USEF_Msk)) {
+        /* Ошибка передачи */
+        CLEAR_BIT(dma->channel->CCR, DMA_CCR_EN_Msk);
+        return DMA_ERROR;
+    } else if (!READ_BIT(status, DMA_CSR_TCF_Msk)) {
+        return DMA_BUSY;
+    }
+
+    /* Блок передан */
+    if (dma->flags & DMA_SRC_INC)
+        dma->src += dma->block;
+    if (dma->flags & DMA_DST_INC)
+        dma->dst += dma->block;
+
+    dma->size -= dma->block;
+
+    if (dma->size == 0)
+        return DMA_OK;
+
+    dma_start_block(dma);
+
+    return DMA_BUSY;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Запустить передачу очередного блока
+ *
+ * @param[in]       dma: Указатель на структуру данных передачи
+ */
+static void dma_start_block(struct dma *dma)
+{
+    uint32_t block_size = dma->flags & DMA_WIDTH_64 ? DMA_BLOCK_SIZE_64 : DMA_BLOCK_SIZE;
+
+    dma->block = dma->size > block_size ? block_size : dma->size;
+
+    /* Сбросить флаги канала */
+    WRITE_REG(dma->channel->CFCR,
+              DMA_CFCR_TCF_Msk
+            | DMA_CFCR_HTF_Msk
+            | DMA_CFCR_DTEF_Msk
+            | DMA_CFCR_ULEF_Msk
+            | DMA_CFCR_USEF_Msk
+            | DMA_CFCR_SUSPF_Msk
+            | DMA_CFCR_TOF_Msk);
+
+    /* Настроить размер и адреса блока */
+    WRITE_REG(dma->channel->CBR1, dma->block << DMA_CBR1_BNDT_Pos);
+    WRITE_REG(dma->channel->CSAR, dma->src);
+    WRITE_REG(dma->channel->CDAR, dma->dst);
+
+    /* Включить канал */
+    SET_BIT(dma->channel->CCR, DMA_CCR_EN_Msk);
+}
+/* ------------------------------------------------------------------------- */
@@ -0,0 +1,112 @@
+/**
+ * Copyright (C) 2025 zhmaksim <zhiharev.maxim.alexandrovich@yandex.ru>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/* Includes ---------------------------------------------------------------- */
+
+#include "dts.h"
+#include "rcc.h"
+
+/* Private macros ---------------------------------------------------------- */
+
+/* Private constants ------------------------------------------------------- */
+
+#define DTS_SAMPLES              15             /* Длительность измерения (периодов LSE) */
+
+/* Температура калибровки T0 (0.1 °C) по полю TS1_T0 */
+#define DTS_T0_30C               300
+#define DTS_T0_130C              1300
+
+/* Private types ----------------------------------------------------------- */
+
+/* Private variables ------------------------------------------------------- */
+
+static bool started;
+
+/* Private function prototypes --------------------------------------------- */
+
+/* Private user code ------------------------------------------------------- */
+
+/**
+ * @brief           Инициализировать DTS
+ *
+ * @note            Опорная частота - LSE (не зависит от профиля тактирования),
+ *                  быстрое измерение без калибровки. Измерение запускается
+ *                  в dts_process() после готовности LSE и DTS
+ */
+void dts_init(void)
+{
+    /* Включить тактирование DTS */
+    SET_BIT(RCC->APB4ENR, RCC_APB4ENR_DTSEN_Msk);
+
+    /* Настроить опорную частоту = LSE, быстрое измерение, время измерения */
+    WRITE_REG(DTS->CFGR1,
+              DTS_CFGR1_REFCLK_SEL_Msk
+            | DTS_CFGR1_Q_MEAS_OPT_Msk
+            | DTS_SAMPLES << DTS_CFGR1_TS1_SMP_TIME_Pos);
+
+    SET_BIT(DTS->CFGR1, DTS_CFGR1_TS1_EN_Msk);
+
+    started = false;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Получить результат измерения температуры
+ *
+ * @param[out]      temperature: Указатель на температуру кристалла (0.1 °C)
+ * @return          Статус:
+ *                      - DTS_ERROR
+ *                      - DTS_BUSY
+ *                      - DTS_OK
+ *
+ * @note            DTS измеряет непрерывно, функция возвращает DTS_OK
+ *                  при наличии нового измерения
+ */
+int32_t dts_process(int32_t *temperature)
+{
+    if (!started) {
+        /* Ожидание готовности LSE и DTS */
+        if (!rcc_is_lse_ready() || !READ_BIT(DTS->SR, DTS_SR_TS1_RDY_Msk))
+            return DTS_BUSY;
+
+        SET_BIT(DTS->CFGR1, DTS_CFGR1_TS1_START_Msk);
+        started = true;
+    }
+
+    if (!READ_BIT(DTS->SR, DTS_SR_TS1_ITEF_Msk))
+        return DTS_BUSY;
+
+    WRITE_REG(DTS->ICIFR, DTS_ICIFR_TS1_CITEF_Msk);
+
+    uint32_t count = READ_BIT(DTS->DR, DTS_DR_TS1_MFREQ_Msk);
+    uint32_t ramp = READ_BIT(DTS->RAMPVALR, DTS_RAMPVALR_TS1_RAMP_COEFF_Msk);
+    uint32_t t0 = READ_BIT(DTS->T0VALR1, DTS_T0VALR1_TS1_T0_Msk) >> DTS_T0VALR1_TS1_T0_Pos;
+    uint32_t t0_frequency = READ_BIT(DTS->T0VALR1, DTS_T0VALR1_TS1_FMT0_Msk) * 100;
+
+    if (count == 0 || ramp == 0)
+        return DTS_ERROR;
+
+    /* Частота генератора DTS: count периодов за DTS_SAMPLES периодов LSE (Гц) */
+    int32_t frequency = RCC_LSE_CLOCK * count / DTS_SAMPLES;
+
+    /* Наклон характеристики ramp (Гц/°C) от точки калибровки T0 */
+    *temperature = (t0 == 0 ? DTS_T0_30C : DTS_T0_130C)
+                 + (frequency - (int32_t) t0_frequency) * 10 / (int32_t) ramp;
+
+    return DTS_OK;
+}
+/* ------------------------------------------------------------------------- */
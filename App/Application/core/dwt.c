@@ -0,0 +1,110 @@
+/**
+ * Copyright (C) 2025 zhmaksim <zhiharev.maxim.alexandrovich@yandex.ru>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/* Includes ---------------------------------------------------------------- */
+
+#include "dwt.h"
+#include "rcc.h"
+
+/* Private macros ---------------------------------------------------------- */
+
+/* Private constants ------------------------------------------------------- */
+
+/* Private types ----------------------------------------------------------- */
+
+/* Private variables ------------------------------------------------------- */
+
+/* До dwt_set_frequency() - максимальная частота: срок не короче заданного */
+static uint32_t cycles_per_us = RCC_PLL1P_CLOCK / 1000000;
+
+/* Private function prototypes --------------------------------------------- */
+
+/* Private user code ------------------------------------------------------- */
+
+/**
+ * @brief           Получить значение счетчика тактов CPU
+ *
+ * @return          Значение счетчика
+ *
+ * @note            Счетчик запускает Boot (dwt_init), App его не сбрасывает
+ */
+inline uint32_t dwt_get_cycles(void)
+{
+    return READ_REG(DWT->CYCCNT);
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Установить частоту CPU для перевода мкс в такты
+ *
+ * @param[in]       frequency: Частота CPU (Гц, кратно 1MHz)
+ *
+ * @note            Вызывается при смене частоты CPU. Срок, запущенный
+ *                  до смены, отсчитывается в тактах прежней частоты
+ */
+void dwt_set_frequency(const uint32_t frequency)
+{
+    cycles_per_us = frequency / 1000000;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Запустить отсчет срока ожидания
+ *
+ * @param[out]      deadline: Указатель на срок
+ * @param[in]       us: Длительность (мкс), не более 2^32 тактов CPU
+ *
+ * @note            Не зависит от SysTick и прерываний: используется до
+ *                  запуска SysTick и в критических секциях
+ */
+void dwt_deadline_start(struct dwt_deadline *deadline, const uint32_t us)
+{
+    uint32_t cycles_max = UINT32_MAX / cycles_per_us;
+
+    deadline->start = READ_REG(DWT->CYCCNT);
+    deadline->cycles = us < cycles_max ? us * cycles_per_us : UINT32_MAX;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Проверить истечение срока ожидания
+ *
+ * @param[in]       deadline: Указатель на срок
+ *
+ * @return          true - срок истек
+ */
+inline bool dwt_deadline_expired(const struct dwt_deadline *deadline)
+{
+    return READ_REG(DWT->CYCCNT) - deadline->start >= deadline->cycles;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Ожидать заданное время
+ *
+ * @param[in]       us: Длительность (мкс)
+ */
+void dwt_delay_us(const uint32_t us)
+{
+    struct dwt_deadline deadline;
+
+    dwt_deadline_start(&deadline, us);
+
+    while (!dwt_deadline_expired(&deadline))
+        continue;
+}
+/* ------------------------------------------------------------------------- */
@@ -0,0 +1,89 @@
+/**
+ * Copyright (C) 2025 zhmaksim <zhiharev.maxim.alexandrovich@yandex.ru>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/* Includes ---------------------------------------------------------------- */
+
+#include "flash.h"
+
+/* Private macros ---------------------------------------------------------- */
+
+/* Private constants ------------------------------------------------------- */
+
+/* Private types ----------------------------------------------------------- */
+
+/**
+ * @brief           Определение структуры данных задержки чтения FLASH
+ */
+struct flash_latency {
+    uint32_t frequency;                         /*!< Максимальная частота AXI (Гц) */
+
+    uint32_t latency;                           /*!< Количество тактов ожидания LATENCY */
+
+    uint32_t wrhighfreq;                        /*!< Задержка программирования WRHIGHFREQ */
+};
+
+/* Private variables ------------------------------------------------------- */
+
+/* Задержки с запасом, 300MHz - настройка Boot (flash_init) */
+static const struct flash_latency flash_latency[] = {
+    {  70000000, 1, 0 },
+    { 140000000, 3, 1 },
+    { 210000000, 5, 2 },
+    { 300000000, 7, 3 },
+};
+
+/* Private function prototypes --------------------------------------------- */
+
+/* Private user code ------------------------------------------------------- */
+
+/**
+ * @brief           Получить количество тактов ожидания FLASH
+ *
+ * @return          Значение LATENCY
+ */
+uint32_t flash_get_latency(void)
+{
+    return READ_BIT(FLASH->ACR, FLASH_ACR_LATENCY_Msk) >> FLASH_ACR_LATENCY_Pos;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Настроить задержку чтения FLASH для частоты AXI
+ *
+ * @param[in]       frequency: Частота AXI/AHB (Гц)
+ *
+ * @note            Перед повышением частоты задержка увеличивается,
+ *                  уменьшается - после понижения частоты
+ */
+void flash_set_latency(uint32_t frequency)
+{
+    const uint32_t count = sizeof(flash_latency) / sizeof(flash_latency[0]);
+    uint32_t i = 0;
+
+    while (i < count - 1 && frequency > flash_latency[i].frequency)
+        i++;
+
+    uint32_t acr = flash_latency[i].latency << FLASH_ACR_LATENCY_Pos
+                 | flash_latency[i].wrhighfreq << FLASH_ACR_WRHIGHFREQ_Pos;
+
+    WRITE_REG(FLASH->ACR, acr);
+
+    /* Новая задержка действует после чтения ACR */
+    while (READ_REG(FLASH->ACR) != acr)
+        continue;
+}
+/* ------------------------------------------------------------------------- */
@@ -0,0 +1,100 @@
+/**
+ * Copyright (C) 2025 zhmaksim <zhiharev.maxim.alexandrovich@yandex.ru>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/* Includes ---------------------------------------------------------------- */
+
+#include "handoff.h"
+
+/* Private macros ---------------------------------------------------------- */
+
+/* Private constants ------------------------------------------------------- */
+
+/* Private types ----------------------------------------------------------- */
+
+/* Private variables ------------------------------------------------------- */
+
+static struct handoff handoff;
+
+static bool valid;
+
+/* Private function prototypes --------------------------------------------- */
+
+static uint32_t handoff_checksum(const struct handoff *block);
+
+/* Private user code ------------------------------------------------------- */
+
+/**
+ * @brief           Прочитать блок передачи, сформированный Boot
+ *
+ * @note            Блок копируется: SRAM_BKP может быть перезаписана
+ *                  (например, телеметрией следующего запуска Boot). Признак
+ *                  блока сбрасывается после чтения: App, запущенная без Boot
+ *                  (отладчик, образ в ОЗУ), не получает блок предыдущего
+ *                  запуска
+ */
+void handoff_init(void)
+{
+    struct handoff *source = (struct handoff *) HANDOFF_ADDRESS;
+
+    /* Выключить защиту от записи Backup домена */
+    SET_BIT(PWR->CR1, PWR_CR1_DBP_Msk);
+
+    /* Включить тактирование BKPSRAM */
+    SET_BIT(RCC->AHB4ENR, RCC_AHB4ENR_BKPRAMEN_Msk);
+
+    valid = source->magic == HANDOFF_MAGIC
+         && source->version == HANDOFF_VERSION
+         && source->size == sizeof(struct handoff)
+         && source->checksum == handoff_checksum(source);
+
+    if (valid)
+        handoff = *source;
+
+    source->magic = 0;
+    __DSB();
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Получить блок передачи
+ *
+ * @return          Указатель на блок (NULL - блок не записан Boot)
+ */
+const struct handoff *handoff_get(void)
+{
+    return valid ? &handoff : NULL;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Вычислить контрольную сумму блока
+ *
+ * @param[in]       block: Указатель на блок
+ * @return          Контрольная сумма
+ */
+static uint32_t handoff_checksum(const struct handoff *block)
+{
+    const uint32_t *word = (const uint32_t *) block;
+    uint32_t checksum = 0;
+
+    /* Все слова после magic до checksum */
+    for (uint32_t i = 1; i < offsetof(struct handoff, checksum) / 4; i++)
+        checksum = (checksum << 5 | checksum >> 27) ^ word[i];
+
+    return checksum;
+}
+/* ------------------------------------------------------------------------- */
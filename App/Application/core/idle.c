@@ -0,0 +1,349 @@
+/**
+ * Copyright (C) 2025 zhmaksim <zhiharev.maxim.alexandrovich@yandex.ru>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/* Includes ---------------------------------------------------------------- */
+
+#include "idle.h"
+#include "systick.h"
+#include "rcc.h"
+#include "runtime.h"
+
+/* Private macros ---------------------------------------------------------- */
+
+/* Private constants ------------------------------------------------------- */
+
+#define IDLE_LSE_CLOCK           RCC_LSE_CLOCK
+#define IDLE_LSE_SHIFT           15             /* IDLE_LSE_CLOCK = 2^15 Гц */
+#define IDLE_LPTIM_PERIOD        0x10000        /* Период счетчика LPTIM1 (ARR + 1) */
+#define IDLE_LPTIM_MIN_COUNT     4              /* Минимальное время до пробуждения (такты LSE) */
+#define IDLE_LPTIM1SEL_LSE       0x03
+
+/* Максимальное время простоя: запас 1/8 периода LPTIM1 на выход из Stop */
+#define IDLE_MAX_TIME           ((IDLE_LPTIM_PERIOD - IDLE_LSE_CLOCK / 8) * 1000 / IDLE_LSE_CLOCK)
+
+/* EXTI47 - пробуждение по LPTIM1 */
+#define IDLE_EXTI_LPTIM1_Msk     (1UL << (47 - 32))
+
+/* Генераторы, выключаемые в Stop (бит готовности следует за битом включения) */
+#define IDLE_RCC_CR_ON_Msk       (RCC_CR_HSEON_Msk | RCC_CR_PLL1ON_Msk      \
+                                | RCC_CR_PLL2ON_Msk | RCC_CR_PLL3ON_Msk)
+
+/* Private types ----------------------------------------------------------- */
+
+/* Private variables ------------------------------------------------------- */
+
+static struct idle_stats stats;
+
+static bool ready;
+
+/* Неучтенная часть тика: 1 тик = IDLE_LSE_CLOCK */
+static uint32_t residue;
+
+/* Private function prototypes --------------------------------------------- */
+
+static void idle_setup_lptim(void);
+
+static uint32_t idle_get_lptim_count(void);
+
+static uint32_t idle_stop(void);
+
+/* Private user code ------------------------------------------------------- */
+
+/**
+ * @brief           Инициализировать подавление тика в простое
+ *
+ * @note            LSE запускает rcc_init(), до готовности LSE
+ *                  тик не подавляется
+ */
+void idle_init(void)
+{
+    /* Включить тактирование LPTIM1, источник тактирования = LSE */
+    SET_BIT(RCC->APB1ENR1, RCC_APB1ENR1_LPTIM1EN_Msk);
+
+    MODIFY_REG(RCC->CCIPR2,
+               RCC_CCIPR2_LPTIM1SEL_Msk,
+               IDLE_LPTIM1SEL_LSE << RCC_CCIPR2_LPTIM1SEL_Pos);
+
+    /* Разрешить пробуждение из Stop по LPTIM1 */
+    SET_BIT(EXTI->IMR2, IDLE_EXTI_LPTIM1_Msk);
+
+    NVIC_EnableIRQ(LPTIM1_IRQn);
+
+    stats.stop_enabled = true;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Выполнить простой без тика (portSUPPRESS_TICKS_AND_SLEEP)
+ *
+ * @param[in]       expected_time: Ожидаемое время простоя (тиков)
+ *
+ * @note            SysTick останавливается, пробуждение выполняет сравнение
+ *                  LPTIM1 (LSE, непрерывный счет). Простой не короче
+ *                  IDLE_STOP_MIN_TIME выполняется в Stop, пробуждение
+ *                  назначается раньше на задержку выхода из Stop.
+ *                  Если задержка превысила IDLE_WAKE_LATENCY_MAX_US,
+ *                  используется только Sleep. Прошедшее время
+ *                  измеряет LPTIM1, остаток тика переносится
+ */
+void idle_sleep(uint32_t expected_time)
+{
+    if (!ready) {
+        if (!rcc_is_lse_ready())
+            return;
+
+        idle_setup_lptim();
+        ready = true;
+    }
+
+    if (expected_time > IDLE_MAX_TIME)
+        expected_time = IDLE_MAX_TIME;
+
+    __disable_irq();
+    __DSB();
+    __ISB();
+
+    if (eTaskConfirmSleepModeStatus() == eAbortSleep) {
+        __enable_irq();
+        return;
+    }
+
+    /* Остановить SysTick, учесть прошедшую часть тика */
+    uint32_t ctrl = READ_REG(SysTick->CTRL);
+    uint32_t start = idle_get_lptim_count();
+    uint32_t cycles = READ_REG(DWT->CYCCNT);
+
+    WRITE_REG(SysTick->CTRL, ctrl & ~SysTick_CTRL_ENABLE_Msk);
+
+    uint32_t load = READ_REG(SysTick->LOAD) + 1;
+
+    residue += (load - READ_REG(SysTick->VAL)) * (IDLE_LSE_CLOCK >> 7) / (load >> 7);
+
+    /* Период завершился до остановки: тик учитывается здесь (прерывание ожидает обработки) */
+    if (READ_BIT(SCB->ICSR, SCB_ICSR_PENDSTSET_Msk)) {
+        residue += IDLE_LSE_CLOCK;
+        SET_BIT(SCB->ICSR, SCB_ICSR_PENDSTCLR_Msk);
+    }
+
+    /* Время до пробуждения (такты LSE) */
+    uint32_t wake = expected_time * IDLE_LSE_CLOCK > residue ?
+            (expected_time * IDLE_LSE_CLOCK - residue) / 1000 : 0;
+    uint32_t latency = stats.wake_latency_max * (IDLE_LSE_CLOCK / 64) / (1000000 / 64) + 1;
+    bool stop = stats.stop_enabled && expected_time >= IDLE_STOP_MIN_TIME
+             && wake >= latency + IDLE_LPTIM_MIN_COUNT;
+
+    if (stop)
+        wake -= latency;
+
+    if (wake >= IDLE_LPTIM_MIN_COUNT) {
+        /* Назначить пробуждение */
+        WRITE_REG(LPTIM1->ICR, LPTIM_ICR_CMP1OKCF_Msk | LPTIM_ICR_CC1CF_Msk);
+        NVIC_ClearPendingIRQ(LPTIM1_IRQn);
+
+        WRITE_REG(LPTIM1->CCR1, (start + wake) & (IDLE_LPTIM_PERIOD - 1));
+
+        while (!READ_BIT(LPTIM1->ISR, LPTIM_ISR_CMP1OK_Msk))
+            continue;
+
+        if (stop) {
+            /* Восстановление выполняется на HSI / CPRE текущего профиля */
+            stats.wake_latency = idle_stop() * rcc_get_cpu_divider() / (RCC_HSI_CLOCK / 1000000);
+
+            if (stats.wake_latency > stats.wake_latency_max)
+                stats.wake_latency_max = stats.wake_latency;
+
+            if (stats.wake_latency_max > IDLE_WAKE_LATENCY_MAX_US)
+                stats.stop_enabled = false;
+        } else {
+            __DSB();
+            __WFI();
+            __ISB();
+        }
+    }
+
+    /* Учесть прошедшее время */
+    uint32_t elapsed = (idle_get_lptim_count() - start) & (IDLE_LPTIM_PERIOD - 1);
+    uint32_t total = elapsed * 1000 + residue;
+    uint32_t ticks = total / IDLE_LSE_CLOCK;
+
+    residue = total % IDLE_LSE_CLOCK;
+
+    /* Учесть время выполнения простоя: в Stop DWT CYCCNT не считает */
+    uint32_t counted = READ_REG(DWT->CYCCNT) - cycles;
+    uint32_t expected = (uint64_t) elapsed * rcc_get_cpu_hz() >> IDLE_LSE_SHIFT;
+
+    if (expected > counted)
+        runtime_add_cycles(expected - counted);
+
+    /* Пробуждение не позже expected_time, излишек переносится */
+    if (ticks > expected_time) {
+        residue += (ticks - expected_time) * IDLE_LSE_CLOCK;
+        ticks = expected_time;
+    }
+
+    if (stop) {
+        stats.stop_count++;
+        stats.stop_time += ticks;
+    } else {
+        stats.sleep_count++;
+        stats.sleep_time += ticks;
+    }
+
+    /* Перезапустить SysTick */
+    CLEAR_REG(SysTick->VAL);
+    SET_BIT(SysTick->CTRL, SysTick_CTRL_ENABLE_Msk);
+
+    if (ticks > 0) {
+        vTaskStepTick(ticks);
+        systick_step_tick(ticks);
+    }
+
+    TickType_t now = xTaskGetTickCount();
+
+    if (now >= 1000)
+        stats.residency = (stats.sleep_time + stats.stop_time) / (now / 1000);
+
+    __enable_irq();
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Обработать прерывания LPTIM1
+ *
+ * @note            Сравнение служит только для пробуждения
+ */
+void idle_it_handler(void)
+{
+    WRITE_REG(LPTIM1->ICR, LPTIM_ICR_CC1CF_Msk);
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Получить статистику простоя
+ *
+ * @return          Указатель на статистику
+ */
+const struct idle_stats *idle_get_stats(void)
+{
+    return &stats;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Настроить LPTIM1 (непрерывный счет LSE)
+ *
+ * @note            Регистры DIER и ARR записываются при включенном LPTIM1
+ *                  и синхронизируются с LSE
+ */
+static void idle_setup_lptim(void)
+{
+    /* Внутреннее тактирование, делитель = 1 */
+    CLEAR_REG(LPTIM1->CFGR);
+
+    SET_BIT(LPTIM1->CR, LPTIM_CR_ENABLE_Msk);
+
+    /* Включить прерывание сравнения */
+    WRITE_REG(LPTIM1->DIER, LPTIM_DIER_CC1IE_Msk);
+
+    while (!READ_BIT(LPTIM1->ISR, LPTIM_ISR_DIEROK_Msk))
+        continue;
+
+    WRITE_REG(LPTIM1->ARR, IDLE_LPTIM_PERIOD - 1);
+
+    while (!READ_BIT(LPTIM1->ISR, LPTIM_ISR_ARROK_Msk))
+        continue;
+
+    WRITE_REG(LPTIM1->ICR, LPTIM_ICR_DIEROKCF_Msk | LPTIM_ICR_ARROKCF_Msk);
+
+    /* Запустить непрерывный счет */
+    SET_BIT(LPTIM1->CR, LPTIM_CR_CNTSTRT_Msk);
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Получить значение счетчика LPTIM1
+ *
+ * @return          Значение счетчика
+ *
+ * @note            Счетчик тактируется асинхронно, значение достоверно
+ *                  при совпадении двух чтений подряд
+ */
+static uint32_t idle_get_lptim_count(void)
+{
+    uint32_t count;
+
+    do {
+        count = READ_REG(LPTIM1->CNT);
+    } while (count != READ_REG(LPTIM1->CNT));
+
+    return count;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Перейти в Stop и восстановить тактирование
+ *
+ * @return          Длительность восстановления тактирования (такты CPU
+ *                  на HSI / CPRE)
+ *
+ * @note            Выполняется из ITCM: после пробуждения CPU работает
+ *                  на HSI / CPRE, PLL2 (XSPI2) выключен до восстановления
+ */
+__ITCM static uint32_t idle_stop(void)
+{
+    uint32_t on = READ_BIT(RCC->CR, IDLE_RCC_CR_ON_Msk);
+    uint32_t sw = READ_BIT(RCC->CFGR, RCC_CFGR_SW_Msk) >> RCC_CFGR_SW_Pos;
+
+    /* Stop (PDDS = 0) */
+    CLEAR_BIT(PWR->CSR3, PWR_CSR3_PDDS_Msk);
+    SET_BIT(SCB->SCR, SCB_SCR_SLEEPDEEP_Msk);
+
+    __DSB();
+    __WFI();
+    __ISB();
+
+    CLEAR_BIT(SCB->SCR, SCB_SCR_SLEEPDEEP_Msk);
+
+    uint32_t start = READ_REG(DWT->CYCCNT);
+
+    /* Включить HSE, затем PLL */
+    SET_BIT(RCC->CR, on & RCC_CR_HSEON_Msk);
+
+    while (READ_BIT(RCC->CR, RCC_CR_HSERDY_Msk) != (on & RCC_CR_HSEON_Msk) << 1)
+        continue;
+
+    SET_BIT(RCC->CR, on);
+
+    while (READ_BIT(RCC->CR, (on & ~RCC_CR_HSEON_Msk) << 1) != (on & ~RCC_CR_HSEON_Msk) << 1)
+        continue;
+
+    /* Ожидание готовности VOS */
+    while (!READ_BIT(PWR->SR1, PWR_SR1_ACTVOSRDY_Msk))
+        continue;
+
+    /* Вернуть источник тактирования CPU */
+    MODIFY_REG(RCC->CFGR,
+               RCC_CFGR_SW_Msk,
+               sw << RCC_CFGR_SW_Pos);
+
+    while (READ_BIT(RCC->CFGR, RCC_CFGR_SWS_Msk) !=
+            sw << RCC_CFGR_SWS_Pos)
+        continue;
+
+    return READ_REG(DWT->CYCCNT) - start;
+}
+/* ------------------------------------------------------------------------- */
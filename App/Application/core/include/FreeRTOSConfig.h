@@ -22,13 +22,17 @@
 #if defined(__ICCARM__) || defined(__CC_ARM) || defined(__GNUC__)
     #include <stdint.h>
 
-    void xPortSysTickHandler( void );
+    uint32_t rcc_get_cpu_hz( void );
+    void idle_sleep( uint32_t expected_time );
+    void runtime_init( void );
+    uint64_t runtime_get_counter( void );
 #endif
 
 #define configUSE_PREEMPTION                                1
 #define configUSE_PORT_OPTIMISED_TASK_SELECTION             0
-#define configUSE_TICKLESS_IDLE                             0
-#define configCPU_CLOCK_HZ                                  600000000
+#define configUSE_TICKLESS_IDLE                             2
+#define configEXPECTED_IDLE_TIME_BEFORE_SLEEP               2
+#define configCPU_CLOCK_HZ                                  ( rcc_get_cpu_hz() )
 #define configTICK_RATE_HZ                                  1000
 #define configMAX_PRIORITIES                                7
 #define configMINIMAL_STACK_SIZE                            128
@@ -44,7 +48,7 @@
 #define configSUPPORT_STATIC_ALLOCATION                     0
 #define configSUPPORT_DYNAMIC_ALLOCATION                    1
 #define configTOTAL_HEAP_SIZE                               65536
-#define configAPPLICATION_ALLOCATED_HEAP                    0
+#define configAPPLICATION_ALLOCATED_HEAP                    1
 #define configSTACK_ALLOCATION_FROM_SEPARATE_HEAP           0
 
 /* Hook function related definitions. */
@@ -55,10 +59,16 @@
 #define configUSE_DAEMON_TASK_STARTUP_HOOK                  0
 #define configUSE_SB_COMPLETED_CALLBACK                     0
 
-/* Run time and task stats gathering related definitions. */
-#define configGENERATE_RUN_TIME_STATS                       0
-#define configUSE_TRACE_FACILITY                            0
+/* Run time and task stats gathering related definitions.
+ * Run time counter: DWT CYCCNT extended to 64 bits (runtime.c). Formatting
+ * functions and ulTaskGetRunTimePercent() are not used: libc and 64-bit
+ * division (libgcc) are discarded by the linker script. */
+#define configGENERATE_RUN_TIME_STATS                       1
+#define configUSE_TRACE_FACILITY                            1
 #define configUSE_STATS_FORMATTING_FUNCTIONS                0
+#define configRUN_TIME_COUNTER_TYPE                         uint64_t
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()            runtime_init()
+#define portGET_RUN_TIME_COUNTER_VALUE()                    runtime_get_counter()
 
 /* Co-routine related definitions. */
 #define configUSE_CO_ROUTINES                               0
@@ -104,11 +114,15 @@
 #define INCLUDE_vTaskDelay                      1
 #define INCLUDE_xTaskGetSchedulerState          1
 #define INCLUDE_xTaskGetCurrentTaskHandle       1
+#define INCLUDE_xTaskGetIdleTaskHandle          1
 #define INCLUDE_xTaskResumeFromISR              1
 #define INCLUDE_xResumeFromISR                  1
 #define INCLUDE_xEventGroupSetBitFromISR        1
 #define INCLUDE_xTimerPendFunctionCall          1
 
+/* Tickless idle: SysTick stopped, wake-up by LPTIM1 (Sleep or Stop). */
+#define portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime )   idle_sleep( xExpectedIdleTime )
+
 /* Definitions that map the FreeRTOS port interrupt handlers to their CMSIS standard names. */
 #define vPortSVCHandler     SVC_Handler
 #define xPortPendSVHandler      PendSV_Handler
@@ -0,0 +1,120 @@
+/**
+ * Copyright (C) 2025 zhmaksim <zhiharev.maxim.alexandrovich@yandex.ru>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef CRASH_H_
+#define CRASH_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/* Includes ---------------------------------------------------------------- */
+
+#include "main.h"
+
+/* Exported macros --------------------------------------------------------- */
+
+/**
+ * @brief           Передать кадр исключения в crash_fault()
+ *
+ * @note            Тело обработчика исключения с атрибутом naked: стек
+ *                  (MSP или PSP) и EXC_RETURN не изменяются компилятором
+ */
+#define CRASH_FAULT_ENTRY()                             \
+    __ASM volatile ("tst    lr, #4          \n"         \
+                    "ite    eq              \n"         \
+                    "mrseq  r0, msp         \n"         \
+                    "mrsne  r0, psp         \n"         \
+                    "mov    r1, lr          \n"         \
+                    "b      crash_fault     \n")
+
+/* Exported constants ------------------------------------------------------ */
+
+#define CRASH_ADDRESS                   (BKPSRAM_BASE + 0x200)
+
+#define CRASH_MAGIC                     0x48535243      /* "CRSH" */
+#define CRASH_VERSION                   1
+
+#define CRASH_STACK_SIZE                16              /* Окно стека (слов) */
+
+/* Exported types ---------------------------------------------------------- */
+
+/**
+ * @brief           Определение структуры данных записи о сбое
+ *
+ * @note            Запись размещается в SRAM_BKP и сохраняется при сбросе
+ */
+struct crash_record {
+    uint32_t magic;                             /*!< Признак записи CRASH_MAGIC */
+
+    uint16_t version;                           /*!< Версия формата записи */
+
+    uint16_t size;                              /*!< Размер записи (байт) */
+
+    uint32_t count;                             /*!< Число сбоев с момента включения питания */
+
+    uint32_t reported;                          /*!< Запись прочитана App после сброса */
+
+    uint32_t exception;                         /*!< Номер исключения (IPSR) */
+
+    uint32_t exc_return;                        /*!< Значение EXC_RETURN */
+
+    uint32_t r0;                                /*!< Регистры кадра исключения */
+    uint32_t r1;
+    uint32_t r2;
+    uint32_t r3;
+    uint32_t r12;
+    uint32_t lr;
+    uint32_t pc;
+    uint32_t xpsr;
+
+    uint32_t sp;                                /*!< Указатель стека до исключения (0 - кадр недоступен) */
+
+    uint32_t cfsr;                              /*!< SCB_CFSR */
+
+    uint32_t hfsr;                              /*!< SCB_HFSR */
+
+    uint32_t mmfar;                             /*!< SCB_MMFAR */
+
+    uint32_t bfar;                              /*!< SCB_BFAR */
+
+    uint32_t tick;                              /*!< Системное время FreeRTOS (тик) */
+
+    char task[configMAX_TASK_NAME_LEN];         /*!< Имя текущей задачи FreeRTOS ("" - до запуска планировщика) */
+
+    uint32_t stack[CRASH_STACK_SIZE];           /*!< Стек после кадра исключения */
+
+    uint32_t checksum;                          /*!< Контрольная сумма записи */
+};
+
+/* Exported variables ------------------------------------------------------ */
+
+/* Exported function prototypes -------------------------------------------- */
+
+void crash_init(void);
+
+const struct crash_record *crash_get(void);
+
+__NO_RETURN void crash_fault(const uint32_t *frame, uint32_t exc_return);
+
+/* Exported callback function prototypes ----------------------------------- */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* CRASH_H_ */
@@ -0,0 +1,64 @@
+/**
+ * Copyright (C) 2025 zhmaksim <zhiharev.maxim.alexandrovich@yandex.ru>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef DWT_H_
+#define DWT_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/* Includes ---------------------------------------------------------------- */
+
+#include "main.h"
+
+/* Exported macros --------------------------------------------------------- */
+
+/* Exported constants ------------------------------------------------------ */
+
+/* Exported types ---------------------------------------------------------- */
+
+/**
+ * @brief           Определение структуры данных срока ожидания
+ */
+struct dwt_deadline {
+    uint32_t start;                             /*!< DWT CYCCNT при запуске */
+
+    uint32_t cycles;                            /*!< Длительность (такты CPU) */
+};
+
+/* Exported variables ------------------------------------------------------ */
+
+/* Exported function prototypes -------------------------------------------- */
+
+uint32_t dwt_get_cycles(void);
+
+void dwt_set_frequency(const uint32_t frequency);
+
+void dwt_deadline_start(struct dwt_deadline *deadline, const uint32_t us);
+
+bool dwt_deadline_expired(const struct dwt_deadline *deadline);
+
+void dwt_delay_us(const uint32_t us);
+
+/* Exported callback function prototypes ----------------------------------- */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* DWT_H_ */
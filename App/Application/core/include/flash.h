@@ -0,0 +1,49 @@
+/**
+ * Copyright (C) 2025 zhmaksim <zhiharev.maxim.alexandrovich@yandex.ru>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef FLASH_H_
+#define FLASH_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/* Includes ---------------------------------------------------------------- */
+
+#include "main.h"
+
+/* Exported macros --------------------------------------------------------- */
+
+/* Exported constants ------------------------------------------------------ */
+
+/* Exported types ---------------------------------------------------------- */
+
+/* Exported variables ------------------------------------------------------ */
+
+/* Exported function prototypes -------------------------------------------- */
+
+uint32_t flash_get_latency(void);
+
+void flash_set_latency(uint32_t frequency);
+
+/* Exported callback function prototypes ----------------------------------- */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* FLASH_H_ */
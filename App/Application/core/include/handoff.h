@@ -0,0 +1,106 @@
+/**
+ * Copyright (C) 2025 zhmaksim <zhiharev.maxim.alexandrovich@yandex.ru>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef HANDOFF_H_
+#define HANDOFF_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/* Includes ---------------------------------------------------------------- */
+
+#include "main.h"
+#include "image.h"
+
+/* Exported macros --------------------------------------------------------- */
+
+/* Exported constants ------------------------------------------------------ */
+
+#define HANDOFF_ADDRESS                 (BKPSRAM_BASE + 0x180)
+
+#define HANDOFF_MAGIC                   0x46464F48      /* "HOFF" */
+#define HANDOFF_VERSION                 2
+
+/* Exported types ---------------------------------------------------------- */
+
+/**
+ * @brief           Определение перечисления режимов внешней FLASH при передаче App
+ */
+enum handoff_flash_mode {
+    HANDOFF_FLASH_NONE,                         /*!< XSPI не настроен */
+    HANDOFF_FLASH_MEMORY_MAPPED,                /*!< MX25UW в режиме OPI DTR, XSPI2 в Memory Mapped Mode */
+};
+
+
+/**
+ * @brief           Определение структуры данных блока передачи Boot -> App
+ *
+ * @note            Блок размещается в SRAM_BKP, формат должен совпадать с
+ *                  Boot/Application/core/include/handoff.h
+ */
+struct handoff {
+    uint32_t magic;                             /*!< Признак блока HANDOFF_MAGIC */
+
+    uint16_t version;                           /*!< Версия формата блока */
+
+    uint16_t size;                              /*!< Размер блока (байт) */
+
+    uint32_t cpu_clock;                         /*!< Частота CPU (Гц) */
+
+    uint32_t bus_matrix_clock;                  /*!< Частота AXI/AHB (Гц) */
+
+    uint32_t apb1_clock;                        /*!< Частота APB1 (Гц) */
+
+    uint32_t apb2_clock;                        /*!< Частота APB2 (Гц) */
+
+    uint32_t apb4_clock;                        /*!< Частота APB4 (Гц) */
+
+    uint32_t apb5_clock;                        /*!< Частота APB5 (Гц) */
+
+    uint32_t xspi_clock;                        /*!< Частота XSPI2 (Гц) */
+
+    uint32_t flash_mode;                        /*!< Режим внешней FLASH @ref enum handoff_flash_mode */
+
+    uint32_t flash_fast_boot;                   /*!< Заголовок прочитан через Fast Boot MX25UW (без чтения ID) */
+
+    uint32_t reset_cause;                       /*!< Значение RCC_RSR при запуске Boot */
+
+    uint32_t vector_address;                    /*!< Адрес таблицы векторов App (VTOR настроен Boot) */
+
+    uint32_t jump_cycles;                       /*!< Значение DWT CYCCNT при переходе в App */
+
+    uint8_t header_digest[IMAGE_DIGEST_SIZE];   /*!< SHA-256 подписанных полей magic...digest заголовка образа */
+
+    uint32_t checksum;                          /*!< Контрольная сумма блока */
+};
+
+/* Exported variables ------------------------------------------------------ */
+
+/* Exported function prototypes -------------------------------------------- */
+
+void handoff_init(void);
+
+const struct handoff *handoff_get(void);
+
+/* Exported callback function prototypes ----------------------------------- */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* HANDOFF_H_ */
@@ -0,0 +1,77 @@
+/**
+ * Copyright (C) 2025 zhmaksim <zhiharev.maxim.alexandrovich@yandex.ru>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef IDLE_H_
+#define IDLE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/* Includes ---------------------------------------------------------------- */
+
+#include "main.h"
+
+/* Exported macros --------------------------------------------------------- */
+
+/* Exported constants ------------------------------------------------------ */
+
+#define IDLE_WAKE_LATENCY_MAX_US        500     /* Допустимая задержка выхода из Stop (мкс) */
+#define IDLE_STOP_MIN_TIME              20      /* Минимальное время простоя для Stop (тиков) */
+
+/* Exported types ---------------------------------------------------------- */
+
+/**
+ * @brief           Определение структуры данных статистики простоя
+ */
+struct idle_stats {
+    uint32_t sleep_count;                       /*!< Количество переходов в Sleep */
+
+    uint32_t sleep_time;                        /*!< Время в Sleep (тиков) */
+
+    uint32_t stop_count;                        /*!< Количество переходов в Stop */
+
+    uint32_t stop_time;                         /*!< Время в Stop (тиков) */
+
+    uint32_t residency;                         /*!< Доля времени без тика от времени работы (0.1 %) */
+
+    uint32_t wake_latency;                      /*!< Задержка последнего выхода из Stop (мкс) */
+
+    uint32_t wake_latency_max;                  /*!< Максимальная задержка выхода из Stop (мкс) */
+
+    bool stop_enabled;                          /*!< Stop разрешен (задержка не более IDLE_WAKE_LATENCY_MAX_US) */
+};
+
+/* Exported variables ------------------------------------------------------ */
+
+/* Exported function prototypes -------------------------------------------- */
+
+void idle_init(void);
+
+void idle_sleep(uint32_t expected_time);
+
+void idle_it_handler(void);
+
+const struct idle_stats *idle_get_stats(void);
+
+/* Exported callback function prototypes ----------------------------------- */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* IDLE_H_ */
@@ -38,12 +38,24 @@ extern "C" {
 
 /* Exported macros --------------------------------------------------------- */
 
+/* Разместить функцию в ITCM (копируется из FLASH при запуске) */
+#define __ITCM                  __attribute__((section(".itcm_text"), noinline))
+
+/* Разместить буфер без инициализации при запуске (инициализирует модуль-владелец) */
+#define __NOINIT                __attribute__((section(".noinit")))
+
+/* Разместить большой буфер, обнуляемый при запуске через GPDMA1 */
+#define __BSS_DMA               __attribute__((section(".bss_dma")))
+
 /* Exported constants ------------------------------------------------------ */
 
 /* Exported types ---------------------------------------------------------- */
 
 /* Exported variables ------------------------------------------------------ */
 
+/* Длительность startup (такты CPU от Reset_Handler до main) */
+extern uint32_t startup_cycles;
+
 /* Exported function prototypes -------------------------------------------- */
 
 void error(void);
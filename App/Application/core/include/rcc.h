@@ -0,0 +1,119 @@
+/**
+ * Copyright (C) 2025 zhmaksim <zhiharev.maxim.alexandrovich@yandex.ru>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef RCC_H_
+#define RCC_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/* Includes ---------------------------------------------------------------- */
+
+#include "main.h"
+
+/* Конфигурация тактирования Boot: частоты PLL и делители настройки Boot */
+#include "../../../../Boot/Application/core/include/rcc_config.h"
+
+/* Exported macros --------------------------------------------------------- */
+
+/* Exported constants ------------------------------------------------------ */
+
+/* PLL настраивает Boot (rcc_config.h), профили переключают только
+ * источник и делители - без перезапуска PLL */
+#define RCC_LSE_CLOCK            32768          /* Запускается App (rcc_init) */
+
+#define RCC_APB_DIVIDER          2              /* APB1/2/4/5 = AXI/AHB / 2 */
+
+#define RCC_OK                   0
+#define RCC_ERROR               -1
+
+/* Exported types ---------------------------------------------------------- */
+
+/**
+ * @brief           Определение перечисления профилей тактирования
+ */
+enum rcc_profile {
+    RCC_PROFILE_600MHZ,                         /*!< PLL1, AXI/AHB PLL1 / 2, VOS High (настройка Boot) */
+    RCC_PROFILE_300MHZ,                         /*!< PLL1 / 2, AXI/AHB PLL1 / 4, VOS Low */
+    RCC_PROFILE_150MHZ,                         /*!< PLL1 / 4, AXI/AHB PLL1 / 8, VOS Low */
+    RCC_PROFILE_64MHZ,                          /*!< HSI, AXI/AHB HSI / 2, VOS Low */
+    /* --- */
+    RCC_PROFILE_COUNT,                          /*!< Тактирование не соответствует профилю */
+};
+
+
+/**
+ * @brief           Определение структуры данных частот тактирования
+ */
+struct rcc_clocks {
+    uint32_t cpu;                               /*!< Частота CPU (Гц) */
+
+    uint32_t bus_matrix;                        /*!< Частота AXI/AHB (Гц) */
+
+    uint32_t apb1;                              /*!< Частота APB1 (Гц) */
+
+    uint32_t apb2;                              /*!< Частота APB2 (Гц) */
+
+    uint32_t apb4;                              /*!< Частота APB4 (Гц) */
+
+    uint32_t apb5;                              /*!< Частота APB5 (Гц) */
+
+    uint32_t xspi;                              /*!< Частота ядра XSPI2 (Гц) */
+};
+
+/* Exported variables ------------------------------------------------------ */
+
+/* Exported function prototypes -------------------------------------------- */
+
+void rcc_init(void);
+
+int32_t rcc_set_profile(uint32_t profile);
+
+uint32_t rcc_get_profile(void);
+
+const struct rcc_clocks *rcc_get_clocks(void);
+
+uint32_t rcc_get_cpu_hz(void);
+
+uint32_t rcc_get_cpu_divider(void);
+
+uint32_t rcc_get_bus_matrix_hz(void);
+
+uint32_t rcc_get_apb1_hz(void);
+
+uint32_t rcc_get_apb2_hz(void);
+
+uint32_t rcc_get_apb4_hz(void);
+
+uint32_t rcc_get_apb5_hz(void);
+
+uint32_t rcc_get_xspi_hz(void);
+
+uint32_t rcc_get_switch_time(void);
+
+bool rcc_is_lse_ready(void);
+
+/* Exported callback function prototypes ----------------------------------- */
+
+__WEAK void rcc_profile_changed_callback(uint32_t profile);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* RCC_H_ */
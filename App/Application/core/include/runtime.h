@@ -0,0 +1,103 @@
+/**
+ * Copyright (C) 2025 zhmaksim <zhiharev.maxim.alexandrovich@yandex.ru>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef RUNTIME_H_
+#define RUNTIME_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/* Includes ---------------------------------------------------------------- */
+
+#include "main.h"
+
+/* Exported macros --------------------------------------------------------- */
+
+/* Exported constants ------------------------------------------------------ */
+
+#define RUNTIME_TASK_MAX                16              /* Задач в снимке не более */
+
+#define RUNTIME_LOAD_SCALE              10000           /* Загрузка 100 % (единица - 0.01 %) */
+
+#define RUNTIME_OK                       0
+#define RUNTIME_ERROR                   -1
+
+/* Exported types ---------------------------------------------------------- */
+
+/**
+ * @brief           Определение структуры данных времени выполнения задачи
+ */
+struct runtime_task {
+    uint32_t number;                            /*!< Номер задачи FreeRTOS (уникален) */
+
+    char name[configMAX_TASK_NAME_LEN];         /*!< Имя задачи */
+
+    uint8_t priority;                           /*!< Текущий приоритет */
+
+    uint8_t state;                              /*!< Состояние eTaskState */
+
+    uint16_t stack_free;                        /*!< Минимальный остаток стека (слов) */
+
+    uint32_t load;                              /*!< Загрузка CPU за окно снимка (0.01 %) */
+
+    uint64_t cycles;                            /*!< Время выполнения от запуска планировщика (такты CPU) */
+};
+
+
+/**
+ * @brief           Определение структуры данных снимка времени выполнения
+ *
+ * @note            Время - такты CPU: DWT CYCCNT, дополненный старшим словом
+ *                  и временем простоя в Stop. Время прерываний учитывается
+ *                  прерванной задаче
+ */
+struct runtime_snapshot {
+    uint32_t sequence;                          /*!< Номер снимка */
+
+    uint32_t task_count;                        /*!< Задач в снимке */
+
+    uint32_t load;                              /*!< Загрузка CPU за окно (0.01 %): доля времени вне задачи простоя */
+
+    uint32_t load_max;                          /*!< Максимальная загрузка CPU за окно (0.01 %) */
+
+    uint64_t timestamp;                         /*!< Время снимка от запуска планировщика (такты CPU) */
+
+    uint64_t window;                            /*!< Окно: время от предыдущего снимка (такты CPU) */
+
+    struct runtime_task task[RUNTIME_TASK_MAX]; /*!< Задачи в порядке обхода FreeRTOS */
+};
+
+/* Exported variables ------------------------------------------------------ */
+
+/* Exported function prototypes -------------------------------------------- */
+
+void runtime_init(void);
+
+uint64_t runtime_get_counter(void);
+
+void runtime_add_cycles(const uint32_t cycles);
+
+int32_t runtime_snapshot(struct runtime_snapshot *snapshot);
+
+/* Exported callback function prototypes ----------------------------------- */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* RUNTIME_H_ */
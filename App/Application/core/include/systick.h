@@ -30,21 +30,64 @@ extern "C" {
 
 /* Exported constants ------------------------------------------------------ */
 
+#define SYSTICK_HISTORY_SIZE            32      /* Длительность последних тиков в режиме измерения */
+
+/* Режим измерения при запуске (-DSYSTICK_MEASURE_ENABLE=1), иначе
+   включается отладчиком (tick_measure в App main.c) */
+#ifndef SYSTICK_MEASURE_ENABLE
+#define SYSTICK_MEASURE_ENABLE          0
+#endif /* SYSTICK_MEASURE_ENABLE */
+
 /* Exported types ---------------------------------------------------------- */
 
+/**
+ * @brief           Определение структуры данных измерения прерывания тика
+ */
+struct systick_stats {
+    bool enabled;                               /*!< Режим измерения включен */
+
+    uint32_t count;                             /*!< Измеренные тики */
+
+    uint32_t latency;                           /*!< Задержка входа последнего тика (такты от перезагрузки SysTick) */
+
+    uint32_t latency_max;                       /*!< Максимальная задержка входа (такты) */
+
+    uint32_t cycles;                            /*!< Длительность обработки последнего тика (такты) */
+
+    uint32_t cycles_min;                        /*!< Минимальная длительность обработки (такты) */
+
+    uint32_t cycles_max;                        /*!< Максимальная длительность обработки (такты) */
+
+    uint64_t cycles_total;                      /*!< Суммарная длительность обработки (такты) */
+
+    uint32_t history[SYSTICK_HISTORY_SIZE];     /*!< Длительность последних тиков (такты), кольцевой буфер */
+};
+
 /* Exported variables ------------------------------------------------------ */
 
 /* Exported function prototypes -------------------------------------------- */
 
 void systick_init(const uint32_t frequency);
 
+void systick_set_frequency(const uint32_t frequency);
+
 void systick_it_handler(void);
 
+void systick_step_tick(const uint32_t ticks);
+
 uint32_t systick_get_tick(void);
 
-/* Exported callback function prototypes ----------------------------------- */
+uint64_t systick_get_tick64(void);
 
-__WEAK void systick_period_elapsed_callback(void);
+uint64_t systick_get_cycles(void);
+
+uint64_t systick_get_ns(void);
+
+void systick_set_measure(const bool enable);
+
+const struct systick_stats *systick_get_stats(void);
+
+/* Exported callback function prototypes ----------------------------------- */
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,86 @@
+/**
+ * Copyright (C) 2025 zhmaksim <zhiharev.maxim.alexandrovich@yandex.ru>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef THERMAL_H_
+#define THERMAL_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/* Includes ---------------------------------------------------------------- */
+
+#include "main.h"
+
+/* Exported macros --------------------------------------------------------- */
+
+/* Exported constants ------------------------------------------------------ */
+
+#define THERMAL_HYSTERESIS              80      /* Гистерезис возврата на уровень выше (0.1 °C) */
+#define THERMAL_RESTORE_DELAY           4000    /* Минимальное время на уровне до повышения частоты (мс) */
+
+/* Exported types ---------------------------------------------------------- */
+
+/**
+ * @brief           Определение перечисления состояний ограничения
+ */
+enum thermal_state {
+    THERMAL_STATE_NORMAL,                       /*!< RCC_PROFILE_600MHZ */
+    THERMAL_STATE_THROTTLE,                     /*!< RCC_PROFILE_300MHZ, выше 95 °C */
+    THERMAL_STATE_THROTTLE_HIGH,                /*!< RCC_PROFILE_150MHZ, выше 105 °C */
+    THERMAL_STATE_CRITICAL,                     /*!< RCC_PROFILE_64MHZ, выше 115 °C */
+    /* --- */
+    THERMAL_STATE_COUNT,
+};
+
+
+/**
+ * @brief           Определение структуры данных состояния регулятора
+ */
+struct thermal_report {
+    bool valid;                                 /*!< Температура измерена */
+
+    int32_t temperature;                        /*!< Температура кристалла (0.1 °C) */
+
+    int32_t temperature_max;                    /*!< Максимальная температура (0.1 °C) */
+
+    uint32_t state;                             /*!< Состояние @ref enum thermal_state */
+
+    uint32_t transitions;                       /*!< Количество смен состояния */
+
+    uint32_t errors;                            /*!< Ошибки измерения или смены профиля */
+
+    uint32_t time[THERMAL_STATE_COUNT];         /*!< Время в состоянии (мс) */
+};
+
+/* Exported variables ------------------------------------------------------ */
+
+/* Exported function prototypes -------------------------------------------- */
+
+void thermal_init(void);
+
+void thermal_process(void);
+
+const struct thermal_report *thermal_get_report(void);
+
+/* Exported callback function prototypes ----------------------------------- */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* THERMAL_H_ */
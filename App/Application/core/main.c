@@ -19,24 +19,88 @@
 
 #include "main.h"
 #include "systick.h"
+#include "dwt.h"
+#include "telemetry.h"
+#include "handoff.h"
+#include "rcc.h"
+#include "standby.h"
+#include "crash.h"
+#include "idle.h"
+#include "runtime.h"
+#include "thermal.h"
+#include "timeout.h"
+#include "mpu.h"
+#include "cache.h"
+#include "dma.h"
+#include "crc.h"
 #include "led.h"
+#include "image.h"
+#include "bench.h"
 
 /* Private macros ---------------------------------------------------------- */
 
 /* Private constants ------------------------------------------------------- */
 
-#define VTOR_ADDRESS    0x70000000
+#define VTOR_ADDRESS    ((uint32_t) Vectors)
 
-#define HSI_CLOCK       64000000
+#define SCRUB_PERIOD            10000           /* Период проверки образа во внешней FLASH (мс) */
+#define SCRUB_BENCHMARK_SIZE    0x10000         /* Размер данных сравнения CRC и программного расчета */
 
-#define CPU_CLOCK       600000000
+#define THERMAL_PERIOD          500             /* Период измерения температуры кристалла (мс) */
 
 /* Private types ----------------------------------------------------------- */
 
 /* Private variables ------------------------------------------------------- */
 
+/* Куча FreeRTOS: heap_4 размечает ее сам при первом pvPortMalloc(),
+ * обнуление при запуске не требуется */
+uint8_t ucHeap[configTOTAL_HEAP_SIZE] __NOINIT;
+
+/* Таблица векторов (startup), адрес зависит от слота и режима загрузки образа */
+extern uint32_t Vectors[];
+
+/* Boot */
+static const struct telemetry_report *boot_report;
+static uint32_t app_startup_us;                 /* Длительность startup App (мкс) */
+static uint32_t reset_cause;                    /* RCC_RSR при запуске Boot */
+static uint32_t boot_image_load_rate;           /* Скорость распаковки образа (КБ/с), 0 - образ XIP */
+
+/* Пробуждение из Standby по RTC: задержка запуска Boot, App и начала работы */
+static const struct standby_report *standby_report;
+
+/* Сбой предыдущего запуска (NULL - запуск без сбоя) */
+static const struct crash_record *crash_report;
+
+/* Проверка образа во внешней FLASH */
+static uint32_t scrub_crc;                      /* CRC-32 образа при первой проверке */
+static uint32_t scrub_passes;
+static uint32_t scrub_errors;
+static uint32_t crc_hardware_cycles;            /* Такты CPU на SCRUB_BENCHMARK_SIZE: CRC + GPDMA1 */
+static uint32_t crc_software_cycles;            /* Такты CPU на SCRUB_BENCHMARK_SIZE: программный расчет */
+
+/* Производительность FPU и переключения задач */
+static struct bench_fpu_report bench_fpu_report;
+
+/* Профили тактирования: переключение и производительность */
+static struct bench_clock_report bench_clock_report;
+
+/* Нагрузки с I-Cache/D-Cache и без: такты CPU и ускорение */
+static struct bench_cache_report bench_cache_report;
+
+/* Температура кристалла и ограничение частоты */
+static const struct thermal_report *thermal_report;
+
+/* Служба таймаутов: активные таймауты, переносы, пакеты обратных вызовов */
+static const struct timeout_stats *timeout_report;
+
+/* Прерывание тика: задержка входа и длительность обработки (такты CPU).
+ * Измерение включается записью tick_measure = true отладчиком */
+static volatile bool tick_measure = SYSTICK_MEASURE_ENABLE;
+static const struct systick_stats *tick_report;
+
 /* FreeRTOS */
-static uint32_t appl_idle_hook_counter;
+static const struct idle_stats *idle_report;   /* Простой без тика: Sleep/Stop, задержка пробуждения */
+static struct runtime_snapshot runtime_report;  /* Загрузка CPU и время выполнения задач за 1 с */
 static size_t free_heap_size;
 static size_t minimum_ever_free_heap_size;
 
@@ -46,16 +110,24 @@ static void setup_hardware(void);
 
 static void setup_vector_table(void);
 
-static void setup_fpu(void);
-
 static void app_main(void *argv);
 
+static void app_scrub(void *argv);
+
+static void app_thermal(void *argv);
+
+static void crc_benchmark(const void *data, uint32_t size);
+
 /* Private user code ------------------------------------------------------- */
 
 int main(void)
 {
     setup_hardware();
 
+    /* Служба таймаутов доступна задачам с первого запуска */
+    timeout_init();
+    timeout_report = timeout_get_stats();
+
     xTaskCreate(app_main,
                 "app_main",
                 configMINIMAL_STACK_SIZE * 4,
@@ -63,6 +135,13 @@ int main(void)
                 tskIDLE_PRIORITY + 1,
                 NULL);
 
+    xTaskCreate(app_scrub,
+                "app_scrub",
+                configMINIMAL_STACK_SIZE * 2,
+                NULL,
+                tskIDLE_PRIORITY + 1,
+                NULL);
+
     vTaskStartScheduler();
 }
 /* ------------------------------------------------------------------------- */
@@ -89,21 +168,149 @@ static void app_main(void *argv)
 
     TickType_t last_wake_time = xTaskGetTickCount();
 
+    /* Задача приложения начинает работу (задержка от пробуждения из Standby) */
+    standby_mark_work();
+
+    /* Подтвердить Boot успешный запуск образа */
+    image_confirm();
+
+    /* Измерения задерживают запуск на секунды: только в отладочной сборке */
+    if (BENCH_ENABLE) {
+        bench_fpu(&bench_fpu_report);
+        bench_cache(&bench_cache_report);
+        bench_clock(&bench_clock_report);
+    }
+
+    /* Регулятор температуры управляет профилем тактирования после измерений */
+    xTaskCreate(app_thermal,
+                "app_thermal",
+                configMINIMAL_STACK_SIZE * 2,
+                NULL,
+                tskIDLE_PRIORITY + 2,
+                NULL);
+
     while (true) {
         vTaskDelayUntil(&last_wake_time, frequency);
 
         /* Включить зеленый светодиод - Работа */
         led_on(LED_GREEN);
+
+        runtime_snapshot(&runtime_report);
+
+        /* Режим измерения тика, переключенный отладчиком */
+        systick_set_measure(tick_measure);
     }
 
     vTaskDelete(NULL);
 }
 /* ------------------------------------------------------------------------- */
 
+/**
+ * @brief           Периодически проверять образ во внешней FLASH
+ *
+ * @note            CRC-32 слота рассчитывает CRC, данные из окна Memory Mapped
+ *                  XSPI передает GPDMA1. Задача только опрашивает завершение
+ *                  раз в тик, нагрузка на CPU незаметна. Образ проверен Boot
+ *                  (SHA-256) при запуске, CRC первой проверки - эталон
+ */
+static void app_scrub(void *argv)
+{
+    static const TickType_t frequency = pdMS_TO_TICKS(SCRUB_PERIOD);
+
+    const struct image_header *header = image_get_header();
+
+    if (header == NULL)
+        vTaskDelete(NULL);
+
+    const void *data = (const uint8_t *) header + header->header_size;
+    uint32_t size = header->image_size;
+
+    crc_benchmark(data, size < SCRUB_BENCHMARK_SIZE ? size : SCRUB_BENCHMARK_SIZE);
+
+    TickType_t last_wake_time = xTaskGetTickCount();
+
+    while (true) {
+        struct crc crc;
+        uint32_t value;
+        int32_t status;
+
+        crc_start(&crc, data, size);
+
+        while ((status = crc_process(&crc, &value)) == CRC_BUSY)
+            vTaskDelay(1);
+
+        if (status != CRC_OK || (scrub_passes > 0 && value != scrub_crc)) {
+            /* Включить желтый светодиод - Образ во FLASH изменился */
+            scrub_errors++;
+            led_on(LED_YELLOW);
+        } else if (scrub_passes == 0) {
+            scrub_crc = value;
+        }
+
+        scrub_passes++;
+
+        vTaskDelayUntil(&last_wake_time, frequency);
+    }
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Ограничивать частоту CPU по температуре кристалла
+ *
+ * @note            Приоритет выше задач приложения: понижение частоты
+ *                  при перегреве не откладывается нагрузкой
+ */
+static void app_thermal(void *argv)
+{
+    static const TickType_t frequency = pdMS_TO_TICKS(THERMAL_PERIOD);
+
+    thermal_init();
+    thermal_report = thermal_get_report();
+
+    TickType_t last_wake_time = xTaskGetTickCount();
+
+    while (true) {
+        vTaskDelayUntil(&last_wake_time, frequency);
+        thermal_process();
+    }
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Сравнить расчет CRC-32 через CRC + GPDMA1 и программный
+ *
+ * @param[in]       data: Указатель на данные
+ * @param[in]       size: Размер данных (байт)
+ *
+ * @note            Такты CPU (DWT CYCCNT, запущен Boot) сохраняются для
+ *                  просмотра отладчиком. При расхождении результатов
+ *                  включается желтый светодиод
+ */
+static void crc_benchmark(const void *data, uint32_t size)
+{
+    uint32_t hardware;
+    uint32_t software;
+
+    uint32_t cycles = READ_REG(DWT->CYCCNT);
+
+    if (crc_calculate(data, size, &hardware) != CRC_OK)
+        hardware = ~0;
+
+    crc_hardware_cycles = READ_REG(DWT->CYCCNT) - cycles;
+
+    cycles = READ_REG(DWT->CYCCNT);
+
+    software = crc_calculate_software(CRC_INITIAL, data, size);
+
+    crc_software_cycles = READ_REG(DWT->CYCCNT) - cycles;
+
+    if (hardware != software)
+        led_on(LED_YELLOW);
+}
+/* ------------------------------------------------------------------------- */
+
 void vApplicationIdleHook(void)
 {
-    /* Отслеживание свободного времени FreeRTOS */
-    appl_idle_hook_counter++;
     /* Обновить информацию об используемой памяти FreeRTOS */
     free_heap_size = xPortGetFreeHeapSize();
     minimum_ever_free_heap_size = xPortGetMinimumEverFreeHeapSize();
@@ -112,10 +319,60 @@ void vApplicationIdleHook(void)
 
 static void setup_hardware(void)
 {
-    setup_vector_table();
-    setup_fpu();
+    /* Получить от Boot настройку тактирования, FLASH и причину сброса */
+    handoff_init();
+
+    const struct handoff *handoff = handoff_get();
+
+    /* Определить профиль тактирования, настроенный Boot */
+    rcc_init();
+
+    uint32_t cpu_clock = rcc_get_cpu_hz();
+
+    dwt_set_frequency(cpu_clock);
+
+    /* Получить состояние пробуждения из Standby до остальной настройки */
+    standby_init();
+    standby_report = standby_get_report();
+
+    /* Таблица векторов настроена Boot перед переходом */
+    if (handoff == NULL || handoff->vector_address != VTOR_ADDRESS)
+        setup_vector_table();
+
+    if (handoff != NULL)
+        reset_cause = handoff->reset_cause;
+
+    /* Получить запись о сбое, сохраненную перед программным сбросом */
+    crash_init();
+    crash_report = crash_get();
 
-    systick_init(CPU_CLOCK);
+    mpu_init();
+    cache_init();
+
+    systick_init(cpu_clock);
+
+    /* Измерение прерывания тика выключено по умолчанию */
+    systick_set_measure(tick_measure);
+    tick_report = systick_get_stats();
+
+    /* Подавление тика в простое: пробуждение по LPTIM1 */
+    idle_init();
+    idle_report = idle_get_stats();
+
+    dma_init();
+    crc_init();
+
+    app_startup_us = startup_cycles / (cpu_clock / 1000000);
+
+    /* Получить отчет о времени загрузки Boot */
+    telemetry_init();
+    boot_report = telemetry_get_report();
+
+    const struct image_header *header = image_get_header();
+    uint32_t load_us = boot_report->stage_us[TELEMETRY_STAGE_IMAGE_LOAD];
+
+    if (boot_report->valid && header != NULL && (header->flags & IMAGE_FLAG_LZ4) && load_us != 0)
+        boot_image_load_rate = header->load_size * 1000 / load_us;
 }
 /* ------------------------------------------------------------------------- */
 
@@ -130,9 +387,3 @@ static void setup_vector_table(void)
     __enable_irq();
 }
 /* ------------------------------------------------------------------------- */
-
-static void setup_fpu(void)
-{
-    SET_BIT(SCB->CPACR, (0x03 << 20) | (0x03 << 22));
-}
-/* ------------------------------------------------------------------------- */
@@ -0,0 +1,112 @@
+/**
+ * Copyright (C) 2025 zhmaksim <zhiharev.maxim.alexandrovich@yandex.ru>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/* Includes ---------------------------------------------------------------- */
+
+#include "mpu.h"
+
+/* Private macros ---------------------------------------------------------- */
+
+/* Private constants ------------------------------------------------------- */
+
+/* Private types ----------------------------------------------------------- */
+
+/* Private variables ------------------------------------------------------- */
+
+static const ARM_MPU_Region_t mpu_region[] = {
+    /* Фон 4GB: нет доступа, без исполнения, кроме 0x00000000..0x5FFFFFFF и 0xE0000000..
+     * (запрещает спекулятивный доступ к неинициализированным внешним памятям) */
+    {
+        .RBAR = ARM_MPU_RBAR(0, 0x00000000),
+        .RASR = ARM_MPU_RASR_EX(1, ARM_MPU_AP_NONE, ARM_MPU_ACCESS_ORDERED,
+                                0x87, ARM_MPU_REGION_SIZE_4GB),
+    },
+    /* Внутренняя FLASH (Boot): Normal, Write-Through, только чтение, без исполнения */
+    {
+        .RBAR = ARM_MPU_RBAR(1, 0x08000000),
+        .RASR = ARM_MPU_RASR_EX(1, ARM_MPU_AP_RO,
+                                ARM_MPU_ACCESS_NORMAL(ARM_MPU_CACHEP_WT_NWA, ARM_MPU_CACHEP_WT_NWA, 0),
+                                0x00, ARM_MPU_REGION_SIZE_64KB),
+    },
+    /* Внешняя FLASH XSPI2 (XIP): Normal, Write-Through, только чтение */
+    {
+        .RBAR = ARM_MPU_RBAR(2, 0x70000000),
+        .RASR = ARM_MPU_RASR_EX(0, ARM_MPU_AP_RO,
+                                ARM_MPU_ACCESS_NORMAL(ARM_MPU_CACHEP_WT_NWA, ARM_MPU_CACHEP_WT_NWA, 0),
+                                0x00, ARM_MPU_REGION_SIZE_32MB),
+    },
+    /* AXI SRAM: Normal, Write-Back, Read/Write-Allocate */
+    {
+        .RBAR = ARM_MPU_RBAR(3, 0x24000000),
+        .RASR = ARM_MPU_RASR_EX(0, ARM_MPU_AP_FULL,
+                                ARM_MPU_ACCESS_NORMAL(ARM_MPU_CACHEP_WB_WRA, ARM_MPU_CACHEP_WB_WRA, 0),
+                                0x00, ARM_MPU_REGION_SIZE_512KB),
+    },
+    /* SRAM_AHB (буферы DMA): Normal, без кэширования, без исполнения */
+    {
+        .RBAR = ARM_MPU_RBAR(4, 0x30000000),
+        .RASR = ARM_MPU_RASR_EX(1, ARM_MPU_AP_FULL,
+                                ARM_MPU_ACCESS_NORMAL(ARM_MPU_CACHEP_NOCACHE, ARM_MPU_CACHEP_NOCACHE, 0),
+                                0x00, ARM_MPU_REGION_SIZE_32KB),
+    },
+    /* SRAM_BKP (обмен данными Boot/App): Normal, без кэширования, без исполнения */
+    {
+        .RBAR = ARM_MPU_RBAR(5, 0x38800000),
+        .RASR = ARM_MPU_RASR_EX(1, ARM_MPU_AP_FULL,
+                                ARM_MPU_ACCESS_NORMAL(ARM_MPU_CACHEP_NOCACHE, ARM_MPU_CACHEP_NOCACHE, 0),
+                                0x00, ARM_MPU_REGION_SIZE_4KB),
+    },
+    /* Периферия: Device, Shareable, без исполнения */
+    {
+        .RBAR = ARM_MPU_RBAR(6, 0x40000000),
+        .RASR = ARM_MPU_RASR_EX(1, ARM_MPU_AP_FULL, ARM_MPU_ACCESS_DEVICE(1),
+                                0x00, ARM_MPU_REGION_SIZE_512MB),
+    },
+};
+
+/* Private function prototypes --------------------------------------------- */
+
+/* Private user code ------------------------------------------------------- */
+
+/**
+ * @brief           Инициализировать MPU
+ *
+ * @note            ITCM и DTCM не кэшируются и используют карту памяти по умолчанию
+ */
+void mpu_init(void)
+{
+    ARM_MPU_Disable();
+
+    /* Загрузить таблицу регионов */
+    ARM_MPU_Load(mpu_region, sizeof(mpu_region) / sizeof(mpu_region[0]));
+
+    /* Включить MPU, для неописанных адресов использовать карту по умолчанию */
+    ARM_MPU_Enable(MPU_CTRL_PRIVDEFENA_Msk);
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Деинициализировать MPU
+ */
+void mpu_deinit(void)
+{
+    ARM_MPU_Disable();
+
+    for (uint32_t i = 0; i < sizeof(mpu_region) / sizeof(mpu_region[0]); i++)
+        ARM_MPU_ClrRegion(i);
+}
+/* ------------------------------------------------------------------------- */
@@ -0,0 +1,80 @@
+/**
+ * Copyright (C) 2025 zhmaksim <zhiharev.maxim.alexandrovich@yandex.ru>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/* Includes ---------------------------------------------------------------- */
+
+#include "pwr.h"
+#include "dwt.h"
+
+/* Private macros ---------------------------------------------------------- */
+
+/* Private constants ------------------------------------------------------- */
+
+#define PWR_VOSRDY_TIMEOUT       1000   /* Ожидание готовности VOS (мкс) */
+
+/* Private types ----------------------------------------------------------- */
+
+/* Private variables ------------------------------------------------------- */
+
+/* Private function prototypes --------------------------------------------- */
+
+/* Private user code ------------------------------------------------------- */
+
+/**
+ * @brief           Получить диапазон напряжения ядра
+ *
+ * @return          Диапазон PWR_VOS_x
+ */
+uint32_t pwr_get_voltage_scaling(void)
+{
+    return READ_BIT(PWR->CSR4, PWR_CSR4_VOS_Msk) ? PWR_VOS_HIGH : PWR_VOS_LOW;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Настроить диапазон напряжения ядра
+ *
+ * @param[in]       vos: Диапазон PWR_VOS_x
+ * @return          Статус:
+ *                      - PWR_ERROR
+ *                      - PWR_OK
+ *
+ * @note            Перед повышением частоты напряжение повышается
+ *                  с ожиданием готовности LDO, понижается - после
+ *                  понижения частоты. Ожидание ограничено по DWT
+ *                  (выполняется с запретом прерываний)
+ */
+int32_t pwr_set_voltage_scaling(uint32_t vos)
+{
+    if (pwr_get_voltage_scaling() == vos)
+        return PWR_OK;
+
+    struct dwt_deadline deadline;
+
+    dwt_deadline_start(&deadline, PWR_VOSRDY_TIMEOUT);
+
+    MODIFY_REG(PWR->CSR4, PWR_CSR4_VOS_Msk, vos << PWR_CSR4_VOS_Pos);
+
+    /* Ожидание готовности VOS */
+    while (!READ_BIT(PWR->CSR4, PWR_CSR4_VOSRDY_Msk)) {
+        if (dwt_deadline_expired(&deadline))
+            return PWR_ERROR;
+    }
+
+    return PWR_OK;
+}
+/* ------------------------------------------------------------------------- */
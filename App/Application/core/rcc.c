@@ -0,0 +1,483 @@
+/**
+ * Copyright (C) 2025 zhmaksim <zhiharev.maxim.alexandrovich@yandex.ru>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/* Includes ---------------------------------------------------------------- */
+
+#include "rcc.h"
+#include "pwr.h"
+#include "flash.h"
+#include "systick.h"
+#include "dwt.h"
+#include "handoff.h"
+
+/* Private macros ---------------------------------------------------------- */
+
+/* Значение CPRE/BMPRE по делителю 1, 2, 4, 8 */
+#define RCC_PRE(div)            ((div) == 1 ? 0x00 : (div) == 2 ? 0x08 :      \
+                                 (div) == 4 ? 0x09 : 0x0A)
+
+/* Значение PPRE по делителю 1, 2, 4, 8 */
+#define RCC_PPRE(div)           ((div) == 1 ? 0x00 : (div) == 2 ? 0x04 :      \
+                                 (div) == 4 ? 0x05 : 0x06)
+
+/* Профиль с источником sw частоты source, делителями CPU div и AXI/AHB bus_div */
+#define RCC_PROFILE(sw_, source, div, bus_div, vos_)                            \
+    {                                                                           \
+        .sw = (sw_), .cpre = RCC_PRE(div), .cpu_divider = (div),                \
+        .bmpre = RCC_PRE(bus_div), .bus_divider = (bus_div),                    \
+        .apbcfgr = RCC_APBCFGR, .vos = (vos_),                                  \
+        .clocks = {                                                             \
+            .cpu = (source) / (div),                                            \
+            .bus_matrix = RCC_BUS_MATRIX(source, bus_div),                      \
+            .apb1 = RCC_BUS_MATRIX(source, bus_div) / RCC_APB_DIVIDER,          \
+            .apb2 = RCC_BUS_MATRIX(source, bus_div) / RCC_APB_DIVIDER,          \
+            .apb4 = RCC_BUS_MATRIX(source, bus_div) / RCC_APB_DIVIDER,          \
+            .apb5 = RCC_BUS_MATRIX(source, bus_div) / RCC_APB_DIVIDER,          \
+            .xspi = RCC_XSPI_CLOCK,                                             \
+        },                                                                      \
+    }
+
+/* BMPRE делит sys_ck параллельно с CPRE (RM0477, RCC_BMCFGR): AXI/AHB
+ * не зависит от делителя CPU */
+#define RCC_BUS_MATRIX(source, bus_div) ((source) / (bus_div))
+
+/* Private constants ------------------------------------------------------- */
+
+#define RCC_SW_HSI               0x00
+#define RCC_SW_PLL1              0x03
+
+#define RCC_SWS_TIMEOUT          100    /* Переключение источника CPU (мкс) */
+
+#define RCC_APBCFGR             (RCC_PPRE(RCC_APB_DIVIDER) << RCC_APBCFGR_PPRE1_Pos   \
+                               | RCC_PPRE(RCC_APB_DIVIDER) << RCC_APBCFGR_PPRE2_Pos   \
+                               | RCC_PPRE(RCC_APB_DIVIDER) << RCC_APBCFGR_PPRE4_Pos   \
+                               | RCC_PPRE(RCC_APB_DIVIDER) << RCC_APBCFGR_PPRE5_Pos)
+
+/* Максимальные частоты CPU и AXI/AHB для VOS = Low */
+#define RCC_VOS_LOW_CPU_MAX_CLOCK        400000000
+#define RCC_VOS_LOW_BUS_MATRIX_MAX_CLOCK 200000000
+
+/* Максимальные частоты CPU и AXI/AHB для VOS = High */
+#define RCC_VOS_HIGH_CPU_MAX_CLOCK        600000000
+#define RCC_VOS_HIGH_BUS_MATRIX_MAX_CLOCK 300000000
+
+/* Профиль RCC_PROFILE_600MHZ - настройка Boot (rcc_config.h) */
+_Static_assert(RCC_APB_DIVIDER == RCC_APB1_DIVIDER
+            && RCC_APB_DIVIDER == RCC_APB2_DIVIDER
+            && RCC_APB_DIVIDER == RCC_APB4_DIVIDER
+            && RCC_APB_DIVIDER == RCC_APB5_DIVIDER,
+               "APB dividers differ from Boot configuration");
+_Static_assert((RCC_CPU_DIVIDER == 1 || RCC_CPU_DIVIDER == 2
+             || RCC_CPU_DIVIDER == 4 || RCC_CPU_DIVIDER == 8)
+            && (RCC_BUS_MATRIX_DIVIDER == 1 || RCC_BUS_MATRIX_DIVIDER == 2
+             || RCC_BUS_MATRIX_DIVIDER == 4 || RCC_BUS_MATRIX_DIVIDER == 8),
+               "Boot CPU/bus divider is not supported by RCC_PRE");
+
+/* Профили не превышают ограничений своего диапазона VOS
+ * (делители - как в таблице rcc_profile) */
+_Static_assert(RCC_CPU_CLOCK <= RCC_VOS_HIGH_CPU_MAX_CLOCK
+            && RCC_BUS_MATRIX_CLOCK <= RCC_VOS_HIGH_BUS_MATRIX_MAX_CLOCK,
+               "RCC_PROFILE_600MHZ exceeds VOS High limit");
+_Static_assert(RCC_PLL1P_CLOCK / 2 <= RCC_VOS_LOW_CPU_MAX_CLOCK
+            && RCC_BUS_MATRIX(RCC_PLL1P_CLOCK, 4) <= RCC_VOS_LOW_BUS_MATRIX_MAX_CLOCK,
+               "RCC_PROFILE_300MHZ exceeds VOS Low limit");
+_Static_assert(RCC_PLL1P_CLOCK / 4 <= RCC_VOS_LOW_CPU_MAX_CLOCK
+            && RCC_BUS_MATRIX(RCC_PLL1P_CLOCK, 8) <= RCC_VOS_LOW_BUS_MATRIX_MAX_CLOCK,
+               "RCC_PROFILE_150MHZ exceeds VOS Low limit");
+_Static_assert(RCC_HSI_CLOCK / 1 <= RCC_VOS_LOW_CPU_MAX_CLOCK
+            && RCC_BUS_MATRIX(RCC_HSI_CLOCK, 2) <= RCC_VOS_LOW_BUS_MATRIX_MAX_CLOCK,
+               "RCC_PROFILE_64MHZ exceeds VOS Low limit");
+
+/* Private types ----------------------------------------------------------- */
+
+/**
+ * @brief           Определение структуры данных профиля тактирования
+ */
+struct rcc_profile_config {
+    uint32_t sw;                                /*!< Источник тактирования CPU RCC_SW_x */
+
+    uint32_t cpre;                              /*!< Делитель CPU RCC_PRE_x */
+
+    uint32_t cpu_divider;                       /*!< Значение делителя CPU */
+
+    uint32_t bmpre;                             /*!< Делитель AXI/AHB RCC_PRE_x */
+
+    uint32_t bus_divider;                       /*!< Значение делителя AXI/AHB */
+
+    uint32_t apbcfgr;                           /*!< Делители APB */
+
+    uint32_t vos;                               /*!< Диапазон напряжения ядра PWR_VOS_x */
+
+    struct rcc_clocks clocks;                   /*!< Частоты тактирования */
+};
+
+/* Private variables ------------------------------------------------------- */
+
+/* Частоты профилей вычисляются при компиляции */
+static const struct rcc_profile_config rcc_profile[RCC_PROFILE_COUNT] = {
+    [RCC_PROFILE_600MHZ] = RCC_PROFILE(RCC_SW_PLL1, RCC_PLL1P_CLOCK, RCC_CPU_DIVIDER, RCC_BUS_MATRIX_DIVIDER, PWR_VOS_HIGH),
+    [RCC_PROFILE_300MHZ] = RCC_PROFILE(RCC_SW_PLL1, RCC_PLL1P_CLOCK, 2, 4, PWR_VOS_LOW),
+    [RCC_PROFILE_150MHZ] = RCC_PROFILE(RCC_SW_PLL1, RCC_PLL1P_CLOCK, 4, 8, PWR_VOS_LOW),
+    [RCC_PROFILE_64MHZ] = RCC_PROFILE(RCC_SW_HSI, RCC_HSI_CLOCK, 1, 2, PWR_VOS_LOW),
+};
+
+static uint32_t active;
+
+static struct rcc_clocks clocks;
+
+static uint32_t switch_time;
+
+/* Private function prototypes --------------------------------------------- */
+
+static int32_t rcc_switch(const struct rcc_profile_config *next, uint32_t cpu_divider, uint32_t bus_divider);
+
+static int32_t rcc_setup_clksource_cpu(uint32_t sw);
+
+/* Private user code ------------------------------------------------------- */
+
+/**
+ * @brief           Инициализировать RCC
+ *
+ * @note            Тактирование настроено Boot, определяется профиль,
+ *                  соответствующий текущим источнику и делителям. Иначе
+ *                  частоты берутся из блока передачи, без блока передачи
+ *                  (запуск отладчиком) - частоты настройки Boot.
+ *                  LSE (LPTIM1, DTS) запускается без ожидания готовности
+ */
+void rcc_init(void)
+{
+    /* Разрешить запись в домен резервного питания и включить LSE */
+    SET_BIT(PWR->CR1, PWR_CR1_DBP_Msk);
+    SET_BIT(RCC->BDCR, RCC_BDCR_LSEON_Msk);
+
+    uint32_t sw = READ_BIT(RCC->CFGR, RCC_CFGR_SWS_Msk) >> RCC_CFGR_SWS_Pos;
+    uint32_t cpre = READ_BIT(RCC->CDCFGR, RCC_CDCFGR_CPRE_Msk) >> RCC_CDCFGR_CPRE_Pos;
+    uint32_t bmpre = READ_BIT(RCC->BMCFGR, RCC_BMCFGR_BMPRE_Msk) >> RCC_BMCFGR_BMPRE_Pos;
+
+    for (active = 0; active < RCC_PROFILE_COUNT; active++) {
+        const struct rcc_profile_config *config = &rcc_profile[active];
+
+        if (config->sw == sw && config->cpre == cpre && config->bmpre == bmpre
+                && config->apbcfgr == READ_REG(RCC->APBCFGR))
+            break;
+    }
+
+    const struct handoff *handoff = handoff_get();
+
+    if (active < RCC_PROFILE_COUNT) {
+        clocks = rcc_profile[active].clocks;
+    } else if (handoff != NULL) {
+        clocks.cpu = handoff->cpu_clock;
+        clocks.bus_matrix = handoff->bus_matrix_clock;
+        clocks.apb1 = handoff->apb1_clock;
+        clocks.apb2 = handoff->apb2_clock;
+        clocks.apb4 = handoff->apb4_clock;
+        clocks.apb5 = handoff->apb5_clock;
+        clocks.xspi = handoff->xspi_clock;
+    } else {
+        clocks = rcc_profile[RCC_PROFILE_600MHZ].clocks;
+    }
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Переключить профиль тактирования
+ *
+ * @param[in]       profile: Профиль @ref enum rcc_profile
+ * @return          Статус:
+ *                      - RCC_ERROR
+ *                      - RCC_OK
+ *
+ * @note            Порядок: повышение VOS и задержки FLASH, переключение
+ *                  источника и делителей, понижение задержки FLASH и VOS.
+ *                  Выполняется с запретом прерываний, SysTick перенастраивается
+ *                  до разрешения прерываний (погрешность - не более одного тика).
+ *                  Остальные модули уведомляются rcc_profile_changed_callback()
+ */
+int32_t rcc_set_profile(uint32_t profile)
+{
+    if (profile >= RCC_PROFILE_COUNT)
+        return RCC_ERROR;
+
+    const struct rcc_profile_config *next = &rcc_profile[profile];
+
+    /* PLL1 настраивает Boot */
+    if (next->sw == RCC_SW_PLL1 && !READ_BIT(RCC->CR, RCC_CR_PLL1RDY_Msk))
+        return RCC_ERROR;
+
+    if (profile == active)
+        return RCC_OK;
+
+    uint32_t cpu_divider = active < RCC_PROFILE_COUNT ? rcc_profile[active].cpu_divider : 1;
+    uint32_t bus_divider = active < RCC_PROFILE_COUNT ? rcc_profile[active].bus_divider : 1;
+    uint32_t cpu_mhz = clocks.cpu / 1000000;
+    uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+
+    int32_t status = RCC_OK;
+    uint32_t start = READ_REG(DWT->CYCCNT);
+
+    /* Повысить напряжение и задержку FLASH до повышения частоты */
+    if (next->vos == PWR_VOS_HIGH && pwr_set_voltage_scaling(PWR_VOS_HIGH) != PWR_OK) {
+        __set_PRIMASK(primask);
+        return RCC_ERROR;
+    }
+
+    if (next->clocks.bus_matrix > clocks.bus_matrix)
+        flash_set_latency(next->clocks.bus_matrix);
+
+    /* Источник не переключился: частота CPU не определена */
+    if (rcc_switch(next, cpu_divider, bus_divider) != RCC_OK)
+        error();
+
+    uint32_t resumed = READ_REG(DWT->CYCCNT);
+
+    /* Понизить задержку FLASH и напряжение после понижения частоты
+     * (VOS не понизился - профиль действует на повышенном напряжении) */
+    if (next->clocks.bus_matrix < clocks.bus_matrix)
+        flash_set_latency(next->clocks.bus_matrix);
+
+    if (next->vos == PWR_VOS_LOW && pwr_set_voltage_scaling(PWR_VOS_LOW) != PWR_OK)
+        status = RCC_ERROR;
+
+    systick_set_frequency(next->clocks.cpu);
+    dwt_set_frequency(next->clocks.cpu);
+
+    /* Длительность: до переключения - на прежней частоте, после - на новой */
+    switch_time = (resumed - start) * 1000 / cpu_mhz
+                + (READ_REG(DWT->CYCCNT) - resumed) * 1000 / (next->clocks.cpu / 1000000);
+
+    active = profile;
+    clocks = next->clocks;
+
+    __set_PRIMASK(primask);
+
+    rcc_profile_changed_callback(active);
+
+    return status;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Получить текущий профиль тактирования
+ *
+ * @return          Профиль @ref enum rcc_profile (RCC_PROFILE_COUNT - не профиль)
+ */
+uint32_t rcc_get_profile(void)
+{
+    return active;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Получить частоты тактирования
+ *
+ * @return          Указатель на частоты текущего профиля
+ */
+const struct rcc_clocks *rcc_get_clocks(void)
+{
+    return &clocks;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Получить частоту CPU
+ *
+ * @return          Частота текущего профиля (Гц)
+ */
+uint32_t rcc_get_cpu_hz(void)
+{
+    return clocks.cpu;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Получить делитель CPU
+ *
+ * @return          Значение делителя CPRE (1...512)
+ *
+ * @note            Читается из RCC_CDCFGR: делитель сохраняется в Stop,
+ *                  после пробуждения CPU работает на HSI / CPRE
+ */
+uint32_t rcc_get_cpu_divider(void)
+{
+    uint32_t cpre = READ_BIT(RCC->CDCFGR, RCC_CDCFGR_CPRE_Msk) >> RCC_CDCFGR_CPRE_Pos;
+
+    return cpre < 0x08 ? 1 : 2UL << (cpre - 0x08);
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Получить частоту AXI/AHB
+ *
+ * @return          Частота текущего профиля (Гц)
+ */
+uint32_t rcc_get_bus_matrix_hz(void)
+{
+    return clocks.bus_matrix;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Получить частоту APB1
+ *
+ * @return          Частота текущего профиля (Гц)
+ */
+uint32_t rcc_get_apb1_hz(void)
+{
+    return clocks.apb1;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Получить частоту APB2
+ *
+ * @return          Частота текущего профиля (Гц)
+ */
+uint32_t rcc_get_apb2_hz(void)
+{
+    return clocks.apb2;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Получить частоту APB4
+ *
+ * @return          Частота текущего профиля (Гц)
+ */
+uint32_t rcc_get_apb4_hz(void)
+{
+    return clocks.apb4;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Получить частоту APB5
+ *
+ * @return          Частота текущего профиля (Гц)
+ */
+uint32_t rcc_get_apb5_hz(void)
+{
+    return clocks.apb5;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Получить частоту ядра XSPI2
+ *
+ * @return          Частота текущего профиля (Гц)
+ */
+uint32_t rcc_get_xspi_hz(void)
+{
+    return clocks.xspi;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Получить длительность последнего переключения профиля
+ *
+ * @return          Длительность (нс)
+ */
+uint32_t rcc_get_switch_time(void)
+{
+    return switch_time;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Проверить готовность LSE
+ *
+ * @return          true - LSE готов
+ */
+bool rcc_is_lse_ready(void)
+{
+    return READ_BIT(RCC->BDCR, RCC_BDCR_LSERDY_Msk);
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Переключить источник тактирования и делители CPU
+ *
+ * @param[in]       next: Указатель на профиль
+ * @param[in]       cpu_divider: Значение делителя CPU текущего профиля
+ * @param[in]       bus_divider: Значение делителя AXI/AHB текущего профиля
+ *
+ * @return          Статус:
+ *                      - RCC_ERROR
+ *                      - RCC_OK
+ *
+ * @note            Частоты CPU и AXI/AHB не должны превысить частоты профилей
+ *                  на промежуточном шаге: больший делитель записывается
+ *                  до смены источника, меньший - после
+ */
+static int32_t rcc_switch(const struct rcc_profile_config *next, uint32_t cpu_divider, uint32_t bus_divider)
+{
+    WRITE_REG(RCC->APBCFGR, next->apbcfgr);
+
+    if (next->bus_divider >= bus_divider)
+        MODIFY_REG(RCC->BMCFGR, RCC_BMCFGR_BMPRE_Msk, next->bmpre << RCC_BMCFGR_BMPRE_Pos);
+
+    if (next->cpu_divider >= cpu_divider)
+        MODIFY_REG(RCC->CDCFGR, RCC_CDCFGR_CPRE_Msk, next->cpre << RCC_CDCFGR_CPRE_Pos);
+
+    if (rcc_setup_clksource_cpu(next->sw) != RCC_OK)
+        return RCC_ERROR;
+
+    if (next->bus_divider < bus_divider)
+        MODIFY_REG(RCC->BMCFGR, RCC_BMCFGR_BMPRE_Msk, next->bmpre << RCC_BMCFGR_BMPRE_Pos);
+
+    if (next->cpu_divider < cpu_divider)
+        MODIFY_REG(RCC->CDCFGR, RCC_CDCFGR_CPRE_Msk, next->cpre << RCC_CDCFGR_CPRE_Pos);
+
+    return RCC_OK;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Настроить источник тактирования CPU
+ *
+ * @param[in]       sw: Источник тактирования RCC_SW_x
+ * @return          Статус:
+ *                      - RCC_ERROR
+ *                      - RCC_OK
+ */
+static int32_t rcc_setup_clksource_cpu(uint32_t sw)
+{
+    struct dwt_deadline deadline;
+
+    dwt_deadline_start(&deadline, RCC_SWS_TIMEOUT);
+
+    MODIFY_REG(RCC->CFGR,
+               RCC_CFGR_SW_Msk,
+               sw << RCC_CFGR_SW_Pos);
+
+    while (READ_BIT(RCC->CFGR, RCC_CFGR_SWS_Msk) !=
+            sw << RCC_CFGR_SWS_Pos) {
+        if (dwt_deadline_expired(&deadline))
+            return RCC_ERROR;
+    }
+
+    return RCC_OK;
+}
+/* ------------------------------------------------------------------------- */
+
+__WEAK void rcc_profile_changed_callback(uint32_t profile)
+{
+
+}
+/* ------------------------------------------------------------------------- */
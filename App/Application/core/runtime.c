@@ -0,0 +1,237 @@
+/**
+ * Copyright (C) 2025 zhmaksim <zhiharev.maxim.alexandrovich@yandex.ru>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/* Includes ---------------------------------------------------------------- */
+
+#include "runtime.h"
+#include "systick.h"
+
+/* Private macros ---------------------------------------------------------- */
+
+/* Private constants ------------------------------------------------------- */
+
+/* Делитель доли сокращается до 18 бит: part * RUNTIME_LOAD_SCALE < 2^32 */
+#define RUNTIME_RATIO_LIMIT             (1UL << 18)
+
+/* Private types ----------------------------------------------------------- */
+
+/* Private variables ------------------------------------------------------- */
+
+static uint64_t base;                           /* Счетчик тактов при запуске планировщика */
+
+static volatile uint64_t added;                 /* Время простоя, не подсчитанное DWT CYCCNT (такты CPU) */
+
+/* Состояние задач: заполняет uxTaskGetSystemState() */
+static TaskStatus_t status[RUNTIME_TASK_MAX];
+
+/* Время выполнения задач в предыдущем снимке */
+static uint32_t last_number[RUNTIME_TASK_MAX];
+static uint64_t last_cycles[RUNTIME_TASK_MAX];
+static uint32_t last_count;
+static uint64_t last_timestamp;
+
+static uint32_t sequence;
+static uint32_t load_max;
+
+/* Private function prototypes --------------------------------------------- */
+
+static uint64_t runtime_get_last_cycles(uint32_t number);
+
+static uint32_t runtime_ratio(uint64_t part, uint64_t whole);
+
+static void runtime_copy_name(char *destination, const char *source);
+
+/* Private user code ------------------------------------------------------- */
+
+/**
+ * @brief           Запустить отсчет времени выполнения задач
+ *
+ * @note            Вызывается FreeRTOS при запуске планировщика
+ *                  (portCONFIGURE_TIMER_FOR_RUN_TIME_STATS). DWT CYCCNT
+ *                  запущен Boot и startup
+ */
+void runtime_init(void)
+{
+    base = systick_get_cycles();
+    added = 0;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Получить счетчик времени выполнения (portGET_RUN_TIME_COUNTER_VALUE)
+ *
+ * @return          Время от запуска планировщика (такты CPU)
+ *
+ * @note            Вызывается при каждом переключении задач. DWT CYCCNT
+ *                  дополнен старшим словом (переполнение каждые 7 с на 600 МГц)
+ *                  и временем простоя, в течение которого CYCCNT не считал
+ */
+uint64_t runtime_get_counter(void)
+{
+    uint64_t offset;
+
+    /* Время простоя обновляется задачей простоя при запрете прерываний */
+    do {
+        offset = added;
+    } while (offset != added);
+
+    return systick_get_cycles() - base + offset;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Учесть время простоя, не подсчитанное DWT CYCCNT
+ *
+ * @param[in]       cycles: Время (такты CPU)
+ *
+ * @note            Вызывается idle_sleep() при запрете прерываний:
+ *                  в Stop тактирование CPU выключено
+ */
+void runtime_add_cycles(const uint32_t cycles)
+{
+    added += cycles;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Сделать снимок времени выполнения задач
+ *
+ * @param[out]      snapshot: Указатель на снимок
+ * @return          Статус:
+ *                      - RUNTIME_ERROR
+ *                      - RUNTIME_OK
+ *
+ * @note            Загрузка рассчитывается за окно от предыдущего снимка.
+ *                  Планировщик приостанавливается на время обхода задач
+ *                  (единицы мкс, без форматирования строк). Вызывается
+ *                  из одной задачи, ошибка - задач больше RUNTIME_TASK_MAX
+ */
+int32_t runtime_snapshot(struct runtime_snapshot *snapshot)
+{
+    configRUN_TIME_COUNTER_TYPE timestamp;
+    UBaseType_t count = uxTaskGetSystemState(status, RUNTIME_TASK_MAX, &timestamp);
+
+    if (count == 0)
+        return RUNTIME_ERROR;
+
+    TaskHandle_t idle = xTaskGetIdleTaskHandle();
+    uint64_t window = timestamp - last_timestamp;
+    uint64_t busy = window;
+
+    for (uint32_t i = 0; i < count; i++) {
+        const TaskStatus_t *info = &status[i];
+        struct runtime_task *task = &snapshot->task[i];
+        uint64_t cycles = info->ulRunTimeCounter - runtime_get_last_cycles(info->xTaskNumber);
+
+        task->number = info->xTaskNumber;
+        task->priority = info->uxCurrentPriority;
+        task->state = info->eCurrentState;
+        task->stack_free = info->usStackHighWaterMark;
+        task->load = runtime_ratio(cycles, window);
+        task->cycles = info->ulRunTimeCounter;
+
+        runtime_copy_name(task->name, info->pcTaskName);
+
+        if (info->xHandle == idle)
+            busy = cycles < window ? window - cycles : 0;
+    }
+
+    /* Сохранить время выполнения для следующего окна */
+    for (uint32_t i = 0; i < count; i++) {
+        last_number[i] = status[i].xTaskNumber;
+        last_cycles[i] = status[i].ulRunTimeCounter;
+    }
+
+    last_count = count;
+    last_timestamp = timestamp;
+
+    snapshot->sequence = ++sequence;
+    snapshot->task_count = count;
+    snapshot->timestamp = timestamp;
+    snapshot->window = window;
+    snapshot->load = runtime_ratio(busy, window);
+
+    if (snapshot->load > load_max)
+        load_max = snapshot->load;
+
+    snapshot->load_max = load_max;
+
+    return RUNTIME_OK;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Получить время выполнения задачи в предыдущем снимке
+ *
+ * @param[in]       number: Номер задачи FreeRTOS
+ * @return          Время (такты CPU), 0 - задача создана после снимка
+ */
+static uint64_t runtime_get_last_cycles(uint32_t number)
+{
+    for (uint32_t i = 0; i < last_count; i++) {
+        if (last_number[i] == number)
+            return last_cycles[i];
+    }
+
+    return 0;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Рассчитать долю
+ *
+ * @param[in]       part: Часть
+ * @param[in]       whole: Целое
+ * @return          Доля (0.01 %)
+ *
+ * @note            Деление 64 бит недоступно (libgcc исключена):
+ *                  значения сокращаются до деления 32 бит
+ */
+static uint32_t runtime_ratio(uint64_t part, uint64_t whole)
+{
+    while (whole >= RUNTIME_RATIO_LIMIT) {
+        part >>= 1;
+        whole >>= 1;
+    }
+
+    if (whole == 0)
+        return 0;
+
+    if (part > whole)
+        part = whole;
+
+    return (uint32_t) part * RUNTIME_LOAD_SCALE / (uint32_t) whole;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Скопировать имя задачи
+ *
+ * @param[out]      destination: Имя в снимке (configMAX_TASK_NAME_LEN)
+ * @param[in]       source: Имя задачи FreeRTOS
+ */
+static void runtime_copy_name(char *destination, const char *source)
+{
+    uint32_t i = 0;
+
+    for (; i < configMAX_TASK_NAME_LEN - 1 && source[i] != '\0'; i++)
+        destination[i] = source[i];
+
+    for (; i < configMAX_TASK_NAME_LEN; i++)
+        destination[i] = '\0';
+}
+/* ------------------------------------------------------------------------- */
@@ -0,0 +1,518 @@
+/**
+ * Copyright (C) 2025 zhmaksim <zhiharev.maxim.alexandrovich@yandex.ru>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/* Includes ---------------------------------------------------------------- */
+
+#include "standby.h"
+#include "rcc.h"
+#include "dwt.h"
+#include "handoff.h"
+
+/* Private macros ---------------------------------------------------------- */
+
+/* Private constants ------------------------------------------------------- */
+
+/* ck_apre = LSE / 2, ck_spre = 1 Гц, такт RTC_SSR = 1 / 16384 с (61 мкс) */
+#define STANDBY_RTC_PREDIV_A            1
+#define STANDBY_RTC_TICK_SHIFT          14
+#define STANDBY_RTC_PREDIV_S            ((1UL << STANDBY_RTC_TICK_SHIFT) - 1)
+
+#define STANDBY_RTC_KEY1                0xCA
+#define STANDBY_RTC_KEY2                0x53
+#define STANDBY_RTC_LOCK                0xFF
+
+#define STANDBY_RTCSEL_LSE              0x01
+#define STANDBY_WUCKSEL_CK_SPRE         0x04            /* WUT 16 бит, такт 1 с */
+
+#define STANDBY_SECONDS_PER_DAY         86400
+
+#define STANDBY_LSE_TIMEOUT             5000000         /* Запуск LSE (мкс) */
+#define STANDBY_RTC_TIMEOUT             10000           /* INITF, WUTWF (мкс) */
+#define STANDBY_BREN_TIMEOUT            10000           /* Готовность Backup регулятора (мкс) */
+
+/* Private types ----------------------------------------------------------- */
+
+/* Private variables ------------------------------------------------------- */
+
+static struct standby_state *const state = (struct standby_state *) STANDBY_STATE_ADDRESS;
+
+static struct standby_report report;
+
+static uint32_t wake_seconds;                   /* Секунда суток пробуждения (RTC_TR Boot) */
+
+/* Private function prototypes --------------------------------------------- */
+
+static void standby_read_time(uint32_t *tr, uint32_t *ssr);
+
+static uint32_t standby_get_ticks(uint32_t tr, uint32_t ssr);
+
+static uint32_t standby_ticks_to_us(uint32_t ticks);
+
+static uint32_t standby_tr_to_seconds(uint32_t tr);
+
+static int32_t standby_setup_rtc(void);
+
+static int32_t standby_setup_wakeup(uint32_t period);
+
+static void standby_stop_wakeup(void);
+
+static int32_t standby_setup_backup_regulator(void);
+
+static void standby_save(uint32_t period, uint32_t context);
+
+static bool standby_is_valid(void);
+
+static uint32_t standby_checksum(const struct standby_state *block);
+
+/* Private user code ------------------------------------------------------- */
+
+/**
+ * @brief           Прочитать состояние пробуждения из Standby
+ *
+ * @note            Вызывается первым после rcc_init(): задержка пробуждение ->
+ *                  App рассчитывается по RTC_SSR при вызове за вычетом
+ *                  длительности startup. Таймер пробуждения останавливается,
+ *                  следующий цикл запускает standby_enter()
+ */
+void standby_init(void)
+{
+    uint32_t tr;
+    uint32_t ssr;
+
+    /* Выключить защиту от записи Backup домена */
+    SET_BIT(PWR->CR1, PWR_CR1_DBP_Msk);
+
+    /* Включить тактирование BKPSRAM и интерфейса RTC */
+    SET_BIT(RCC->AHB4ENR, RCC_AHB4ENR_BKPRAMEN_Msk);
+    SET_BIT(RCC->APB4ENR, RCC_APB4ENR_RTCAPBEN_Msk);
+    (void) READ_REG(RCC->APB4ENR);
+
+    standby_read_time(&tr, &ssr);
+
+    report.resumed = standby_is_valid() && state->wake;
+
+    if (report.resumed) {
+        uint32_t startup_us = startup_cycles / (rcc_get_cpu_hz() / 1000000);
+        uint32_t app_us;
+
+        wake_seconds = standby_tr_to_seconds(state->wake_tr);
+
+        report.fast_resume = state->fast_resume;
+        report.wakes = state->wakes;
+        report.period = state->period;
+        report.context = state->context;
+        report.boot_us = standby_ticks_to_us(standby_get_ticks(state->wake_tr, state->wake_ssr));
+
+        app_us = standby_ticks_to_us(standby_get_ticks(tr, ssr));
+        report.app_us = app_us > startup_us ? app_us - startup_us : 0;
+    }
+
+    standby_stop_wakeup();
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Получить отчет о пробуждении
+ *
+ * @return          Указатель на отчет
+ */
+const struct standby_report *standby_get_report(void)
+{
+    return &report;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Зафиксировать начало работы после пробуждения
+ *
+ * @note            Вызывается App в начале полезной работы цикла,
+ *                  учитывается первый вызов
+ */
+void standby_mark_work(void)
+{
+    if (report.resumed && report.work_us == 0)
+        report.work_us = standby_get_elapsed_us();
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Получить время от пробуждения
+ *
+ * @return          Время (мкс), 0 - запуск не пробуждением
+ */
+uint32_t standby_get_elapsed_us(void)
+{
+    uint32_t tr;
+    uint32_t ssr;
+
+    if (!report.resumed)
+        return 0;
+
+    standby_read_time(&tr, &ssr);
+
+    return standby_ticks_to_us(standby_get_ticks(tr, ssr));
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Перейти в Standby с пробуждением по RTC
+ *
+ * @param[in]       period: Период пробуждения (с), 1...STANDBY_PERIOD_MAX
+ * @param[in]       context: Данные App, доступные после пробуждения
+ * @return          Статус:
+ *                      - STANDBY_ERROR
+ *
+ * @note            RTC тактируется от LSE, таймер пробуждения - от ck_spre:
+ *                  пробуждение совпадает с началом секунды, первое наступает
+ *                  через period - 1...period с. Состояние сохраняется в SRAM_BKP,
+ *                  Boot по нему запускает образ без проверки подписи.
+ *                  ОЗУ, кроме SRAM_BKP, не сохраняется. При успешном переходе
+ *                  функция не возвращает управление, ожидающее прерывание
+ *                  отменяет переход. MX25UW остается в режиме OPI DTR
+ *                  (отмененный переход продолжает выполнение из XSPI),
+ *                  после пробуждения ее сбрасывает Boot (mx25uw_init)
+ */
+int32_t standby_enter(uint32_t period, uint32_t context)
+{
+    int32_t status;
+
+    if (period == 0 || period > STANDBY_PERIOD_MAX)
+        return STANDBY_ERROR;
+
+    /* Выключить защиту от записи RTC */
+    WRITE_REG(RTC->WPR, STANDBY_RTC_KEY1);
+    WRITE_REG(RTC->WPR, STANDBY_RTC_KEY2);
+
+    status = standby_setup_rtc();
+
+    if (status == STANDBY_OK)
+        status = standby_setup_wakeup(period);
+
+    WRITE_REG(RTC->WPR, STANDBY_RTC_LOCK);
+
+    if (status != STANDBY_OK || standby_setup_backup_regulator() != STANDBY_OK) {
+        standby_stop_wakeup();
+        return STANDBY_ERROR;
+    }
+
+    standby_save(period, context);
+
+    __disable_irq();
+
+    /* Остановить SysTick: ожидающее прерывание тика отменяет переход */
+    CLEAR_BIT(SysTick->CTRL, SysTick_CTRL_TICKINT_Msk | SysTick_CTRL_ENABLE_Msk);
+    WRITE_REG(SCB->ICSR, SCB_ICSR_PENDSTCLR_Msk);
+
+    /* Сбросить флаги пробуждения по выводам WKUP */
+    WRITE_REG(PWR->WKUPCR, PWR_WKUPCR_WKUPC_Msk);
+
+    /* Standby (PDDS = 1) */
+    SET_BIT(PWR->CSR3, PWR_CSR3_PDDS_Msk);
+    SET_BIT(SCB->SCR, SCB_SCR_SLEEPDEEP_Msk);
+
+    __DSB();
+    __WFI();
+    __ISB();
+
+    /* Переход отменен: вернуть Stop для простоя и запустить SysTick */
+    CLEAR_BIT(SCB->SCR, SCB_SCR_SLEEPDEEP_Msk);
+    CLEAR_BIT(PWR->CSR3, PWR_CSR3_PDDS_Msk);
+
+    state->magic = 0;
+    standby_stop_wakeup();
+
+    SET_BIT(SysTick->CTRL, SysTick_CTRL_TICKINT_Msk | SysTick_CTRL_ENABLE_Msk);
+
+    __enable_irq();
+
+    return STANDBY_ERROR;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Прочитать время RTC
+ *
+ * @param[out]      tr: RTC_TR
+ * @param[out]      ssr: RTC_SSR
+ *
+ * @note            Счетчики читаются напрямую (BYPSHAD), значения
+ *                  согласованы, если RTC_SSR не изменился
+ */
+static void standby_read_time(uint32_t *tr, uint32_t *ssr)
+{
+    do {
+        *ssr = READ_REG(RTC->SSR);
+        *tr = READ_REG(RTC->TR);
+    } while (*ssr != READ_REG(RTC->SSR));
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Получить время от пробуждения
+ *
+ * @param[in]       tr: RTC_TR
+ * @param[in]       ssr: RTC_SSR
+ * @return          Время (такты RTC_SSR)
+ *
+ * @note            Пробуждение совпадает с началом секунды wake_seconds,
+ *                  RTC_SSR считает вниз от STANDBY_RTC_PREDIV_S
+ */
+static uint32_t standby_get_ticks(uint32_t tr, uint32_t ssr)
+{
+    uint32_t seconds = (standby_tr_to_seconds(tr) + STANDBY_SECONDS_PER_DAY - wake_seconds) % STANDBY_SECONDS_PER_DAY;
+
+    return (seconds << STANDBY_RTC_TICK_SHIFT) + (STANDBY_RTC_PREDIV_S - (ssr & STANDBY_RTC_PREDIV_S));
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Перевести такты RTC_SSR в мкс
+ *
+ * @param[in]       ticks: Время (такты RTC_SSR)
+ * @return          Время (мкс), не более UINT32_MAX
+ */
+static uint32_t standby_ticks_to_us(uint32_t ticks)
+{
+    uint64_t us = (uint64_t) ticks * 1000000 >> STANDBY_RTC_TICK_SHIFT;
+
+    return us < UINT32_MAX ? (uint32_t) us : UINT32_MAX;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Перевести время RTC_TR (BCD, 24 ч) в секунды суток
+ *
+ * @param[in]       tr: RTC_TR
+ * @return          Секунда суток
+ */
+static uint32_t standby_tr_to_seconds(uint32_t tr)
+{
+    uint32_t hours = ((tr & RTC_TR_HT_Msk) >> RTC_TR_HT_Pos) * 10 + ((tr & RTC_TR_HU_Msk) >> RTC_TR_HU_Pos);
+    uint32_t minutes = ((tr & RTC_TR_MNT_Msk) >> RTC_TR_MNT_Pos) * 10 + ((tr & RTC_TR_MNU_Msk) >> RTC_TR_MNU_Pos);
+    uint32_t seconds = ((tr & RTC_TR_ST_Msk) >> RTC_TR_ST_Pos) * 10 + ((tr & RTC_TR_SU_Msk) >> RTC_TR_SU_Pos);
+
+    return (hours * 60 + minutes) * 60 + seconds;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Настроить тактирование и делители RTC
+ *
+ * @return          Статус:
+ *                      - STANDBY_ERROR
+ *                      - STANDBY_OK
+ *
+ * @note            Источник RTC выбирается один раз до сброса домена
+ *                  резервного питания. Делители записываются в режиме
+ *                  инициализации только при первой настройке, календарь
+ *                  продолжает счет. Защита от записи RTC выключена
+ */
+static int32_t standby_setup_rtc(void)
+{
+    struct dwt_deadline deadline;
+    uint32_t rtcsel = READ_BIT(RCC->BDCR, RCC_BDCR_RTCSEL_Msk) >> RCC_BDCR_RTCSEL_Pos;
+    uint32_t prer = STANDBY_RTC_PREDIV_A << RTC_PRER_PREDIV_A_Pos | STANDBY_RTC_PREDIV_S << RTC_PRER_PREDIV_S_Pos;
+
+    if (rtcsel != 0 && rtcsel != STANDBY_RTCSEL_LSE)
+        return STANDBY_ERROR;
+
+    /* LSE запущен rcc_init() */
+    dwt_deadline_start(&deadline, STANDBY_LSE_TIMEOUT);
+
+    while (!READ_BIT(RCC->BDCR, RCC_BDCR_LSERDY_Msk)) {
+        if (dwt_deadline_expired(&deadline))
+            return STANDBY_ERROR;
+    }
+
+    MODIFY_REG(RCC->BDCR, RCC_BDCR_RTCSEL_Msk, STANDBY_RTCSEL_LSE << RCC_BDCR_RTCSEL_Pos);
+    SET_BIT(RCC->BDCR, RCC_BDCR_RTCEN_Msk);
+
+    if (READ_REG(RTC->PRER) == prer && READ_BIT(RTC->CR, RTC_CR_BYPSHAD_Msk))
+        return STANDBY_OK;
+
+    /* Войти в режим инициализации */
+    SET_BIT(RTC->ICSR, RTC_ICSR_INIT_Msk);
+
+    dwt_deadline_start(&deadline, STANDBY_RTC_TIMEOUT);
+
+    while (!READ_BIT(RTC->ICSR, RTC_ICSR_INITF_Msk)) {
+        if (dwt_deadline_expired(&deadline)) {
+            CLEAR_BIT(RTC->ICSR, RTC_ICSR_INIT_Msk);
+            return STANDBY_ERROR;
+        }
+    }
+
+    /* Делители записываются двумя обращениями: PREDIV_S, затем PREDIV_A */
+    WRITE_REG(RTC->PRER, STANDBY_RTC_PREDIV_S << RTC_PRER_PREDIV_S_Pos);
+    WRITE_REG(RTC->PRER, prer);
+
+    /* Читать счетчики напрямую: Boot читает время без ожидания RSF */
+    SET_BIT(RTC->CR, RTC_CR_BYPSHAD_Msk);
+
+    CLEAR_BIT(RTC->ICSR, RTC_ICSR_INIT_Msk);
+
+    return STANDBY_OK;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Запустить таймер пробуждения RTC
+ *
+ * @param[in]       period: Период пробуждения (с)
+ * @return          Статус:
+ *                      - STANDBY_ERROR
+ *                      - STANDBY_OK
+ *
+ * @note            Защита от записи RTC выключена
+ */
+static int32_t standby_setup_wakeup(uint32_t period)
+{
+    struct dwt_deadline deadline;
+
+    CLEAR_BIT(RTC->CR, RTC_CR_WUTE_Msk | RTC_CR_WUTIE_Msk);
+
+    dwt_deadline_start(&deadline, STANDBY_RTC_TIMEOUT);
+
+    while (!READ_BIT(RTC->ICSR, RTC_ICSR_WUTWF_Msk)) {
+        if (dwt_deadline_expired(&deadline))
+            return STANDBY_ERROR;
+    }
+
+    WRITE_REG(RTC->WUTR, (period - 1) << RTC_WUTR_WUT_Pos);
+    MODIFY_REG(RTC->CR, RTC_CR_WUCKSEL_Msk, STANDBY_WUCKSEL_CK_SPRE << RTC_CR_WUCKSEL_Pos);
+
+    /* Сбросить флаг предыдущего пробуждения (иначе Standby завершается сразу) */
+    WRITE_REG(RTC->SCR, RTC_SCR_CWUTF_Msk);
+
+    SET_BIT(RTC->CR, RTC_CR_WUTE_Msk | RTC_CR_WUTIE_Msk);
+
+    return STANDBY_OK;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Остановить таймер пробуждения RTC
+ */
+static void standby_stop_wakeup(void)
+{
+    if (!READ_BIT(RTC->CR, RTC_CR_WUTE_Msk) && !READ_BIT(RTC->SR, RTC_SR_WUTF_Msk))
+        return;
+
+    WRITE_REG(RTC->WPR, STANDBY_RTC_KEY1);
+    WRITE_REG(RTC->WPR, STANDBY_RTC_KEY2);
+
+    CLEAR_BIT(RTC->CR, RTC_CR_WUTE_Msk | RTC_CR_WUTIE_Msk);
+    WRITE_REG(RTC->SCR, RTC_SCR_CWUTF_Msk);
+
+    WRITE_REG(RTC->WPR, STANDBY_RTC_LOCK);
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Включить Backup регулятор
+ *
+ * @return          Статус:
+ *                      - STANDBY_ERROR
+ *                      - STANDBY_OK
+ *
+ * @note            Без Backup регулятора SRAM_BKP не сохраняется в Standby
+ */
+static int32_t standby_setup_backup_regulator(void)
+{
+    struct dwt_deadline deadline;
+
+    SET_BIT(PWR->CSR1, PWR_CSR1_BREN_Msk);
+
+    dwt_deadline_start(&deadline, STANDBY_BREN_TIMEOUT);
+
+    while (!READ_BIT(PWR->CSR1, PWR_CSR1_BRRDY_Msk)) {
+        if (dwt_deadline_expired(&deadline))
+            return STANDBY_ERROR;
+    }
+
+    return STANDBY_OK;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Сохранить состояние перед переходом в Standby
+ *
+ * @param[in]       period: Период пробуждения (с)
+ * @param[in]       context: Данные App
+ */
+static void standby_save(uint32_t period, uint32_t context)
+{
+    /* Заголовок известен только при корректном блоке передачи Boot: SHA-256
+     * подписанных полей заголовка Boot рассчитал при проверке подписи */
+    const struct image_header *header = image_get_header();
+    const struct handoff *handoff = handoff_get();
+
+    /* Сбросить признак (записывается последним) */
+    state->magic = 0;
+
+    state->header_address = header != NULL ? (uint32_t) header : 0;
+    state->image_version = header != NULL ? header->image_version : 0;
+
+    for (uint32_t i = 0; i < IMAGE_DIGEST_SIZE; i++)
+        state->header_digest[i] = header != NULL ? handoff->header_digest[i] : 0;
+
+    state->period = period;
+    state->wakes = report.resumed ? report.wakes + 1 : 1;
+    state->context = context;
+
+    state->wake = false;
+    state->wake_tr = 0;
+    state->wake_ssr = 0;
+    state->fast_resume = false;
+
+    state->checksum = standby_checksum(state);
+    state->magic = STANDBY_STATE_MAGIC;
+
+    __DSB();
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Проверить состояние в SRAM_BKP
+ *
+ * @return          Признак корректного состояния
+ */
+static bool standby_is_valid(void)
+{
+    return state->magic == STANDBY_STATE_MAGIC
+        && state->checksum == standby_checksum(state);
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Вычислить контрольную сумму состояния
+ *
+ * @param[in]       block: Указатель на состояние
+ * @return          Контрольная сумма
+ */
+static uint32_t standby_checksum(const struct standby_state *block)
+{
+    const uint32_t *word = (const uint32_t *) block;
+    uint32_t checksum = 0;
+
+    /* Все слова после magic до checksum */
+    for (uint32_t i = 1; i < offsetof(struct standby_state, checksum) / 4; i++)
+        checksum = (checksum << 5 | checksum >> 27) ^ word[i];
+
+    return checksum;
+}
+/* ------------------------------------------------------------------------- */
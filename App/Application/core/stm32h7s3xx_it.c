@@ -19,6 +19,8 @@
 
 #include "stm32h7s3xx_it.h"
 #include "systick.h"
+#include "crash.h"
+#include "idle.h"
 
 /* Private macros ---------------------------------------------------------- */
 
@@ -32,33 +34,33 @@
 
 /* Private user code ------------------------------------------------------- */
 
-void NMI_Handler(void)
+__ITCM __attribute__((naked)) void NMI_Handler(void)
 {
-    error();
+    CRASH_FAULT_ENTRY();
 }
 /* ------------------------------------------------------------------------- */
 
-void HardFault_Handler(void)
+__ITCM __attribute__((naked)) void HardFault_Handler(void)
 {
-    error();
+    CRASH_FAULT_ENTRY();
 }
 /* ------------------------------------------------------------------------- */
 
-void MemManage_Handler(void)
+__ITCM __attribute__((naked)) void MemManage_Handler(void)
 {
-    error();
+    CRASH_FAULT_ENTRY();
 }
 /* ------------------------------------------------------------------------- */
 
-void BusFault_Handler(void)
+__ITCM __attribute__((naked)) void BusFault_Handler(void)
 {
-    error();
+    CRASH_FAULT_ENTRY();
 }
 /* ------------------------------------------------------------------------- */
 
-void UsageFault_Handler(void)
+__ITCM __attribute__((naked)) void UsageFault_Handler(void)
 {
-    error();
+    CRASH_FAULT_ENTRY();
 }
 /* ------------------------------------------------------------------------- */
 
@@ -68,11 +70,8 @@ void SysTick_Handler(void)
 }
 /* ------------------------------------------------------------------------- */
 
-void systick_period_elapsed_callback(void)
+void LPTIM1_IRQHandler(void)
 {
-    /* Обработать системный таймер FreeRTOS */
-    if (xTaskGetSchedulerState() != taskSCHEDULER_NOT_STARTED) {
-        xPortSysTickHandler();
-    }
+    idle_it_handler();
 }
 /* ------------------------------------------------------------------------- */
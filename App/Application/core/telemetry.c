@@ -0,0 +1,121 @@
+/**
+ * Copyright (C) 2025 zhmaksim <zhiharev.maxim.alexandrovich@yandex.ru>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/* Includes ---------------------------------------------------------------- */
+
+#include "telemetry.h"
+
+/* Private macros ---------------------------------------------------------- */
+
+/* Private constants ------------------------------------------------------- */
+
+/* Private types ----------------------------------------------------------- */
+
+/* Private variables ------------------------------------------------------- */
+
+static const struct telemetry *const telemetry = (struct telemetry *) TELEMETRY_ADDRESS;
+
+static struct telemetry_report report;
+
+/* Private function prototypes --------------------------------------------- */
+
+static bool telemetry_is_valid(void);
+
+static uint32_t telemetry_checksum(void);
+
+/* Private user code ------------------------------------------------------- */
+
+/**
+ * @brief           Прочитать запись телеметрии загрузки, сформированную Boot
+ */
+void telemetry_init(void)
+{
+    /* Включить тактирование BKPSRAM */
+    SET_BIT(RCC->AHB4ENR, RCC_AHB4ENR_BKPRAMEN_Msk);
+
+    report.valid = telemetry_is_valid();
+    report.total_us = 0;
+
+    if (!report.valid)
+        return;
+
+    /* Перевести такты каждого этапа в мкс на частоте этого этапа */
+    uint32_t cycles = 0;
+
+    for (uint32_t i = 0; i < TELEMETRY_STAGE_COUNT; i++) {
+        uint32_t cycles_per_us = telemetry->stamp[i].frequency / 1000000;
+
+        /* Этап не выполнялся (пробуждение из Standby: без проверки подписи) */
+        if (cycles_per_us == 0) {
+            report.stage_us[i] = 0;
+            continue;
+        }
+
+        report.stage_us[i] = (telemetry->stamp[i].cycles - cycles) / cycles_per_us;
+        report.total_us += report.stage_us[i];
+        cycles = telemetry->stamp[i].cycles;
+    }
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Получить отчет о загрузке
+ *
+ * @return          Указатель на отчет
+ */
+const struct telemetry_report *telemetry_get_report(void)
+{
+    return &report;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Проверить запись телеметрии загрузки
+ *
+ * @return          Признак корректной записи
+ */
+static bool telemetry_is_valid(void)
+{
+    if (telemetry->magic != TELEMETRY_MAGIC) {
+        return false;
+    } else if (telemetry->version != TELEMETRY_VERSION) {
+        return false;
+    } else if (telemetry->size != sizeof(struct telemetry)) {
+        return false;
+    } else {
+        return telemetry->checksum == telemetry_checksum();
+    }
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Вычислить контрольную сумму записи
+ *
+ * @return          Контрольная сумма
+ */
+static uint32_t telemetry_checksum(void)
+{
+    uint32_t checksum = telemetry->version ^ telemetry->size;
+
+    for (uint32_t i = 0; i < TELEMETRY_STAGE_COUNT; i++) {
+        checksum = (checksum << 5 | checksum >> 27) ^ telemetry->stamp[i].cycles;
+        checksum = (checksum << 5 | checksum >> 27) ^ telemetry->stamp[i].frequency;
+    }
+
+    return checksum;
+}
+/* ------------------------------------------------------------------------- */
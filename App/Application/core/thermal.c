@@ -0,0 +1,147 @@
+/**
+ * Copyright (C) 2025 zhmaksim <zhiharev.maxim.alexandrovich@yandex.ru>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/* Includes ---------------------------------------------------------------- */
+
+#include "thermal.h"
+#include "dts.h"
+#include "rcc.h"
+
+/* Private macros ---------------------------------------------------------- */
+
+/* Private constants ------------------------------------------------------- */
+
+/* Private types ----------------------------------------------------------- */
+
+/**
+ * @brief           Определение структуры данных уровня ограничения
+ */
+struct thermal_level {
+    uint32_t profile;                           /*!< Профиль тактирования @ref enum rcc_profile */
+
+    int32_t limit;                              /*!< Температура перехода на следующий уровень (0.1 °C) */
+};
+
+/* Private variables ------------------------------------------------------- */
+
+static const struct thermal_level thermal_level[THERMAL_STATE_COUNT] = {
+    [THERMAL_STATE_NORMAL]          = { RCC_PROFILE_600MHZ, 950 },
+    [THERMAL_STATE_THROTTLE]        = { RCC_PROFILE_300MHZ, 1050 },
+    [THERMAL_STATE_THROTTLE_HIGH]   = { RCC_PROFILE_150MHZ, 1150 },
+    [THERMAL_STATE_CRITICAL]        = { RCC_PROFILE_64MHZ,  INT32_MAX },
+};
+
+static struct thermal_report report;
+
+static uint32_t timestamp;                      /* Время последнего учета (тик) */
+
+static uint32_t entered;                        /* Время перехода в текущее состояние (тик) */
+
+/* Private function prototypes --------------------------------------------- */
+
+static void thermal_set_state(uint32_t state, uint32_t now);
+
+/* Private user code ------------------------------------------------------- */
+
+/**
+ * @brief           Инициализировать регулятор температуры
+ */
+void thermal_init(void)
+{
+    dts_init();
+
+    timestamp = xTaskGetTickCount();
+    entered = timestamp;
+
+    report.state = THERMAL_STATE_NORMAL;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Выполнить шаг регулятора температуры
+ *
+ * @note            Вызывается периодически из задачи FreeRTOS. Частота
+ *                  понижается на один уровень при достижении порога уровня,
+ *                  повышается на один уровень при снижении температуры
+ *                  ниже порога предыдущего уровня на THERMAL_HYSTERESIS
+ *                  и пребывании на уровне не менее THERMAL_RESTORE_DELAY
+ */
+void thermal_process(void)
+{
+    uint32_t now = xTaskGetTickCount();
+    int32_t temperature;
+
+    report.time[report.state] += pdTICKS_TO_MS(now - timestamp);
+    timestamp = now;
+
+    int32_t status = dts_process(&temperature);
+
+    if (status == DTS_BUSY)
+        return;
+
+    if (status != DTS_OK) {
+        report.errors++;
+        return;
+    }
+
+    if (!report.valid || temperature > report.temperature_max)
+        report.temperature_max = temperature;
+
+    report.temperature = temperature;
+    report.valid = true;
+
+    uint32_t state = report.state;
+
+    if (temperature >= thermal_level[state].limit) {
+        thermal_set_state(state + 1, now);
+    } else if (state > THERMAL_STATE_NORMAL
+            && temperature < thermal_level[state - 1].limit - THERMAL_HYSTERESIS
+            && pdTICKS_TO_MS(now - entered) >= THERMAL_RESTORE_DELAY) {
+        thermal_set_state(state - 1, now);
+    }
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Получить состояние регулятора температуры
+ *
+ * @return          Указатель на состояние
+ */
+const struct thermal_report *thermal_get_report(void)
+{
+    return &report;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Перейти в состояние ограничения
+ *
+ * @param[in]       state: Состояние @ref enum thermal_state
+ * @param[in]       now: Текущее время (тик)
+ */
+static void thermal_set_state(uint32_t state, uint32_t now)
+{
+    if (rcc_set_profile(thermal_level[state].profile) != RCC_OK) {
+        report.errors++;
+        return;
+    }
+
+    report.state = state;
+    report.transitions++;
+    entered = now;
+}
+/* ------------------------------------------------------------------------- */
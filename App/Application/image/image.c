@@ -0,0 +1,89 @@
+/**
+ * Copyright (C) 2025 zhmaksim <zhiharev.maxim.alexandrovich@yandex.ru>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/* Includes ---------------------------------------------------------------- */
+
+#include "image.h"
+#include "handoff.h"
+
+/* Private macros ---------------------------------------------------------- */
+
+/* Private constants ------------------------------------------------------- */
+
+/* Private types ----------------------------------------------------------- */
+
+/* Private variables ------------------------------------------------------- */
+
+static const uint32_t image_slot[IMAGE_SLOT_COUNT] = {
+    IMAGE_SLOT_A_ADDRESS,
+    IMAGE_SLOT_B_ADDRESS,
+};
+
+static struct image_state *const state = (struct image_state *) IMAGE_STATE_ADDRESS;
+
+/* Private function prototypes --------------------------------------------- */
+
+/* Private user code ------------------------------------------------------- */
+
+/**
+ * @brief           Подтвердить успешный запуск образа
+ *
+ * @note            Сбрасывает счетчик попыток запуска, после чего Boot
+ *                  продолжит выбирать текущий слот
+ */
+void image_confirm(void)
+{
+    /* Выключить защиту от записи Backup домена */
+    SET_BIT(PWR->CR1, PWR_CR1_DBP_Msk);
+
+    /* Включить тактирование BKPSRAM */
+    SET_BIT(RCC->AHB4ENR, RCC_AHB4ENR_BKPRAMEN_Msk);
+
+    if (state->magic == IMAGE_STATE_MAGIC)
+        state->attempts = 0;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Получить состояние запуска образа
+ *
+ * @return          Указатель на состояние
+ */
+const struct image_state *image_get_state(void)
+{
+    return state;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Получить заголовок запущенного образа
+ *
+ * @return          Указатель на заголовок в слоте (NULL - состояние не записано
+ *                  Boot или внешняя FLASH не в Memory Mapped Mode)
+ */
+const struct image_header *image_get_header(void)
+{
+    const struct handoff *handoff = handoff_get();
+
+    if (handoff == NULL || handoff->flash_mode != HANDOFF_FLASH_MEMORY_MAPPED)
+        return NULL;
+    else if (state->magic != IMAGE_STATE_MAGIC || state->slot >= IMAGE_SLOT_COUNT)
+        return NULL;
+
+    return (const struct image_header *) image_slot[state->slot];
+}
+/* ------------------------------------------------------------------------- */
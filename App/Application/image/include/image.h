@@ -0,0 +1,118 @@
+/**
+ * Copyright (C) 2025 zhmaksim <zhiharev.maxim.alexandrovich@yandex.ru>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef IMAGE_H_
+#define IMAGE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/* Includes ---------------------------------------------------------------- */
+
+#include "main.h"
+
+/* Exported macros --------------------------------------------------------- */
+
+/* Exported constants ------------------------------------------------------ */
+
+#define IMAGE_SLOT_COUNT                2
+#define IMAGE_SLOT_SIZE                 0x00800000
+#define IMAGE_SLOT_A_ADDRESS            0x70000000
+#define IMAGE_SLOT_B_ADDRESS            (IMAGE_SLOT_A_ADDRESS + IMAGE_SLOT_SIZE)
+
+#define IMAGE_HEADER_SIZE               0x400           /* Таблица векторов App выравнивается на 1KB */
+#define IMAGE_HEADER_MAGIC              0x474D4941      /* "AIMG" */
+#define IMAGE_HEADER_VERSION            3
+#define IMAGE_DIGEST_SIZE               32              /* SHA-256 */
+#define IMAGE_SIGNATURE_SIZE            64              /* ECDSA P-256: r || s */
+
+#define IMAGE_FLAG_LZ4                  0x01            /* Образ сжат LZ4 и загружается в ITCM/SRAM */
+
+#define IMAGE_STATE_ADDRESS             (BKPSRAM_BASE + 0x100)
+#define IMAGE_STATE_MAGIC               0x54534941      /* "AIST" */
+
+#define IMAGE_BOOT_ATTEMPTS             3               /* Запусков без подтверждения до перехода на другой слот */
+
+#define IMAGE_OK                        0
+#define IMAGE_ERROR                    -1
+
+/* Exported types ---------------------------------------------------------- */
+
+/**
+ * @brief           Определение структуры данных заголовка образа App
+ *
+ * @note            Заголовок располагается в начале слота, образ - по смещению
+ *                  header_size. Образ XIP начинается с таблицы векторов, сжатый
+ *                  образ (IMAGE_FLAG_LZ4) распаковывается по адресу vector_address.
+ *                  Формируется Tools/image_tool.py, формат должен совпадать в Boot и App
+ */
+struct image_header {
+    uint32_t magic;                             /*!< Признак заголовка IMAGE_HEADER_MAGIC */
+
+    uint16_t version;                           /*!< Версия формата заголовка */
+
+    uint16_t header_size;                       /*!< Размер заголовка (байт) */
+
+    uint32_t image_version;                     /*!< Версия образа (выбирается наибольшая) */
+
+    uint32_t image_size;                        /*!< Размер образа в слоте (байт) */
+
+    uint32_t vector_address;                    /*!< Адрес таблицы векторов (адрес компоновки) */
+
+    uint32_t flags;                             /*!< Флаги IMAGE_FLAG_x */
+
+    uint32_t load_size;                         /*!< Размер образа после распаковки (байт) */
+
+    uint8_t digest[IMAGE_DIGEST_SIZE];          /*!< SHA-256 образа в слоте */
+
+    uint8_t signature[IMAGE_SIGNATURE_SIZE];    /*!< Подпись ECDSA P-256 полей magic...digest (big-endian) */
+};
+
+
+/**
+ * @brief           Определение структуры данных состояния запуска образа
+ *
+ * @note            Размещается в SRAM_BKP, формат должен совпадать в Boot и App
+ */
+struct image_state {
+    uint32_t magic;                             /*!< Признак состояния IMAGE_STATE_MAGIC */
+
+    uint32_t slot;                              /*!< Номер запущенного слота */
+
+    uint32_t image_version;                     /*!< Версия запущенного образа */
+
+    uint32_t attempts;                          /*!< Количество запусков без подтверждения App */
+};
+
+/* Exported variables ------------------------------------------------------ */
+
+/* Exported function prototypes -------------------------------------------- */
+
+void image_confirm(void);
+
+const struct image_state *image_get_state(void);
+
+const struct image_header *image_get_header(void);
+
+/* Exported callback function prototypes ----------------------------------- */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* IMAGE_H_ */
@@ -0,0 +1,115 @@
+/**
+ * Copyright (C) 2025 zhmaksim <zhiharev.maxim.alexandrovich@yandex.ru>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef TIMEOUT_H_
+#define TIMEOUT_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/* Includes ---------------------------------------------------------------- */
+
+#include "main.h"
+
+/* Exported macros --------------------------------------------------------- */
+
+/* Exported constants ------------------------------------------------------ */
+
+#define TIMEOUT_TASK_PRIORITY           (tskIDLE_PRIORITY + 3)          /* Приоритет службы таймаутов */
+#define TIMEOUT_TASK_STACK_SIZE         (configMINIMAL_STACK_SIZE * 2)  /* Стек службы (обратные вызовы) */
+
+#define TIMEOUT_MAX_DELAY               ((1UL << 26) - 1)       /* Максимальная задержка (тиков), ~18.6 ч */
+
+#define TIMEOUT_OK                       0
+#define TIMEOUT_ERROR                   -1
+
+/* Exported types ---------------------------------------------------------- */
+
+/**
+ * @brief           Определение структуры данных связи списка ячейки колеса
+ */
+struct timeout_link {
+    struct timeout_link *next;                  /*!< Следующий элемент (NULL - таймаут не запущен) */
+
+    struct timeout_link *prev;                  /*!< Предыдущий элемент */
+};
+
+
+/**
+ * @brief           Определение структуры данных таймаута
+ *
+ * @note            Память таймаута принадлежит вызывающему (например,
+ *                  структура соединения или запроса), служба не выделяет
+ *                  память. Запущенный таймаут нельзя освобождать без
+ *                  timeout_stop()
+ */
+struct timeout {
+    struct timeout_link link;                   /*!< Связь в ячейке колеса (первое поле) */
+
+    uint32_t expires;                           /*!< Тик срабатывания */
+
+    void (*callback)(void *argument);           /*!< Функция обратного вызова */
+
+    void *argument;                             /*!< Аргумент функции обратного вызова */
+};
+
+
+/**
+ * @brief           Определение структуры данных статистики службы таймаутов
+ */
+struct timeout_stats {
+    uint32_t active;                            /*!< Запущенные таймауты */
+
+    uint32_t active_max;                        /*!< Максимум одновременно запущенных таймаутов */
+
+    uint32_t started;                           /*!< Количество запусков */
+
+    uint32_t expired;                           /*!< Количество срабатываний */
+
+    uint32_t cascaded;                          /*!< Переносы таймаутов с верхних уровней колеса */
+
+    uint32_t batches;                           /*!< Пакеты обратных вызовов */
+
+    uint32_t batch_max;                         /*!< Максимальный размер пакета */
+};
+
+/* Exported variables ------------------------------------------------------ */
+
+/* Exported function prototypes -------------------------------------------- */
+
+void timeout_init(void);
+
+void timeout_setup(struct timeout *timeout, void (*callback)(void *argument), void *argument);
+
+int32_t timeout_start(struct timeout *timeout, uint32_t delay);
+
+void timeout_stop(struct timeout *timeout);
+
+bool timeout_is_active(const struct timeout *timeout);
+
+uint32_t timeout_process(void);
+
+const struct timeout_stats *timeout_get_stats(void);
+
+/* Exported callback function prototypes ----------------------------------- */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* TIMEOUT_H_ */
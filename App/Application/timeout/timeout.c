@@ -0,0 +1,511 @@
+/**
+ * Copyright (C) 2025 zhmaksim <zhiharev.maxim.alexandrovich@yandex.ru>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/* Includes ---------------------------------------------------------------- */
+
+#include "timeout.h"
+
+/* Private macros ---------------------------------------------------------- */
+
+/* Private constants ------------------------------------------------------- */
+
+/* Нижний уровень колеса: ячейка на каждый тик */
+#define TIMEOUT_ROOT_BITS               8
+#define TIMEOUT_ROOT_SIZE               (1UL << TIMEOUT_ROOT_BITS)
+#define TIMEOUT_ROOT_MASK               (TIMEOUT_ROOT_SIZE - 1)
+
+/* Верхние уровни колеса: ячейка на оборот предыдущего уровня */
+#define TIMEOUT_LEVELS                  3
+#define TIMEOUT_LEVEL_BITS              6
+#define TIMEOUT_LEVEL_SIZE              (1UL << TIMEOUT_LEVEL_BITS)
+#define TIMEOUT_LEVEL_MASK              (TIMEOUT_LEVEL_SIZE - 1)
+
+/* Диапазон колеса (тиков) */
+#define TIMEOUT_SPAN                    (1UL << (TIMEOUT_ROOT_BITS + TIMEOUT_LEVELS * TIMEOUT_LEVEL_BITS))
+
+_Static_assert(TIMEOUT_MAX_DELAY == TIMEOUT_SPAN - 1, "TIMEOUT: max delay does not match the wheel span");
+
+/* Private types ----------------------------------------------------------- */
+
+/* Private variables ------------------------------------------------------- */
+
+static struct timeout_link root[TIMEOUT_ROOT_SIZE];
+static struct timeout_link level[TIMEOUT_LEVELS][TIMEOUT_LEVEL_SIZE];
+
+/* Непустые ячейки нижнего уровня (бит может остаться после timeout_stop(), сбрасывается при поиске) */
+static uint32_t root_map[TIMEOUT_ROOT_SIZE / 32];
+
+static struct timeout_link expired;             /* Пакет сработавших таймаутов */
+
+static uint32_t wheel_time;                     /* Следующий обрабатываемый тик */
+static uint32_t wake_time;                      /* Тик пробуждения службы */
+
+static TaskHandle_t task;
+
+static struct timeout_stats stats;
+
+/* Private function prototypes --------------------------------------------- */
+
+static void timeout_task(void *argv);
+
+static void timeout_list_init(struct timeout_link *list);
+
+static void timeout_unlink(struct timeout_link *link);
+
+static void timeout_insert(struct timeout *timeout);
+
+static void timeout_cascade(struct timeout_link *list);
+
+static void timeout_run(void);
+
+static uint32_t timeout_next(void);
+
+/* Private user code ------------------------------------------------------- */
+
+/**
+ * @brief           Инициализировать службу таймаутов
+ *
+ * @note            Иерархическое колесо: нижний уровень - 256 ячеек по
+ *                  одному тику, три верхних уровня - по 64 ячейки на оборот
+ *                  предыдущего уровня. Запуск и остановка - вставка и
+ *                  удаление из двусвязного списка ячейки O(1), срабатывание
+ *                  - перенос списка ячейки в пакет O(1), каждый таймаут
+ *                  переносится с верхнего уровня не более трех раз.
+ *                  Обратные вызовы выполняет задача службы
+ */
+void timeout_init(void)
+{
+    for (uint32_t i = 0; i < TIMEOUT_ROOT_SIZE; i++) {
+        timeout_list_init(&root[i]);
+    }
+
+    for (uint32_t n = 0; n < TIMEOUT_LEVELS; n++) {
+        for (uint32_t i = 0; i < TIMEOUT_LEVEL_SIZE; i++) {
+            timeout_list_init(&level[n][i]);
+        }
+    }
+
+    timeout_list_init(&expired);
+
+    wheel_time = xTaskGetTickCount();
+    wake_time = wheel_time + TIMEOUT_MAX_DELAY;
+
+    xTaskCreate(timeout_task,
+                "timeout",
+                TIMEOUT_TASK_STACK_SIZE,
+                NULL,
+                TIMEOUT_TASK_PRIORITY,
+                &task);
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Настроить таймаут
+ *
+ * @param[out]      timeout: Указатель на таймаут
+ * @param[in]       callback: Функция обратного вызова (выполняется задачей службы)
+ * @param[in]       argument: Аргумент функции обратного вызова
+ */
+void timeout_setup(struct timeout *timeout, void (*callback)(void *argument), void *argument)
+{
+    timeout->link.next = NULL;
+    timeout->link.prev = NULL;
+    timeout->expires = 0;
+    timeout->callback = callback;
+    timeout->argument = argument;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Запустить или перезапустить таймаут
+ *
+ * @param[in,out]   timeout: Указатель на таймаут
+ * @param[in]       delay: Задержка (тиков), 1...TIMEOUT_MAX_DELAY
+ *
+ * @return          Статус @ref TIMEOUT_OK, @ref TIMEOUT_ERROR - недопустимая задержка
+ *
+ * @note            Вызывается из задач (не из прерываний). Задача службы
+ *                  пробуждается, только если таймаут сработает раньше
+ *                  запланированного пробуждения
+ */
+int32_t timeout_start(struct timeout *timeout, uint32_t delay)
+{
+    if (delay == 0 || delay > TIMEOUT_MAX_DELAY)
+        return TIMEOUT_ERROR;
+
+    bool notify;
+
+    taskENTER_CRITICAL();
+
+    uint32_t now = xTaskGetTickCount();
+
+    if (timeout->link.next != NULL) {
+        timeout_unlink(&timeout->link);
+    } else {
+        /* Пустое колесо не обрабатывается - продолжить с текущего тика */
+        if (stats.active == 0)
+            wheel_time = now;
+
+        if (++stats.active > stats.active_max)
+            stats.active_max = stats.active;
+    }
+
+    timeout->expires = now + delay;
+    timeout_insert(timeout);
+
+    stats.started++;
+    notify = timeout->expires - wheel_time < wake_time - wheel_time;
+
+    taskEXIT_CRITICAL();
+
+    if (notify && task != NULL)
+        xTaskNotifyGive(task);
+
+    return TIMEOUT_OK;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Остановить таймаут
+ *
+ * @param[in,out]   timeout: Указатель на таймаут
+ *
+ * @note            Таймаут, попавший в пакет, но еще не обработанный,
+ *                  также снимается - обратный вызов не выполняется
+ */
+void timeout_stop(struct timeout *timeout)
+{
+    taskENTER_CRITICAL();
+
+    if (timeout->link.next != NULL) {
+        timeout_unlink(&timeout->link);
+        timeout->link.next = NULL;
+        stats.active--;
+    }
+
+    taskEXIT_CRITICAL();
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Проверить запуск таймаута
+ *
+ * @param[in]       timeout: Указатель на таймаут
+ *
+ * @return          true - таймаут запущен и не сработал
+ */
+bool timeout_is_active(const struct timeout *timeout)
+{
+    return timeout->link.next != NULL;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Обработать сработавшие таймауты
+ *
+ * @return          Время до следующей обработки (тиков), portMAX_DELAY - нет таймаутов
+ *
+ * @note            Вызывается задачей службы. Колесо продвигается до
+ *                  текущего тика сразу к непустым ячейкам, сработавшие
+ *                  таймауты собираются в пакет и обратные вызовы
+ *                  выполняются одним проходом вне критической секции
+ */
+uint32_t timeout_process(void)
+{
+    uint32_t batch = 0;
+
+    /* Собрать пакет: критическая секция ограничена одной ячейкой */
+    while (true) {
+        bool pending = false;
+
+        taskENTER_CRITICAL();
+
+        uint32_t now = xTaskGetTickCount();
+
+        if ((int32_t) (now - wheel_time) >= 0) {
+            uint32_t next = stats.active != 0 ? timeout_next() : TIMEOUT_SPAN;
+
+            if (next > now - wheel_time) {
+                /* Ячейки до текущего тика пусты */
+                wheel_time = now + 1;
+            } else {
+                wheel_time += next;
+                timeout_run();
+                pending = true;
+            }
+        }
+
+        taskEXIT_CRITICAL();
+
+        if (!pending)
+            break;
+    }
+
+    /* Выполнить обратные вызовы пакета */
+    while (true) {
+        taskENTER_CRITICAL();
+
+        struct timeout_link *link = expired.next;
+
+        if (link == &expired) {
+            taskEXIT_CRITICAL();
+            break;
+        }
+
+        struct timeout *timeout = (struct timeout *) link;
+        void (*callback)(void *argument) = timeout->callback;
+        void *argument = timeout->argument;
+
+        timeout_unlink(link);
+        link->next = NULL;
+
+        stats.active--;
+        stats.expired++;
+
+        taskEXIT_CRITICAL();
+
+        callback(argument);
+        batch++;
+    }
+
+    if (batch != 0) {
+        stats.batches++;
+
+        if (batch > stats.batch_max)
+            stats.batch_max = batch;
+    }
+
+    /* Запланировать пробуждение к ближайшей непустой ячейке или переносу */
+    uint32_t delay = portMAX_DELAY;
+
+    taskENTER_CRITICAL();
+
+    if (stats.active == 0) {
+        wake_time = wheel_time + TIMEOUT_MAX_DELAY;
+    } else {
+        uint32_t now = xTaskGetTickCount();
+
+        wake_time = wheel_time + timeout_next();
+        delay = (int32_t) (wake_time - now) > 0 ? wake_time - now : 0;
+    }
+
+    taskEXIT_CRITICAL();
+
+    return delay;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Получить статистику службы таймаутов
+ *
+ * @return          Указатель на статистику
+ */
+const struct timeout_stats *timeout_get_stats(void)
+{
+    return &stats;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Задача службы таймаутов
+ *
+ * @note            Блокируется до ближайшего срабатывания или переноса
+ *                  (не пробуждается каждый тик), запуск более раннего
+ *                  таймаута пробуждает задачу уведомлением
+ */
+static void timeout_task(void *argv)
+{
+    while (true) {
+        uint32_t delay = timeout_process();
+
+        ulTaskNotifyTake(pdTRUE, delay);
+    }
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Инициализировать пустой список
+ *
+ * @param[out]      list: Указатель на голову списка
+ */
+static void timeout_list_init(struct timeout_link *list)
+{
+    list->next = list;
+    list->prev = list;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Удалить элемент из списка
+ *
+ * @param[in,out]   link: Указатель на элемент
+ */
+static void timeout_unlink(struct timeout_link *link)
+{
+    link->prev->next = link->next;
+    link->next->prev = link->prev;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Добавить таймаут в ячейку колеса
+ *
+ * @param[in,out]   timeout: Указатель на таймаут
+ *
+ * @note            Уровень выбирается по времени до срабатывания
+ *                  относительно wheel_time, ячейка - по битам тика
+ *                  срабатывания этого уровня. Таймаут дальше диапазона
+ *                  колеса (служба отстала) размещается в последней ячейке
+ *                  диапазона и переносится повторно
+ */
+static void timeout_insert(struct timeout *timeout)
+{
+    uint32_t expires = timeout->expires;
+    uint32_t delta = expires - wheel_time;
+    struct timeout_link *list;
+
+    if ((int32_t) delta < 0) {
+        expires = wheel_time;
+        delta = 0;
+    } else if (delta >= TIMEOUT_SPAN) {
+        expires = wheel_time + TIMEOUT_SPAN - 1;
+        delta = TIMEOUT_SPAN - 1;
+    }
+
+    if (delta < TIMEOUT_ROOT_SIZE) {
+        uint32_t slot = expires & TIMEOUT_ROOT_MASK;
+
+        list = &root[slot];
+        root_map[slot / 32] |= 1UL << (slot % 32);
+    } else {
+        uint32_t n = 0;
+
+        while (delta >= 1UL << (TIMEOUT_ROOT_BITS + (n + 1) * TIMEOUT_LEVEL_BITS)) {
+            n++;
+        }
+
+        list = &level[n][(expires >> (TIMEOUT_ROOT_BITS + n * TIMEOUT_LEVEL_BITS)) & TIMEOUT_LEVEL_MASK];
+    }
+
+    timeout->link.next = list;
+    timeout->link.prev = list->prev;
+    list->prev->next = &timeout->link;
+    list->prev = &timeout->link;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Перенести таймауты ячейки верхнего уровня на нижние уровни
+ *
+ * @param[in,out]   list: Указатель на ячейку
+ */
+static void timeout_cascade(struct timeout_link *list)
+{
+    struct timeout_link pending;
+
+    if (list->next == list)
+        return;
+
+    /* Отделить список ячейки: таймауты не возвращаются в ту же ячейку */
+    pending.next = list->next;
+    pending.prev = list->prev;
+    pending.next->prev = &pending;
+    pending.prev->next = &pending;
+    timeout_list_init(list);
+
+    while (pending.next != &pending) {
+        struct timeout_link *link = pending.next;
+
+        timeout_unlink(link);
+        timeout_insert((struct timeout *) link);
+        stats.cascaded++;
+    }
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Обработать ячейку тика wheel_time
+ *
+ * @note            В начале оборота нижнего уровня переносится ячейка
+ *                  первого верхнего уровня, в начале его оборота -
+ *                  следующего и т.д. Список ячейки добавляется в пакет
+ */
+static void timeout_run(void)
+{
+    uint32_t index = wheel_time & TIMEOUT_ROOT_MASK;
+
+    if (index == 0) {
+        for (uint32_t n = 0; n < TIMEOUT_LEVELS; n++) {
+            uint32_t slot = (wheel_time >> (TIMEOUT_ROOT_BITS + n * TIMEOUT_LEVEL_BITS)) & TIMEOUT_LEVEL_MASK;
+
+            timeout_cascade(&level[n][slot]);
+
+            if (slot != 0)
+                break;
+        }
+    }
+
+    struct timeout_link *list = &root[index];
+
+    if (list->next != list) {
+        list->next->prev = expired.prev;
+        expired.prev->next = list->next;
+        list->prev->next = &expired;
+        expired.prev = list->prev;
+        timeout_list_init(list);
+    }
+
+    root_map[index / 32] &= ~(1UL << (index % 32));
+    wheel_time++;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Найти ближайшую ячейку для обработки
+ *
+ * @return          Тиков от wheel_time до непустой ячейки нижнего уровня
+ *                  или до начала оборота (перенос верхних уровней)
+ */
+static uint32_t timeout_next(void)
+{
+    uint32_t index = wheel_time & TIMEOUT_ROOT_MASK;
+
+    /* Начало оборота - перенос верхних уровней */
+    if (index == 0)
+        return 0;
+
+    for (uint32_t i = index / 32; i < TIMEOUT_ROOT_SIZE / 32; i++) {
+        uint32_t map = root_map[i];
+
+        if (i == index / 32)
+            map &= ~0UL << (index % 32);
+
+        while (map != 0) {
+            uint32_t slot = i * 32 + 31 - __CLZ(map & -map);
+
+            if (root[slot].next != &root[slot])
+                return slot - index;
+
+            /* Ячейка опустела после timeout_stop() */
+            root_map[i] &= ~(1UL << (slot % 32));
+            map &= map - 1;
+        }
+    }
+
+    return TIMEOUT_ROOT_SIZE - index;
+}
+/* ------------------------------------------------------------------------- */
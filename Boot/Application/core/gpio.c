@@ -33,6 +33,10 @@ static void gpio_octospi_init(void);
 
 static void gpio_led_init(void);
 
+static void gpio_usart_init(void);
+
+static void gpio_button_init(void);
+
 /* Private user code ------------------------------------------------------- */
 
 /**
@@ -43,11 +47,14 @@ void gpio_init(void)
     /* Включить тактирование */
     SET_BIT(RCC->AHB4ENR, RCC_AHB4ENR_GPIOAEN_Msk);
     SET_BIT(RCC->AHB4ENR, RCC_AHB4ENR_GPIOBEN_Msk);
+    SET_BIT(RCC->AHB4ENR, RCC_AHB4ENR_GPIOCEN_Msk);
     SET_BIT(RCC->AHB4ENR, RCC_AHB4ENR_GPIODEN_Msk);
     SET_BIT(RCC->AHB4ENR, RCC_AHB4ENR_GPIONEN_Msk);
 
     gpio_octospi_init();
     gpio_led_init();
+    gpio_usart_init();
+    gpio_button_init();
 }
 /* ------------------------------------------------------------------------- */
 
@@ -222,3 +229,65 @@ static void gpio_led_init(void)
              | 0x02 << GPIO_PUPDR_PUPD13_Pos);
 }
 /* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Инициализировать GPIO USART (ST-LINK VCP)
+ */
+static void gpio_usart_init(void)
+{
+    /*
+     * TX GPIOD8
+     * RX GPIOD9
+     */
+
+    /* Настроить режим работы = AF */
+    MODIFY_REG(GPIOD->MODER,
+               GPIO_MODER_MODE8_Msk
+             | GPIO_MODER_MODE9_Msk,
+               0x02 << GPIO_MODER_MODE8_Pos
+             | 0x02 << GPIO_MODER_MODE9_Pos);
+
+    /* Настроить тип вывода = Push-Pull */
+    CLEAR_BIT(GPIOD->OTYPER,
+              GPIO_OTYPER_OT8_Msk
+            | GPIO_OTYPER_OT9_Msk);
+
+    /* Настроить скорость работы вывода = Medium Speed */
+    MODIFY_REG(GPIOD->OSPEEDR,
+               GPIO_OSPEEDR_OSPEED8_Msk
+             | GPIO_OSPEEDR_OSPEED9_Msk,
+               0x01 << GPIO_OSPEEDR_OSPEED8_Pos
+             | 0x01 << GPIO_OSPEEDR_OSPEED9_Pos);
+
+    /* Настроить подтяжку сигнала = Pull-Up */
+    MODIFY_REG(GPIOD->PUPDR,
+               GPIO_PUPDR_PUPD8_Msk
+             | GPIO_PUPDR_PUPD9_Msk,
+               0x01 << GPIO_PUPDR_PUPD8_Pos
+             | 0x01 << GPIO_PUPDR_PUPD9_Pos);
+
+    /* Настроить альтернативную функцию = 7 */
+    MODIFY_REG(GPIOD->AFR[1],
+               GPIO_AFRH_AFSEL8_Msk
+             | GPIO_AFRH_AFSEL9_Msk,
+               0x07 << GPIO_AFRH_AFSEL8_Pos
+             | 0x07 << GPIO_AFRH_AFSEL9_Pos);
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Инициализировать GPIO кнопки
+ */
+static void gpio_button_init(void)
+{
+    /*
+     * B1 USER GPIOC13
+     */
+
+    /* Настроить режим работы = Input */
+    CLEAR_BIT(GPIOC->MODER, GPIO_MODER_MODE13_Msk);
+
+    /* Настроить подтяжку сигнала = No-Pull (внешняя подтяжка к GND) */
+    CLEAR_BIT(GPIOC->PUPDR, GPIO_PUPDR_PUPD13_Msk);
+}
+/* ------------------------------------------------------------------------- */
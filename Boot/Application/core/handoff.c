@@ -0,0 +1,122 @@
+/**
+ * Copyright (C) 2025 zhmaksim <zhiharev.maxim.alexandrovich@yandex.ru>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/* Includes ---------------------------------------------------------------- */
+
+#include "handoff.h"
+#include "rcc.h"
+#include "xspi.h"
+#include "dwt.h"
+#include "image.h"
+
+/* Private macros ---------------------------------------------------------- */
+
+/* Private constants ------------------------------------------------------- */
+
+/* Private types ----------------------------------------------------------- */
+
+/* Private variables ------------------------------------------------------- */
+
+static struct handoff *const handoff = (struct handoff *) HANDOFF_ADDRESS;
+
+/* Private function prototypes --------------------------------------------- */
+
+static uint32_t handoff_checksum(const struct handoff *block);
+
+/* Private user code ------------------------------------------------------- */
+
+/**
+ * @brief           Инициализировать блок передачи App
+ *
+ * @note            Сохраняет причину сброса и сбрасывает флаги RCC_RSR,
+ *                  чтобы следующий запуск получил только свою причину.
+ *                  Вызывается после telemetry_init() (доступ к SRAM_BKP)
+ */
+void handoff_init(void)
+{
+    /* Сбросить блок (признак записывается последним в handoff_commit) */
+    handoff->magic = 0;
+    handoff->version = HANDOFF_VERSION;
+    handoff->size = sizeof(struct handoff);
+    handoff->flash_mode = HANDOFF_FLASH_NONE;
+    handoff->flash_fast_boot = false;
+
+    handoff->reset_cause = READ_REG(RCC->RSR);
+    SET_BIT(RCC->RSR, RCC_RSR_RMVF_Msk);
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Записать режим внешней FLASH
+ *
+ * @param[in]       mode: Режим @ref enum handoff_flash_mode
+ * @param[in]       fast_boot: Заголовок прочитан через Fast Boot MX25UW
+ */
+void handoff_set_flash(uint32_t mode, bool fast_boot)
+{
+    handoff->flash_mode = mode;
+    handoff->flash_fast_boot = fast_boot;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Завершить блок перед переходом в App
+ *
+ * @param[in]       vector_address: Адрес таблицы векторов App
+ */
+void handoff_commit(uint32_t vector_address)
+{
+    handoff->cpu_clock = RCC_CPU_CLOCK;
+    handoff->bus_matrix_clock = RCC_BUS_MATRIX_CLOCK;
+    handoff->apb1_clock = RCC_APB1_CLOCK;
+    handoff->apb2_clock = RCC_APB2_CLOCK;
+    handoff->apb4_clock = RCC_APB4_CLOCK;
+    handoff->apb5_clock = RCC_APB5_CLOCK;
+    handoff->xspi_clock = XSPI_MAX_CLOCK;
+    handoff->vector_address = vector_address;
+    handoff->jump_cycles = dwt_get_cycles();
+
+    const uint8_t *header_digest = image_get_header_digest();
+
+    for (uint32_t i = 0; i < IMAGE_DIGEST_SIZE; i++)
+        handoff->header_digest[i] = header_digest[i];
+
+    handoff->checksum = handoff_checksum(handoff);
+    handoff->magic = HANDOFF_MAGIC;
+
+    __DSB();
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Вычислить контрольную сумму блока
+ *
+ * @param[in]       block: Указатель на блок
+ * @return          Контрольная сумма
+ */
+static uint32_t handoff_checksum(const struct handoff *block)
+{
+    const uint32_t *word = (const uint32_t *) block;
+    uint32_t checksum = 0;
+
+    /* Все слова после magic до checksum */
+    for (uint32_t i = 1; i < offsetof(struct handoff, checksum) / 4; i++)
+        checksum = (checksum << 5 | checksum >> 27) ^ word[i];
+
+    return checksum;
+}
+/* ------------------------------------------------------------------------- */
@@ -0,0 +1,129 @@
+/**
+ * Copyright (C) 2025 zhmaksim <zhiharev.maxim.alexandrovich@yandex.ru>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/* Includes ---------------------------------------------------------------- */
+
+#include "hash.h"
+#include "dma.h"
+#include "systick.h"
+
+/* Private macros ---------------------------------------------------------- */
+
+/* Private constants ------------------------------------------------------- */
+
+#define HASH_TIMEOUT            1000
+
+#define HASH_DMA_CHANNEL        HPDMA1_Channel0
+
+/* Private types ----------------------------------------------------------- */
+
+/* Private variables ------------------------------------------------------- */
+
+/* Private function prototypes --------------------------------------------- */
+
+/* Private user code ------------------------------------------------------- */
+
+/**
+ * @brief           Инициализировать HASH
+ */
+void hash_init(void)
+{
+    /* Включить тактирование HASH */
+    SET_BIT(RCC->AHB3ENR, RCC_AHB3ENR_HASHEN_Msk);
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Вычислить SHA-256
+ *
+ * @param[in]       data: Указатель на данные (в т.ч. окно Memory Mapped XSPI)
+ * @param[in]       size: Размер данных (байт)
+ * @param[out]      digest: Указатель на буфер результата (HASH_SHA256_SIZE байт)
+ * @return          Статус:
+ *                      - HASH_ERROR
+ *                      - HASH_OK
+ *
+ * @note            Целые слова передаются в HASH_DIN через HPDMA1 (память-память,
+ *                  без инкремента адреса приемника). Запись в HASH_DIN при
+ *                  заполненном FIFO приостанавливает шину до обработки блока,
+ *                  поэтому запрос DMA от HASH не используется
+ */
+int32_t hash_sha256(const void *data, uint32_t size, uint8_t *digest)
+{
+    uint32_t tickstart = systick_get_tick();
+
+    uint32_t words_size = size & ~0x03;
+    uint32_t bytes_size = size & 0x03;
+    const uint8_t *pdata = (const uint8_t *) data + words_size;
+
+    /* Запустить новый расчет: SHA-256, байтовые данные */
+    WRITE_REG(HASH->CR,
+              0x03 << HASH_CR_ALGO_Pos
+            | 0x02 << HASH_CR_DATATYPE_Pos
+            | HASH_CR_INIT_Msk);
+
+    /* Передать целые слова */
+    if (words_size > 0) {
+        struct dma dma = {
+            .channel = HASH_DMA_CHANNEL,
+        };
+        int32_t status;
+
+        dma_start(&dma, (uint32_t) data, (uint32_t) &HASH->DIN, words_size, DMA_SRC_INC);
+
+        while ((status = dma_process(&dma)) == DMA_BUSY) {
+            if (systick_get_tick() - tickstart >= HASH_TIMEOUT)
+                return HASH_ERROR;
+        }
+
+        if (status != DMA_OK)
+            return HASH_ERROR;
+    }
+
+    /* Передать неполное последнее слово */
+    if (bytes_size > 0) {
+        uint32_t word = 0;
+
+        for (uint32_t i = 0; i < bytes_size; i++)
+            word |= (uint32_t) pdata[i] << (i * 8);
+
+        WRITE_REG(HASH->DIN, word);
+    }
+
+    /* Настроить количество бит последнего слова и запустить финальный расчет */
+    WRITE_REG(HASH->STR, (bytes_size * 8) << HASH_STR_NBLW_Pos);
+    SET_BIT(HASH->STR, HASH_STR_DCAL_Msk);
+
+    /* Ожидание завершения расчета */
+    while (!READ_BIT(HASH->SR, HASH_SR_DCIS_Msk)) {
+        if (systick_get_tick() - tickstart >= HASH_TIMEOUT)
+            return HASH_ERROR;
+    }
+
+    /* Прочитать результат (big-endian) */
+    for (uint32_t i = 0; i < HASH_SHA256_SIZE / 4; i++) {
+        uint32_t word = READ_REG(HASH_DIGEST->HR[i]);
+
+        digest[i * 4 + 0] = word >> 24;
+        digest[i * 4 + 1] = word >> 16;
+        digest[i * 4 + 2] = word >> 8;
+        digest[i * 4 + 3] = word;
+    }
+
+    return HASH_OK;
+}
+/* ------------------------------------------------------------------------- */
@@ -0,0 +1,73 @@
+/**
+ * Copyright (C) 2025 zhmaksim <zhiharev.maxim.alexandrovich@yandex.ru>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef CRC_H_
+#define CRC_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/* Includes ---------------------------------------------------------------- */
+
+#include "main.h"
+#include "dma.h"
+
+/* Exported macros --------------------------------------------------------- */
+
+/* Exported constants ------------------------------------------------------ */
+
+#define CRC_OK                   0
+#define CRC_ERROR               -1
+#define CRC_BUSY                 1
+
+#define CRC_INITIAL             0x00000000      /* Начальное значение для crc_calculate_software() */
+
+/* Exported types ---------------------------------------------------------- */
+
+/**
+ * @brief           Определение структуры данных расчета CRC-32 через GPDMA1
+ */
+struct crc {
+    struct dma dma;                             /*!< Передача слов данных в CRC_DR */
+
+    const uint8_t *tail;                        /*!< Указатель на неполное последнее слово */
+
+    uint32_t tail_size;                         /*!< Размер неполного последнего слова (байт) */
+};
+
+/* Exported variables ------------------------------------------------------ */
+
+/* Exported function prototypes -------------------------------------------- */
+
+void crc_init(void);
+
+void crc_start(struct crc *crc, const void *data, uint32_t size);
+
+int32_t crc_process(struct crc *crc, uint32_t *value);
+
+int32_t crc_calculate(const void *data, uint32_t size, uint32_t *value);
+
+uint32_t crc_calculate_software(uint32_t crc, const void *data, uint32_t size);
+
+/* Exported callback function prototypes ----------------------------------- */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* CRC_H_ */
@@ -0,0 +1,76 @@
+/**
+ * Copyright (C) 2025 zhmaksim <zhiharev.maxim.alexandrovich@yandex.ru>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef DMA_H_
+#define DMA_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/* Includes ---------------------------------------------------------------- */
+
+#include "main.h"
+
+/* Exported macros --------------------------------------------------------- */
+
+/* Exported constants ------------------------------------------------------ */
+
+#define DMA_OK                   0
+#define DMA_ERROR               -1
+#define DMA_BUSY                 1
+
+#define DMA_SRC_INC              0x01           /* Инкремент адреса источника */
+#define DMA_DST_INC              0x02           /* Инкремент адреса приемника */
+#define DMA_WIDTH_64             0x04           /* Ширина данных 64 бит (только HPDMA, размер кратен 8) */
+
+/* Exported types ---------------------------------------------------------- */
+
+/**
+ * @brief           Определение структуры данных передачи DMA память-память
+ */
+struct dma {
+    DMA_Channel_TypeDef *channel;               /*!< Указатель на структуру данных канала GPDMA/HPDMA */
+
+    uint32_t src;                               /*!< Адрес источника текущего блока */
+
+    uint32_t dst;                               /*!< Адрес приемника текущего блока */
+
+    uint32_t size;                              /*!< Оставшийся размер данных (байт) */
+
+    uint32_t block;                             /*!< Размер текущего блока (байт) */
+
+    uint32_t flags;                             /*!< Флаги DMA_SRC_INC, DMA_DST_INC, DMA_WIDTH_64 */
+};
+
+/* Exported variables ------------------------------------------------------ */
+
+/* Exported function prototypes -------------------------------------------- */
+
+void dma_init(void);
+
+void dma_start(struct dma *dma, uint32_t src, uint32_t dst, uint32_t size, uint32_t flags);
+
+int32_t dma_process(struct dma *dma);
+
+/* Exported callback function prototypes ----------------------------------- */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* DMA_H_ */
@@ -30,6 +30,10 @@ extern "C" {
 
 /* Exported constants ------------------------------------------------------ */
 
+#define PWR_OK           0
+#define PWR_ERROR       -1
+#define PWR_BUSY         1
+
 /* Exported types ---------------------------------------------------------- */
 
 /* Exported variables ------------------------------------------------------ */
@@ -38,6 +42,8 @@ extern "C" {
 
 void pwr_init(void);
 
+int32_t pwr_process(void);
+
 /* Exported callback function prototypes ----------------------------------- */
 
 #ifdef __cplusplus
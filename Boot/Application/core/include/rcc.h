@@ -25,17 +25,15 @@ extern "C" {
 /* Includes ---------------------------------------------------------------- */
 
 #include "main.h"
+#include "rcc_config.h"
 
 /* Exported macros --------------------------------------------------------- */
 
 /* Exported constants ------------------------------------------------------ */
 
-#define RCC_CPU_CLOCK            600000000
-#define RCC_BUS_MATRIX_CLOCK     (RCC_CPU_CLOCK / 2)
-#define RCC_APB1_CLOCK           (RCC_BUS_MATRIX_CLOCK / 2)
-#define RCC_APB2_CLOCK           (RCC_BUS_MATRIX_CLOCK / 2)
-#define RCC_APB4_CLOCK           (RCC_BUS_MATRIX_CLOCK / 2)
-#define RCC_APB5_CLOCK           (RCC_BUS_MATRIX_CLOCK / 2)
+#define RCC_OK                   0
+#define RCC_ERROR               -1
+#define RCC_BUSY                 1
 
 /* Exported types ---------------------------------------------------------- */
 
@@ -45,6 +43,24 @@ extern "C" {
 
 void rcc_init(void);
 
+int32_t rcc_process(void);
+
+void rcc_setup_cpu_clock(void);
+
+uint32_t rcc_get_cpu_hz(void);
+
+uint32_t rcc_get_bus_matrix_hz(void);
+
+uint32_t rcc_get_apb1_hz(void);
+
+uint32_t rcc_get_apb2_hz(void);
+
+uint32_t rcc_get_apb4_hz(void);
+
+uint32_t rcc_get_apb5_hz(void);
+
+uint32_t rcc_get_xspi_hz(void);
+
 /* Exported callback function prototypes ----------------------------------- */
 
 #ifdef __cplusplus
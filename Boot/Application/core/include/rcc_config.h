@@ -0,0 +1,76 @@
+/**
+ * Copyright (C) 2025 zhmaksim <zhiharev.maxim.alexandrovich@yandex.ru>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef RCC_CONFIG_H_
+#define RCC_CONFIG_H_
+
+/* Includes ---------------------------------------------------------------- */
+
+/* Exported macros --------------------------------------------------------- */
+
+/* Exported constants ------------------------------------------------------ */
+
+/* Конфигурация тактирования - единственное описание дерева частот.
+ * Значения регистров и частоты шин выводятся из нее при компиляции,
+ * допустимость диапазонов проверяется в Boot rcc.c. Заголовок общий
+ * для Boot и App: профили App (App/Application/core/rcc.c) переключают
+ * только источник и делители настроенных здесь PLL.
+ * CPRE и BMPRE делят sys_ck параллельно (RM0477, RCC_CDCFGR/RCC_BMCFGR) */
+#define RCC_HSI_CLOCK            64000000
+#define RCC_HSE_CLOCK            24000000
+
+#define RCC_PLL1_DIVM            12             /* ref1_ck = 24MHz / 12 = 2MHz */
+#define RCC_PLL1_DIVN            300            /* VCO1 = 2MHz * 300 = 600MHz */
+#define RCC_PLL1_DIVP            1              /* PLL1P = 600MHz / 1 = 600MHz */
+
+#define RCC_PLL2_DIVM            4              /* ref2_ck = 24MHz / 4 = 6MHz */
+#define RCC_PLL2_DIVN            100            /* VCO2 = 6MHz * 100 = 600MHz */
+#define RCC_PLL2_DIVT            3              /* PLL2T = 600MHz / 3 = 200MHz */
+
+#define RCC_CPU_DIVIDER          1              /* CPU = PLL1P / 1 = 600MHz */
+#define RCC_BUS_MATRIX_DIVIDER   2              /* AXI/AHB = PLL1P / 2 = 300MHz */
+#define RCC_APB1_DIVIDER         2              /* APB1 = AXI/AHB / 2 = 150MHz */
+#define RCC_APB2_DIVIDER         2              /* APB2 = AXI/AHB / 2 = 150MHz */
+#define RCC_APB4_DIVIDER         2              /* APB4 = AXI/AHB / 2 = 150MHz */
+#define RCC_APB5_DIVIDER         2              /* APB5 = AXI/AHB / 2 = 150MHz */
+
+/* Частоты, выведенные из конфигурации (Гц) */
+#define RCC_PLL1_REF_CLOCK       (RCC_HSE_CLOCK / RCC_PLL1_DIVM)
+#define RCC_PLL1_VCO_CLOCK       (RCC_PLL1_REF_CLOCK * RCC_PLL1_DIVN)
+#define RCC_PLL1P_CLOCK          (RCC_PLL1_VCO_CLOCK / RCC_PLL1_DIVP)
+
+#define RCC_PLL2_REF_CLOCK       (RCC_HSE_CLOCK / RCC_PLL2_DIVM)
+#define RCC_PLL2_VCO_CLOCK       (RCC_PLL2_REF_CLOCK * RCC_PLL2_DIVN)
+#define RCC_PLL2T_CLOCK          (RCC_PLL2_VCO_CLOCK / RCC_PLL2_DIVT)
+
+#define RCC_CPU_CLOCK            (RCC_PLL1P_CLOCK / RCC_CPU_DIVIDER)
+#define RCC_BUS_MATRIX_CLOCK     (RCC_PLL1P_CLOCK / RCC_BUS_MATRIX_DIVIDER)   /* BMPRE делит sys_ck */
+#define RCC_APB1_CLOCK           (RCC_BUS_MATRIX_CLOCK / RCC_APB1_DIVIDER)
+#define RCC_APB2_CLOCK           (RCC_BUS_MATRIX_CLOCK / RCC_APB2_DIVIDER)
+#define RCC_APB4_CLOCK           (RCC_BUS_MATRIX_CLOCK / RCC_APB4_DIVIDER)
+#define RCC_APB5_CLOCK           (RCC_BUS_MATRIX_CLOCK / RCC_APB5_DIVIDER)
+#define RCC_XSPI_CLOCK           RCC_PLL2T_CLOCK        /* Ядро XSPI2 (XSPI2SEL = PLL2T) */
+
+/* Exported types ---------------------------------------------------------- */
+
+/* Exported variables ------------------------------------------------------ */
+
+/* Exported function prototypes -------------------------------------------- */
+
+/* Exported callback function prototypes ----------------------------------- */
+
+#endif /* RCC_CONFIG_H_ */
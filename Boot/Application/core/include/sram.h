@@ -0,0 +1,63 @@
+/**
+ * Copyright (C) 2025 zhmaksim <zhiharev.maxim.alexandrovich@yandex.ru>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef SRAM_H_
+#define SRAM_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/* Includes ---------------------------------------------------------------- */
+
+#include "main.h"
+#include "dma.h"
+
+/* Exported macros --------------------------------------------------------- */
+
+/* Exported constants ------------------------------------------------------ */
+
+#define SRAM_AXI_ADDRESS        SRAM1_AXI_BASE
+#define SRAM_AXI_LENGTH         0x00072000      /* Область "SRAM" скрипта компоновщика */
+#define SRAM_AHB_ADDRESS        SRAM1_AHB_BASE
+#define SRAM_AHB_LENGTH         (2 * SRAM_AHB_SIZE)
+#define SRAM_ITCM_ADDRESS       ITCM_BASE
+#define SRAM_ITCM_LENGTH        0x00010000      /* Область "ITCM" скрипта компоновщика */
+
+#define SRAM_OK                  0
+#define SRAM_ERROR              -1
+#define SRAM_BUSY                1
+
+/* Exported types ---------------------------------------------------------- */
+
+/* Exported variables ------------------------------------------------------ */
+
+/* Exported function prototypes -------------------------------------------- */
+
+void sram_scrub_start(void);
+
+int32_t sram_scrub_process(void);
+
+int32_t sram_scrub_wait(void);
+
+/* Exported callback function prototypes ----------------------------------- */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* SRAM_H_ */
@@ -0,0 +1,89 @@
+/**
+ * Copyright (C) 2025 zhmaksim <zhiharev.maxim.alexandrovich@yandex.ru>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef STANDBY_H_
+#define STANDBY_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/* Includes ---------------------------------------------------------------- */
+
+#include "main.h"
+#include "image.h"
+
+/* Exported macros --------------------------------------------------------- */
+
+/* Exported constants ------------------------------------------------------ */
+
+#define STANDBY_STATE_ADDRESS           (BKPSRAM_BASE + 0x300)
+#define STANDBY_STATE_MAGIC             0x59425453      /* "STBY" */
+
+/* Exported types ---------------------------------------------------------- */
+
+/**
+ * @brief           Определение структуры данных состояния между пробуждениями
+ *
+ * @note            Записывается App перед переходом в Standby, поля wake...fast_resume -
+ *                  Boot при пробуждении. Размещается в SRAM_BKP (сохраняется в
+ *                  Standby при включенном Backup регуляторе), формат должен
+ *                  совпадать с App/Application/core/include/standby.h
+ */
+struct standby_state {
+    uint32_t magic;                             /*!< Признак состояния STANDBY_STATE_MAGIC */
+
+    uint32_t header_address;                    /*!< Адрес заголовка запущенного образа (0 - неизвестен) */
+
+    uint32_t image_version;                     /*!< Версия запущенного образа */
+
+    uint8_t header_digest[IMAGE_DIGEST_SIZE];   /*!< SHA-256 подписанных полей magic...digest заголовка */
+
+    uint32_t period;                            /*!< Период пробуждения (с) */
+
+    uint32_t wakes;                             /*!< Переходов в Standby без холодного запуска */
+
+    uint32_t context;                           /*!< Данные App между пробуждениями */
+
+    uint32_t checksum;                          /*!< Контрольная сумма полей header_address...context */
+
+    uint32_t wake;                              /*!< Boot запущен пробуждением RTC из Standby */
+
+    uint32_t wake_tr;                           /*!< RTC_TR при запуске Boot */
+
+    uint32_t wake_ssr;                          /*!< RTC_SSR при запуске Boot */
+
+    uint32_t fast_resume;                       /*!< Boot запустил образ без проверки подписи (только SHA-256) */
+};
+
+/* Exported variables ------------------------------------------------------ */
+
+/* Exported function prototypes -------------------------------------------- */
+
+void standby_init(void);
+
+const struct standby_state *standby_get_resume(void);
+
+void standby_set_fast_resume(void);
+
+/* Exported callback function prototypes ----------------------------------- */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* STANDBY_H_ */
@@ -42,6 +42,12 @@ void systick_it_handler(void);
 
 uint32_t systick_get_tick(void);
 
+uint64_t systick_get_tick64(void);
+
+uint64_t systick_get_cycles(void);
+
+uint64_t systick_get_ns(void);
+
 /* Exported callback function prototypes ----------------------------------- */
 
 __WEAK void systick_period_elapsed_callback(void);
@@ -0,0 +1,111 @@
+/**
+ * Copyright (C) 2025 zhmaksim <zhiharev.maxim.alexandrovich@yandex.ru>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef TELEMETRY_H_
+#define TELEMETRY_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/* Includes ---------------------------------------------------------------- */
+
+#include "main.h"
+
+/* Exported macros --------------------------------------------------------- */
+
+/* Exported constants ------------------------------------------------------ */
+
+#define TELEMETRY_ADDRESS       BKPSRAM_BASE
+
+#define TELEMETRY_MAGIC         0x4D4C5442      /* "BTLM" */
+#define TELEMETRY_VERSION       6
+
+/* Exported types ---------------------------------------------------------- */
+
+/**
+ * @brief           Определение перечисления этапов загрузки
+ *
+ * @note            Порядок и состав этапов является частью формата записи,
+ *                  при изменении необходимо увеличить TELEMETRY_VERSION
+ */
+enum telemetry_stage {
+    TELEMETRY_STAGE_CORE,
+    TELEMETRY_STAGE_CLOCK_START,
+    TELEMETRY_STAGE_GPIO,
+    TELEMETRY_STAGE_FLASH,
+    TELEMETRY_STAGE_CLOCK_WAIT,
+    TELEMETRY_STAGE_CLOCK_SWITCH,
+    TELEMETRY_STAGE_XSPI,
+    TELEMETRY_STAGE_MX25UW_INIT,
+    TELEMETRY_STAGE_MX25UW_OPI_DTR,
+    TELEMETRY_STAGE_MX25UW_MEMORY_MAPPED,
+    TELEMETRY_STAGE_SRAM_SCRUB,
+    TELEMETRY_STAGE_IMAGE_SIGNATURE,
+    TELEMETRY_STAGE_IMAGE_DIGEST,
+    TELEMETRY_STAGE_IMAGE_VERIFY,
+    TELEMETRY_STAGE_IMAGE_LOAD,
+    /* --- */
+    TELEMETRY_STAGE_COUNT,
+};
+
+
+/**
+ * @brief           Определение структуры данных отметки времени этапа
+ */
+struct telemetry_stamp {
+    uint32_t cycles;                            /*!< Значение DWT CYCCNT по завершении этапа */
+
+    uint32_t frequency;                         /*!< Частота CPU во время этапа (Гц) */
+};
+
+
+/**
+ * @brief           Определение структуры данных записи телеметрии загрузки
+ *
+ * @note            Запись размещается в SRAM_BKP и читается App,
+ *                  формат должен совпадать с App/Application/core/include/telemetry.h
+ */
+struct telemetry {
+    uint32_t magic;                             /*!< Признак записи TELEMETRY_MAGIC */
+
+    uint16_t version;                           /*!< Версия формата записи */
+
+    uint16_t size;                              /*!< Размер записи (байт) */
+
+    struct telemetry_stamp stamp[TELEMETRY_STAGE_COUNT];    /*!< Отметки времени этапов @ref enum telemetry_stage */
+
+    uint32_t checksum;                          /*!< Контрольная сумма записи */
+};
+
+/* Exported variables ------------------------------------------------------ */
+
+/* Exported function prototypes -------------------------------------------- */
+
+void telemetry_init(void);
+
+void telemetry_stamp(uint32_t stage, uint32_t frequency);
+
+void telemetry_commit(void);
+
+/* Exported callback function prototypes ----------------------------------- */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* TELEMETRY_H_ */
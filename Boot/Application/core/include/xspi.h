@@ -25,11 +25,14 @@ extern "C" {
 /* Includes ---------------------------------------------------------------- */
 
 #include "main.h"
+#include "rcc.h"
 
 /* Exported macros --------------------------------------------------------- */
 
 /* Exported constants ------------------------------------------------------ */
 
+#define XSPI_MAX_CLOCK          RCC_XSPI_CLOCK  /* Частота XSPI2 после xspi_setup_max_frequency() */
+
 /* Exported types ---------------------------------------------------------- */
 
 /* Exported variables ------------------------------------------------------ */
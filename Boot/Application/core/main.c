@@ -19,13 +19,26 @@
 
 #include "main.h"
 #include "systick.h"
+#include "dwt.h"
+#include "telemetry.h"
+#include "handoff.h"
+#include "standby.h"
+#include "mpu.h"
+#include "cache.h"
 #include "pwr.h"
 #include "flash.h"
 #include "rcc.h"
 #include "gpio.h"
 #include "xspi.h"
+#include "dma.h"
+#include "hash.h"
+#include "crc.h"
+#include "pka.h"
+#include "sram.h"
 #include "led.h"
 #include "mx25uw.h"
+#include "image.h"
+#include "update.h"
 
 /* Private macros ---------------------------------------------------------- */
 
@@ -33,9 +46,8 @@
 
 #define VTOR_ADDRESS    0x08000000
 
-#define HSI_CLOCK       64000000
-
-#define APP_ADDRESS     0x70000000
+/* Смещение заголовка слота A во FLASH, с которого MX25UW выдает данные в режиме Fast Boot */
+#define MX25UW_FAST_BOOT_ADDRESS        (IMAGE_SLOT_A_ADDRESS & (MX25UW_FLASH_SIZE - 1))
 
 /* Private types ----------------------------------------------------------- */
 
@@ -45,13 +57,15 @@
 
 static void setup_hardware(void);
 
-static void setup_vector_table(void);
+static void setup_clock(void);
 
-static void setup_fpu(void);
+static void setup_vector_table(void);
 
 static void app_main(void);
 
-static void jump_app(void);
+static void update(void);
+
+static void jump_app(uint32_t address);
 
 /* Private user code ------------------------------------------------------- */
 
@@ -80,34 +94,163 @@ void error(void)
 
 static void app_main(void)
 {
-    if (mx25uw_init() != MX25UW_OK) {
-        error();
-    } else if (mx25uw_setup_opi_dtr() != MX25UW_OK) {
+    /* Fast Boot: MX25UW выдает заголовок слота A без команды чтения ID */
+    uint32_t magic;
+    bool fast_boot = mx25uw_read_fast_boot(&magic, sizeof(magic)) == MX25UW_OK
+                  && magic == IMAGE_HEADER_MAGIC;
+
+    if (!fast_boot) {
+        if (mx25uw_init() != MX25UW_OK) {
+            error();
+        }
+
+        /* Настроить Fast Boot для следующего запуска (ошибка не критична) */
+        mx25uw_setup_fast_boot(MX25UW_FAST_BOOT_ADDRESS);
+    }
+
+    telemetry_stamp(TELEMETRY_STAGE_MX25UW_INIT, RCC_CPU_CLOCK);
+
+    if (mx25uw_setup_opi_dtr() != MX25UW_OK) {
         error();
     }
 
     xspi_setup_max_frequency();
 
+    telemetry_stamp(TELEMETRY_STAGE_MX25UW_OPI_DTR, RCC_CPU_CLOCK);
+
     if (mx25uw_setup_memory_mapped_mode() != MX25UW_OK) {
         error();
-    } else {
-        jump_app();
     }
+
+    telemetry_stamp(TELEMETRY_STAGE_MX25UW_MEMORY_MAPPED, RCC_CPU_CLOCK);
+    handoff_set_flash(HANDOFF_FLASH_MEMORY_MAPPED, fast_boot);
+
+    /* Дождаться заполнения ОЗУ: ITCM/AXI SRAM принимают образ App, SRAM_AHB - буферы обновления */
+    if (sram_scrub_wait() != SRAM_OK) {
+        error();
+    }
+
+    telemetry_stamp(TELEMETRY_STAGE_SRAM_SCRUB, RCC_CPU_CLOCK);
+
+    /* Выбрать слот и проверить образ App */
+    const struct image_header *header;
+
+    hash_init();
+    crc_init();
+
+    /* Пробуждение из Standby по RTC: подпись проверена при холодном запуске */
+    const struct standby_state *resume = standby_get_resume();
+
+    /* Обновление по запросу (кнопка USER) или при отсутствии корректного образа */
+    if (update_is_requested()) {
+        update();
+    } else if (resume != NULL
+            && image_resume(resume->header_address, resume->image_version, resume->header_digest, &header) == IMAGE_OK) {
+        standby_set_fast_resume();
+    } else if (image_select(&header) != IMAGE_OK) {
+        update();
+    }
+
+    telemetry_stamp(TELEMETRY_STAGE_IMAGE_VERIFY, RCC_CPU_CLOCK);
+
+    /* Распаковать сжатый образ в ITCM/SRAM */
+    if (image_load(header) != IMAGE_OK) {
+        error();
+    }
+
+    telemetry_stamp(TELEMETRY_STAGE_IMAGE_LOAD, RCC_CPU_CLOCK);
+    telemetry_commit();
+    handoff_commit(header->vector_address);
+
+    jump_app(header->vector_address);
+}
+/* ------------------------------------------------------------------------- */
+
+static void update(void)
+{
+    int32_t status;
+
+    if (update_init() != UPDATE_OK) {
+        error();
+    }
+
+    do {
+        status = update_process();
+
+        if (status == UPDATE_ERROR)
+            error();
+    } while (status == UPDATE_BUSY);
+
+    /* Образ записан - вернуть MX25UW в режим SPI и перезапустить Boot */
+    mx25uw_reset();
+    NVIC_SystemReset();
 }
 /* ------------------------------------------------------------------------- */
 
 static void setup_hardware(void)
 {
+    dwt_init();
+    telemetry_init();
+    handoff_init();
+
+    /* Определить пробуждение по RTC до настройки тактирования (задержка от пробуждения) */
+    standby_init();
+
+    /* Заполнить ОЗУ через DMA параллельно с настройкой тактирования */
+    dma_init();
+    sram_scrub_start();
+
+    /* Запустить очистку памяти PKA (проверка подписи образа) */
+    pka_init();
+
     setup_vector_table();
-    setup_fpu();
 
-    systick_init(HSI_CLOCK);
+    mpu_init();
+    cache_init();
+
+    systick_init(RCC_HSI_CLOCK);
+    telemetry_stamp(TELEMETRY_STAGE_CORE, RCC_HSI_CLOCK);
+
+    /* Запустить LDO/VOS, HSE и PLL без ожидания готовности */
     pwr_init();
-    flash_init();
     rcc_init();
-    systick_init(RCC_CPU_CLOCK);
+    telemetry_stamp(TELEMETRY_STAGE_CLOCK_START, RCC_HSI_CLOCK);
+
+    /* Выполнить независимую от PLL настройку пока тактирование стабилизируется */
     gpio_init();
+    telemetry_stamp(TELEMETRY_STAGE_GPIO, RCC_HSI_CLOCK);
+
+    flash_init();
+    telemetry_stamp(TELEMETRY_STAGE_FLASH, RCC_HSI_CLOCK);
+
+    setup_clock();
+    telemetry_stamp(TELEMETRY_STAGE_CLOCK_SWITCH, RCC_HSI_CLOCK);
+
+    systick_init(RCC_CPU_CLOCK);
+    dwt_set_frequency(RCC_CPU_CLOCK);
     xspi_init();
+    telemetry_stamp(TELEMETRY_STAGE_XSPI, RCC_CPU_CLOCK);
+}
+/* ------------------------------------------------------------------------- */
+
+static void setup_clock(void)
+{
+    int32_t pwr_status;
+    int32_t rcc_status;
+
+    /* Ожидание готовности PWR и RCC */
+    do {
+        pwr_status = pwr_process();
+        rcc_status = rcc_process();
+
+        if (pwr_status == PWR_ERROR || rcc_status == RCC_ERROR)
+            error();
+    } while (pwr_status == PWR_BUSY || rcc_status == RCC_BUSY);
+
+    telemetry_stamp(TELEMETRY_STAGE_CLOCK_WAIT, RCC_HSI_CLOCK);
+
+    /* Переключить CPU на PLL1 */
+    rcc_setup_cpu_clock();
 }
 /* ------------------------------------------------------------------------- */
 
@@ -123,23 +266,29 @@ static void setup_vector_table(void)
 }
 /* ------------------------------------------------------------------------- */
 
-static void setup_fpu(void)
-{
-    SET_BIT(SCB->CPACR, (0x03 << 20) | (0x03 << 22));
-}
-/* ------------------------------------------------------------------------- */
-
-static void jump_app(void)
+static void jump_app(uint32_t address)
 {
     __disable_irq();
 
+    /* Записать D-Cache в память и передать App ядро без кэшей и MPU,
+     * App выполняет собственную настройку */
+    cache_deinit();
+    mpu_deinit();
+
     __ISB();
     __DSB();
 
     typedef void (*p_function)(void);
-    p_function app = (p_function) *(uint32_t *) (APP_ADDRESS + 4);
+    p_function app = (p_function) *(uint32_t *) (address + 4);
+
+    /* Настроить таблицу векторов App (App не повторяет настройку) */
+    WRITE_REG(SCB->VTOR, address);
+
+    /* Сбросить CONTROL.FPCA: контекст FPU Boot не переходит в App */
+    __set_CONTROL(0);
+    __ISB();
 
-    __set_MSP(*(uint32_t *) APP_ADDRESS);
+    __set_MSP(*(uint32_t *) address);
 
     app();
 }
@@ -0,0 +1,230 @@
+/**
+ * Copyright (C) 2025 zhmaksim <zhiharev.maxim.alexandrovich@yandex.ru>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/* Includes ---------------------------------------------------------------- */
+
+#include "pka.h"
+#include "systick.h"
+
+/* Private macros ---------------------------------------------------------- */
+
+/* Private constants ------------------------------------------------------- */
+
+#define PKA_TIMEOUT             100
+
+#define PKA_MODE_ECDSA_VERIFY   0x26
+
+#define PKA_RESULT_OK           0xD60D          /* Результат проверки подписи: подпись верна */
+
+#define PKA_P256_BITS           256
+
+/* Private types ----------------------------------------------------------- */
+
+/* Private variables ------------------------------------------------------- */
+
+/* Параметры кривой P-256 (big-endian) */
+static const uint8_t p256_modulus[PKA_P256_SIZE] = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x01,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF
+};
+
+static const uint8_t p256_order[PKA_P256_SIZE] = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xBC, 0xE6, 0xFA, 0xAD, 0xA7, 0x17, 0x9E, 0x84,
+    0xF3, 0xB9, 0xCA, 0xC2, 0xFC, 0x63, 0x25, 0x51
+};
+
+/* |a|, a = -3 (знак передается отдельно) */
+static const uint8_t p256_a[PKA_P256_SIZE] = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03
+};
+
+static const uint8_t p256_gx[PKA_P256_SIZE] = {
+    0x6B, 0x17, 0xD1, 0xF2, 0xE1, 0x2C, 0x42, 0x47,
+    0xF8, 0xBC, 0xE6, 0xE5, 0x63, 0xA4, 0x40, 0xF2,
+    0x77, 0x03, 0x7D, 0x81, 0x2D, 0xEB, 0x33, 0xA0,
+    0xF4, 0xA1, 0x39, 0x45, 0xD8, 0x98, 0xC2, 0x96
+};
+
+static const uint8_t p256_gy[PKA_P256_SIZE] = {
+    0x4F, 0xE3, 0x42, 0xE2, 0xFE, 0x1A, 0x7F, 0x9B,
+    0x8E, 0xE7, 0xEB, 0x4A, 0x7C, 0x0F, 0x9E, 0x16,
+    0x2B, 0xCE, 0x33, 0x57, 0x6B, 0x31, 0x5E, 0xCE,
+    0xCB, 0xB6, 0x40, 0x68, 0x37, 0xBF, 0x51, 0xF5
+};
+
+/* Private function prototypes --------------------------------------------- */
+
+static void pka_write_value(uint32_t index, uint32_t value);
+
+static void pka_write_operand(uint32_t index, const uint8_t *data);
+
+static bool pka_is_scalar_valid(const uint8_t *value);
+
+/* Private user code ------------------------------------------------------- */
+
+/**
+ * @brief           Инициализировать PKA
+ *
+ * @note            PKA использует RNG (тактирование HSI48) при очистке своей
+ *                  памяти, поэтому RNG включается до PKA. Очистка выполняется
+ *                  аппаратно параллельно с настройкой тактирования, ожидание
+ *                  готовности (INITOK) - в pka_ecdsa_verify_p256()
+ */
+void pka_init(void)
+{
+    /* Включить HSI48 (тактирование RNG) */
+    SET_BIT(RCC->CR, RCC_CR_HSI48ON_Msk);
+
+    /* Включить тактирование RNG и PKA */
+    SET_BIT(RCC->AHB3ENR, RCC_AHB3ENR_RNGEN_Msk | RCC_AHB3ENR_PKAEN_Msk);
+
+    SET_BIT(RNG->CR, RNG_CR_RNGEN_Msk);
+    SET_BIT(PKA->CR, PKA_CR_EN_Msk);
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Проверить подпись ECDSA P-256
+ *
+ * @param[in]       public_key: Указатель на открытый ключ x || y (big-endian, 64 байт)
+ * @param[in]       digest: Указатель на дайджест SHA-256 сообщения (32 байт)
+ * @param[in]       signature: Указатель на подпись r || s (big-endian, 64 байт)
+ * @return          Статус:
+ *                      - PKA_ERROR (подпись неверна или ошибка PKA)
+ *                      - PKA_OK
+ *
+ * @note            Вычисление u1*G + u2*Q полностью выполняет PKA
+ *                  (режим ECDSA verification), CPU только загружает операнды.
+ *                  Операнды в памяти PKA - слова 32 бит от младшего,
+ *                  за каждым операндом следует нулевое 64-битное слово
+ */
+int32_t pka_ecdsa_verify_p256(const uint8_t *public_key, const uint8_t *digest, const uint8_t *signature)
+{
+    uint32_t tickstart = systick_get_tick();
+
+    /* r и s в диапазоне [1, n - 1] (PKA не проверяет) */
+    if (!pka_is_scalar_valid(signature) || !pka_is_scalar_valid(signature + PKA_P256_SIZE))
+        return PKA_ERROR;
+
+    /* Ожидание очистки памяти PKA после включения */
+    while (!READ_BIT(PKA->SR, PKA_SR_INITOK_Msk)) {
+        if (systick_get_tick() - tickstart >= PKA_TIMEOUT)
+            return PKA_ERROR;
+    }
+
+    pka_write_value(PKA_ECDSA_VERIF_IN_ORDER_NB_BITS, PKA_P256_BITS);
+    pka_write_value(PKA_ECDSA_VERIF_IN_MOD_NB_BITS, PKA_P256_BITS);
+    pka_write_value(PKA_ECDSA_VERIF_IN_A_COEFF_SIGN, 1);
+
+    pka_write_operand(PKA_ECDSA_VERIF_IN_A_COEFF, p256_a);
+    pka_write_operand(PKA_ECDSA_VERIF_IN_MOD_GF, p256_modulus);
+    pka_write_operand(PKA_ECDSA_VERIF_IN_INITIAL_POINT_X, p256_gx);
+    pka_write_operand(PKA_ECDSA_VERIF_IN_INITIAL_POINT_Y, p256_gy);
+    pka_write_operand(PKA_ECDSA_VERIF_IN_ORDER_N, p256_order);
+
+    pka_write_operand(PKA_ECDSA_VERIF_IN_PUBLIC_KEY_POINT_X, public_key);
+    pka_write_operand(PKA_ECDSA_VERIF_IN_PUBLIC_KEY_POINT_Y, public_key + PKA_P256_SIZE);
+    pka_write_operand(PKA_ECDSA_VERIF_IN_SIGNATURE_R, signature);
+    pka_write_operand(PKA_ECDSA_VERIF_IN_SIGNATURE_S, signature + PKA_P256_SIZE);
+    pka_write_operand(PKA_ECDSA_VERIF_IN_HASH_E, digest);
+
+    /* Запустить проверку подписи */
+    WRITE_REG(PKA->CLRFR, PKA_CLRFR_PROCENDFC_Msk | PKA_CLRFR_RAMERRFC_Msk
+                        | PKA_CLRFR_ADDRERRFC_Msk | PKA_CLRFR_OPERRFC_Msk);
+    MODIFY_REG(PKA->CR, PKA_CR_MODE_Msk, PKA_MODE_ECDSA_VERIFY << PKA_CR_MODE_Pos);
+    SET_BIT(PKA->CR, PKA_CR_START_Msk);
+
+    /* Ожидание завершения */
+    while (!READ_BIT(PKA->SR, PKA_SR_PROCENDF_Msk)) {
+        if (systick_get_tick() - tickstart >= PKA_TIMEOUT)
+            return PKA_ERROR;
+    }
+
+    uint32_t errors = READ_BIT(PKA->SR, PKA_SR_RAMERRF_Msk | PKA_SR_ADDRERRF_Msk | PKA_SR_OPERRF_Msk);
+    uint32_t result = READ_REG(PKA->RAM[PKA_ECDSA_VERIF_OUT_RESULT]);
+
+    WRITE_REG(PKA->CLRFR, PKA_CLRFR_PROCENDFC_Msk);
+
+    return errors == 0 && result == PKA_RESULT_OK ? PKA_OK : PKA_ERROR;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Записать параметр-число в память PKA
+ *
+ * @param[in]       index: Индекс слова в памяти PKA
+ * @param[in]       value: Значение
+ */
+static void pka_write_value(uint32_t index, uint32_t value)
+{
+    WRITE_REG(PKA->RAM[index], value);
+    WRITE_REG(PKA->RAM[index + 1], 0);
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Записать операнд P-256 в память PKA
+ *
+ * @param[in]       index: Индекс первого слова операнда в памяти PKA
+ * @param[in]       data: Указатель на операнд (big-endian, PKA_P256_SIZE байт)
+ */
+static void pka_write_operand(uint32_t index, const uint8_t *data)
+{
+    for (uint32_t i = 0; i < PKA_P256_SIZE / 4; i++) {
+        const uint8_t *word = data + PKA_P256_SIZE - 4 * (i + 1);
+
+        WRITE_REG(PKA->RAM[index + i],
+                  (uint32_t) word[0] << 24
+                | (uint32_t) word[1] << 16
+                | (uint32_t) word[2] << 8
+                | (uint32_t) word[3]);
+    }
+
+    WRITE_REG(PKA->RAM[index + PKA_P256_SIZE / 4], 0);
+    WRITE_REG(PKA->RAM[index + PKA_P256_SIZE / 4 + 1], 0);
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Проверить, что скаляр подписи в диапазоне [1, n - 1]
+ *
+ * @param[in]       value: Указатель на скаляр (big-endian, PKA_P256_SIZE байт)
+ * @return          Признак допустимого значения
+ */
+static bool pka_is_scalar_valid(const uint8_t *value)
+{
+    uint8_t nonzero = 0;
+    int32_t compare = 0;
+
+    for (uint32_t i = 0; i < PKA_P256_SIZE; i++) {
+        nonzero |= value[i];
+
+        /* Сравнение с n по первому отличающемуся байту */
+        if (compare == 0 && value[i] != p256_order[i])
+            compare = value[i] < p256_order[i] ? -1 : 1;
+    }
+
+    return nonzero != 0 && compare < 0;
+}
+/* ------------------------------------------------------------------------- */
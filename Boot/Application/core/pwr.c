@@ -18,32 +18,85 @@
 /* Includes ---------------------------------------------------------------- */
 
 #include "pwr.h"
+#include "dwt.h"
 
 /* Private macros ---------------------------------------------------------- */
 
 /* Private constants ------------------------------------------------------- */
 
+#define PWR_READY_TIMEOUT        10000  /* Ожидание готовности LDO и VOS (мкс) */
+
 /* Private types ----------------------------------------------------------- */
 
+/**
+ * @brief           Определение перечисления состояний инициализации PWR
+ */
+enum pwr_state {
+    PWR_STATE_SUPPLY,
+    PWR_STATE_VOS,
+    PWR_STATE_READY,
+};
+
 /* Private variables ------------------------------------------------------- */
 
+static enum pwr_state state;
+
+static struct dwt_deadline deadline;
+
 /* Private function prototypes --------------------------------------------- */
 
 /* Private user code ------------------------------------------------------- */
 
 /**
- * @brief           Инициализировать PWR
+ * @brief           Запустить инициализацию PWR
+ *
+ * @note            Функция не ожидает готовности питания,
+ *                  завершение выполняется в pwr_process()
  */
 void pwr_init(void)
 {
     /* Настроить Power Supply = LDO */
     WRITE_REG(PWR->CSR2, 0x02);
-    while (!READ_BIT(PWR->SR1, PWR_SR1_ACTVOSRDY_Msk))
-        continue;
 
-    /* Настроить VOS = High */
-    SET_BIT(PWR->CSR4, PWR_CSR4_VOS_Msk);
-    while (!READ_BIT(PWR->CSR4, PWR_CSR4_VOSRDY_Msk))
-        continue;
+    dwt_deadline_start(&deadline, PWR_READY_TIMEOUT);
+    state = PWR_STATE_SUPPLY;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Продолжить инициализацию PWR
+ *
+ * @return          Статус:
+ *                      - PWR_ERROR
+ *                      - PWR_BUSY
+ *                      - PWR_OK
+ */
+int32_t pwr_process(void)
+{
+    switch (state) {
+    case PWR_STATE_SUPPLY:
+        /* Ожидание готовности Power Supply */
+        if (!READ_BIT(PWR->SR1, PWR_SR1_ACTVOSRDY_Msk))
+            return dwt_deadline_expired(&deadline) ? PWR_ERROR : PWR_BUSY;
+
+        /* Настроить VOS = High */
+        SET_BIT(PWR->CSR4, PWR_CSR4_VOS_Msk);
+
+        dwt_deadline_start(&deadline, PWR_READY_TIMEOUT);
+
+        state = PWR_STATE_VOS;
+        return PWR_BUSY;
+
+    case PWR_STATE_VOS:
+        /* Ожидание готовности VOS */
+        if (!READ_BIT(PWR->CSR4, PWR_CSR4_VOSRDY_Msk))
+            return dwt_deadline_expired(&deadline) ? PWR_ERROR : PWR_BUSY;
+
+        state = PWR_STATE_READY;
+        return PWR_OK;
+
+    default:
+        return PWR_OK;
+    }
 }
 /* ------------------------------------------------------------------------- */
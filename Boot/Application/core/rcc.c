@@ -18,22 +18,116 @@
 /* Includes ---------------------------------------------------------------- */
 
 #include "rcc.h"
-#include "systick.h"
+#include "dwt.h"
 
 /* Private macros ---------------------------------------------------------- */
 
+/* Значение RGE по частоте ref_ck: 1..2MHz, 2..4MHz, 4..8MHz, 8..16MHz */
+#define RCC_PLL_RGE(ref)        ((ref) <= 2000000 ? 0x00 :                  \
+                                 (ref) <= 4000000 ? 0x01 :                  \
+                                 (ref) <= 8000000 ? 0x02 : 0x03)
+
+/* Значение CPRE/BMPRE по делителю (RCC_PRE_INVALID - делитель недопустим) */
+#define RCC_PRE(div)            ((div) == 1   ? 0x00 : (div) == 2   ? 0x08 :   \
+                                 (div) == 4   ? 0x09 : (div) == 8   ? 0x0A :   \
+                                 (div) == 16  ? 0x0B : (div) == 64  ? 0x0C :   \
+                                 (div) == 128 ? 0x0D : (div) == 256 ? 0x0E :   \
+                                 (div) == 512 ? 0x0F : RCC_PRE_INVALID)
+
+/* Значение PPRE по делителю (RCC_PRE_INVALID - делитель недопустим) */
+#define RCC_PPRE(div)           ((div) == 1 ? 0x00 : (div) == 2  ? 0x04 :     \
+                                 (div) == 4 ? 0x05 : (div) == 8  ? 0x06 :     \
+                                 (div) == 16 ? 0x07 : RCC_PRE_INVALID)
+
 /* Private constants ------------------------------------------------------- */
 
-#define RCC_HSERDY_TIMEOUT       100
-#define RCC_LSERDY_TIMEOUT       5000
+#define RCC_HSERDY_TIMEOUT       10000  /* Запуск HSE (мкс) */
+#define RCC_LSERDY_TIMEOUT       5000000 /* Запуск LSE (мкс) */
+#define RCC_PLLRDY_TIMEOUT       1000   /* Захват частоты PLL (мкс) */
+#define RCC_SWS_TIMEOUT          100    /* Переключение источника CPU (мкс) */
+
+#define RCC_PRE_INVALID          0xFF
+
+/* Допустимые значения PLL (VCO = High) */
+#define RCC_PLL_REF_MIN_CLOCK    2000000
+#define RCC_PLL_REF_MAX_CLOCK    16000000
+#define RCC_PLL_VCO_MIN_CLOCK    384000000
+#define RCC_PLL_VCO_MAX_CLOCK    1672000000
+#define RCC_PLL_DIVM_MAX         63
+#define RCC_PLL_DIVN_MIN         8
+#define RCC_PLL_DIVN_MAX         420
+#define RCC_PLL_DIV_MAX          128
+
+/* Максимальные частоты (VOS = High) */
+#define RCC_CPU_MAX_CLOCK        600000000
+#define RCC_BUS_MATRIX_MAX_CLOCK 300000000
+#define RCC_APB_MAX_CLOCK        150000000
+#define RCC_XSPI_MAX_CLOCK       200000000
+
+/* Проверка конфигурации тактирования (rcc.h) */
+_Static_assert(RCC_PLL1_DIVM >= 1 && RCC_PLL1_DIVM <= RCC_PLL_DIVM_MAX
+            && RCC_HSE_CLOCK % RCC_PLL1_DIVM == 0,
+               "PLL1: DIVM out of range or ref1_ck is not integer");
+_Static_assert(RCC_PLL1_REF_CLOCK >= RCC_PLL_REF_MIN_CLOCK
+            && RCC_PLL1_REF_CLOCK <= RCC_PLL_REF_MAX_CLOCK,
+               "PLL1: ref1_ck out of range");
+_Static_assert(RCC_PLL1_DIVN >= RCC_PLL_DIVN_MIN && RCC_PLL1_DIVN <= RCC_PLL_DIVN_MAX
+            && RCC_PLL1_VCO_CLOCK >= RCC_PLL_VCO_MIN_CLOCK
+            && RCC_PLL1_VCO_CLOCK <= RCC_PLL_VCO_MAX_CLOCK,
+               "PLL1: VCO out of range");
+_Static_assert((RCC_PLL1_DIVP == 1 || RCC_PLL1_DIVP % 2 == 0)
+            && RCC_PLL1_DIVP <= RCC_PLL_DIV_MAX
+            && RCC_PLL1_VCO_CLOCK % RCC_PLL1_DIVP == 0,
+               "PLL1: DIVP must be 1 or even and divide VCO exactly");
+
+_Static_assert(RCC_PLL2_DIVM >= 1 && RCC_PLL2_DIVM <= RCC_PLL_DIVM_MAX
+            && RCC_HSE_CLOCK % RCC_PLL2_DIVM == 0,
+               "PLL2: DIVM out of range or ref2_ck is not integer");
+_Static_assert(RCC_PLL2_REF_CLOCK >= RCC_PLL_REF_MIN_CLOCK
+            && RCC_PLL2_REF_CLOCK <= RCC_PLL_REF_MAX_CLOCK,
+               "PLL2: ref2_ck out of range");
+_Static_assert(RCC_PLL2_DIVN >= RCC_PLL_DIVN_MIN && RCC_PLL2_DIVN <= RCC_PLL_DIVN_MAX
+            && RCC_PLL2_VCO_CLOCK >= RCC_PLL_VCO_MIN_CLOCK
+            && RCC_PLL2_VCO_CLOCK <= RCC_PLL_VCO_MAX_CLOCK,
+               "PLL2: VCO out of range");
+_Static_assert(RCC_PLL2_DIVT >= 1 && RCC_PLL2_DIVT <= RCC_PLL_DIV_MAX
+            && RCC_PLL2_VCO_CLOCK % RCC_PLL2_DIVT == 0,
+               "PLL2: DIVT must divide VCO exactly");
+
+_Static_assert(RCC_PRE(RCC_CPU_DIVIDER) != RCC_PRE_INVALID
+            && RCC_PRE(RCC_BUS_MATRIX_DIVIDER) != RCC_PRE_INVALID
+            && RCC_PPRE(RCC_APB1_DIVIDER) != RCC_PRE_INVALID
+            && RCC_PPRE(RCC_APB2_DIVIDER) != RCC_PRE_INVALID
+            && RCC_PPRE(RCC_APB4_DIVIDER) != RCC_PRE_INVALID
+            && RCC_PPRE(RCC_APB5_DIVIDER) != RCC_PRE_INVALID,
+               "Bus divider is not supported by CPRE/BMPRE/PPRE");
+_Static_assert(RCC_CPU_CLOCK <= RCC_CPU_MAX_CLOCK
+            && RCC_BUS_MATRIX_CLOCK <= RCC_BUS_MATRIX_MAX_CLOCK
+            && RCC_APB1_CLOCK <= RCC_APB_MAX_CLOCK
+            && RCC_APB2_CLOCK <= RCC_APB_MAX_CLOCK
+            && RCC_APB4_CLOCK <= RCC_APB_MAX_CLOCK
+            && RCC_APB5_CLOCK <= RCC_APB_MAX_CLOCK
+            && RCC_XSPI_CLOCK <= RCC_XSPI_MAX_CLOCK,
+               "Bus clock exceeds VOS High limit");
 
 /* Private types ----------------------------------------------------------- */
 
+/**
+ * @brief           Определение перечисления состояний инициализации RCC
+ */
+enum rcc_state {
+    RCC_STATE_HSE,
+    RCC_STATE_PLL,
+    RCC_STATE_READY,
+};
+
 /* Private variables ------------------------------------------------------- */
 
-/* Private function prototypes --------------------------------------------- */
+static enum rcc_state state;
 
-static void rcc_setup_hse(void);
+static struct dwt_deadline deadline;
+
+/* Private function prototypes --------------------------------------------- */
 
 static void rcc_setup_pll(void);
 
@@ -44,40 +138,165 @@ static void rcc_setup_clksource_cpu(void);
 /* Private user code ------------------------------------------------------- */
 
 /**
- * @brief           Инициализировать RCC
+ * @brief           Запустить инициализацию RCC
+ *
+ * @note            Функция не ожидает готовности HSE и PLL,
+ *                  завершение выполняется в rcc_process(),
+ *                  переключение CPU выполняется в rcc_setup_cpu_clock()
  */
 void rcc_init(void)
 {
-    rcc_setup_hse();
+    /* Включить HSE */
+    SET_BIT(RCC->CR, RCC_CR_HSEON_Msk);
+
+    dwt_deadline_start(&deadline, RCC_HSERDY_TIMEOUT);
+
+    /* Настроить PLL1..2 пока HSE стабилизируется */
     rcc_setup_pll();
+
+    state = RCC_STATE_HSE;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Продолжить инициализацию RCC
+ *
+ * @return          Статус:
+ *                      - RCC_ERROR
+ *                      - RCC_BUSY
+ *                      - RCC_OK
+ */
+int32_t rcc_process(void)
+{
+    switch (state) {
+    case RCC_STATE_HSE:
+        /* Ожидание готовности HSE */
+        if (!READ_BIT(RCC->CR, RCC_CR_HSERDY_Msk)) {
+            if (dwt_deadline_expired(&deadline))
+                return RCC_ERROR;
+
+            return RCC_BUSY;
+        }
+
+        /* Включить CSS HSE */
+        SET_BIT(RCC->CR, RCC_CR_HSECSSON_Msk);
+
+        /* Включить PLL1..2 одновременно */
+        SET_BIT(RCC->CR,
+                RCC_CR_PLL1ON_Msk
+              | RCC_CR_PLL2ON_Msk);
+
+        dwt_deadline_start(&deadline, RCC_PLLRDY_TIMEOUT);
+        state = RCC_STATE_PLL;
+        return RCC_BUSY;
+
+    case RCC_STATE_PLL:
+        /* Ожидание готовности PLL1..2 */
+        if (READ_BIT(RCC->CR, RCC_CR_PLL1RDY_Msk | RCC_CR_PLL2RDY_Msk) !=
+                (RCC_CR_PLL1RDY_Msk | RCC_CR_PLL2RDY_Msk))
+            return dwt_deadline_expired(&deadline) ? RCC_ERROR : RCC_BUSY;
+
+        state = RCC_STATE_READY;
+        return RCC_OK;
+
+    default:
+        return RCC_OK;
+    }
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Переключить тактирование CPU на PLL1
+ *
+ * @note            Вызывается после готовности RCC (rcc_process)
+ *                  и PWR (VOS = High)
+ */
+void rcc_setup_cpu_clock(void)
+{
     rcc_setup_bus();
     rcc_setup_clksource_cpu();
 }
 /* ------------------------------------------------------------------------- */
 
 /**
- * @brief           Настроить HSE
+ * @brief           Получить частоту CPU
+ *
+ * @return          Частота (Гц)
  */
-static void rcc_setup_hse(void)
+uint32_t rcc_get_cpu_hz(void)
 {
-    /* Включить HSE */
-    SET_BIT(RCC->CR, RCC_CR_HSEON_Msk);
+    return RCC_CPU_CLOCK;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Получить частоту AXI/AHB
+ *
+ * @return          Частота (Гц)
+ */
+uint32_t rcc_get_bus_matrix_hz(void)
+{
+    return RCC_BUS_MATRIX_CLOCK;
+}
+/* ------------------------------------------------------------------------- */
 
-    /* Ожидание готовности HSE */
-    uint32_t tickstart = systick_get_tick();
+/**
+ * @brief           Получить частоту APB1
+ *
+ * @return          Частота (Гц)
+ */
+uint32_t rcc_get_apb1_hz(void)
+{
+    return RCC_APB1_CLOCK;
+}
+/* ------------------------------------------------------------------------- */
 
-    while (!READ_BIT(RCC->CR, RCC_CR_HSERDY_Msk)) {
-        if (systick_get_tick() - tickstart >= RCC_HSERDY_TIMEOUT)
-            error();
-    }
+/**
+ * @brief           Получить частоту APB2
+ *
+ * @return          Частота (Гц)
+ */
+uint32_t rcc_get_apb2_hz(void)
+{
+    return RCC_APB2_CLOCK;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Получить частоту APB4
+ *
+ * @return          Частота (Гц)
+ */
+uint32_t rcc_get_apb4_hz(void)
+{
+    return RCC_APB4_CLOCK;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Получить частоту APB5
+ *
+ * @return          Частота (Гц)
+ */
+uint32_t rcc_get_apb5_hz(void)
+{
+    return RCC_APB5_CLOCK;
+}
+/* ------------------------------------------------------------------------- */
 
-    /* Включить CSS HSE */
-    SET_BIT(RCC->CR, RCC_CR_HSECSSON_Msk);
+/**
+ * @brief           Получить частоту ядра XSPI2
+ *
+ * @return          Частота (Гц)
+ */
+uint32_t rcc_get_xspi_hz(void)
+{
+    return RCC_XSPI_CLOCK;
 }
 /* ------------------------------------------------------------------------- */
 
 /**
- * @brief           Настроить PLL
+ * @brief           Настроить PLL (без включения)
  */
 static void rcc_setup_pll(void)
 {
@@ -89,17 +308,18 @@ static void rcc_setup_pll(void)
 
     /* Настроить источник тактирования и делители DIVM */
     WRITE_REG(RCC->PLLCKSELR,
-              0x02 << RCC_PLLCKSELR_PLLSRC_Pos                  /* Источник тактирования = HSE (24MHz) */
-            | 0x0C << RCC_PLLCKSELR_DIVM1_Pos                   /* DIVM1 = 24MHz / 12 = 2MHz */
-            | 0x04 << RCC_PLLCKSELR_DIVM2_Pos);                 /* DIVM2 = 24MHz / 4 = 6MHz */
+              0x02 << RCC_PLLCKSELR_PLLSRC_Pos                  /* Источник тактирования = HSE */
+            | RCC_PLL1_DIVM << RCC_PLLCKSELR_DIVM1_Pos
+            | RCC_PLL2_DIVM << RCC_PLLCKSELR_DIVM2_Pos);
 
 
     /* PLL1 ---------------------------------------------------------------- */
 
     /* Настроить RGE и VCO */
     MODIFY_REG(RCC->PLLCFGR,
-               RCC_PLLCFGR_PLL1RGE_Msk,                         /* RGE = 1MHz..2MHz */
-               RCC_PLLCFGR_PLL1VCOSEL_Msk);                     /* VCO = High (384MHz..1672MHz, ref1_ck = 2MHz..16MHz) */
+               RCC_PLLCFGR_PLL1RGE_Msk,
+               RCC_PLLCFGR_PLL1VCOSEL_Msk                       /* VCO = High (384MHz..1672MHz, ref1_ck = 2MHz..16MHz) */
+             | RCC_PLL_RGE(RCC_PLL1_REF_CLOCK) << RCC_PLLCFGR_PLL1RGE_Pos);
 
     /* Настроить Fractional */
     CLEAR_BIT(RCC->PLLCFGR, RCC_PLLCFGR_PLL1FRACEN_Msk);
@@ -111,19 +331,14 @@ static void rcc_setup_pll(void)
     /* Настроить DIVN */
     MODIFY_REG(RCC->PLL1DIVR1,
                RCC_PLL1DIVR1_DIVN_Msk,
-               (300 - 1) << RCC_PLL1DIVR1_DIVN_Pos);            /* DIVN = 2MHz * 300 = 600MHz */
+               (RCC_PLL1_DIVN - 1) << RCC_PLL1DIVR1_DIVN_Pos);
 
     /* Включить и настроить DIVP */
     SET_BIT(RCC->PLLCFGR, RCC_PLLCFGR_PLL1PEN_Msk);
 
     MODIFY_REG(RCC->PLL1DIVR1,
                RCC_PLL1DIVR1_DIVP_Msk,
-               (1 - 1) << RCC_PLL1DIVR1_DIVP_Pos);              /* DIVP = 600MHz / 1 = 600MHz */
-
-    /* Включить PLL */
-    SET_BIT(RCC->CR, RCC_CR_PLL1ON_Msk);
-    while (!READ_BIT(RCC->CR, RCC_CR_PLL1RDY_Msk))
-        continue;
+               (RCC_PLL1_DIVP - 1) << RCC_PLL1DIVR1_DIVP_Pos);
 
 
     /* PLL2 ---------------------------------------------------------------- */
@@ -132,7 +347,7 @@ static void rcc_setup_pll(void)
     MODIFY_REG(RCC->PLLCFGR,
                RCC_PLLCFGR_PLL2RGE_Msk,
                RCC_PLLCFGR_PLL2VCOSEL_Msk                       /* VCO = High (384MHz..1672MHz, ref2_ck = 2MHz..16MHz) */
-             | 0x02 << RCC_PLLCFGR_PLL2RGE_Pos);                /* RGE = 4MHz..8MHz */
+             | RCC_PLL_RGE(RCC_PLL2_REF_CLOCK) << RCC_PLLCFGR_PLL2RGE_Pos);
 
     /* Настроить Fractional */
     CLEAR_BIT(RCC->PLLCFGR, RCC_PLLCFGR_PLL2FRACEN_Msk);
@@ -144,19 +359,14 @@ static void rcc_setup_pll(void)
     /* Настроить DIVN */
     MODIFY_REG(RCC->PLL2DIVR1,
                RCC_PLL2DIVR1_DIVN_Msk,
-               (100 - 1) << RCC_PLL2DIVR1_DIVN_Pos);            /* DIVN = 6MHz * 100 = 600MHz */
+               (RCC_PLL2_DIVN - 1) << RCC_PLL2DIVR1_DIVN_Pos);
 
     /* Включить и настроить DIVT */
     SET_BIT(RCC->PLLCFGR, RCC_PLLCFGR_PLL2TEN_Msk);
 
     MODIFY_REG(RCC->PLL2DIVR2,
                RCC_PLL2DIVR2_DIVT_Msk,
-               (3 - 1) << RCC_PLL2DIVR2_DIVT_Pos);              /* DIVT = 600MHz / 3 = 200MHz */
-
-    /* Включить PLL */
-    SET_BIT(RCC->CR, RCC_CR_PLL2ON_Msk);
-    while (!READ_BIT(RCC->CR, RCC_CR_PLL2RDY_Msk))
-        continue;
+               (RCC_PLL2_DIVT - 1) << RCC_PLL2DIVR2_DIVT_Pos);
 }
 /* ------------------------------------------------------------------------- */
 
@@ -166,19 +376,20 @@ static void rcc_setup_pll(void)
 static void rcc_setup_bus(void)
 {
     /* Настроить делитель CPU */
-    CLEAR_REG(RCC->CDCFGR);                         /* CPU = 600MHz / 1 = 600MHz */
+    WRITE_REG(RCC->CDCFGR,
+              RCC_PRE(RCC_CPU_DIVIDER) << RCC_CDCFGR_CPRE_Pos);
 
     /* Настроить делитель Bus Matrix */
     MODIFY_REG(RCC->BMCFGR,
                RCC_BMCFGR_BMPRE_Msk,
-               0x08 << RCC_BMCFGR_BMPRE_Pos);       /* Bus Matrix = 600MHz / 2 = 300MHz */
+               RCC_PRE(RCC_BUS_MATRIX_DIVIDER) << RCC_BMCFGR_BMPRE_Pos);
 
     /* Настроить делители APB */
     WRITE_REG(RCC->APBCFGR,
-              0x04 << RCC_APBCFGR_PPRE1_Pos         /* APB1 = 300MHz / 2 = 150MHz */
-            | 0x04 << RCC_APBCFGR_PPRE2_Pos         /* APB2 = 300MHz / 2 = 150MHz */
-            | 0x04 << RCC_APBCFGR_PPRE4_Pos         /* APB4 = 300MHz / 2 = 150MHz */
-            | 0x04 << RCC_APBCFGR_PPRE5_Pos);       /* APB5 = 300MHz / 2 = 150MHz */
+              RCC_PPRE(RCC_APB1_DIVIDER) << RCC_APBCFGR_PPRE1_Pos
+            | RCC_PPRE(RCC_APB2_DIVIDER) << RCC_APBCFGR_PPRE2_Pos
+            | RCC_PPRE(RCC_APB4_DIVIDER) << RCC_APBCFGR_PPRE4_Pos
+            | RCC_PPRE(RCC_APB5_DIVIDER) << RCC_APBCFGR_PPRE5_Pos);
 }
 /* ------------------------------------------------------------------------- */
 
@@ -192,8 +403,15 @@ static void rcc_setup_clksource_cpu(void)
                RCC_CFGR_SW_Msk,
                0x03 << RCC_CFGR_SW_Pos);
 
+    struct dwt_deadline sws;
+
+    dwt_deadline_start(&sws, RCC_SWS_TIMEOUT);
+
     while (READ_BIT(RCC->CFGR, RCC_CFGR_SWS_Msk) !=
-            0x03 << RCC_CFGR_SWS_Pos)
-        continue;
+            0x03 << RCC_CFGR_SWS_Pos) {
+        /* CPU не переключился на PLL1 */
+        if (dwt_deadline_expired(&sws))
+            error();
+    }
 }
 /* ------------------------------------------------------------------------- */
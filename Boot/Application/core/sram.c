@@ -0,0 +1,194 @@
+/**
+ * Copyright (C) 2025 zhmaksim <zhiharev.maxim.alexandrovich@yandex.ru>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/* Includes ---------------------------------------------------------------- */
+
+#include "sram.h"
+#include "systick.h"
+
+/* Private macros ---------------------------------------------------------- */
+
+/* Private constants ------------------------------------------------------- */
+
+#define SRAM_TIMEOUT            100
+
+#define SRAM_REGION_COUNT       4
+
+/* Резерв стека Boot под текущим SP на время заполнения DTCM через DMA (байт) */
+#define SRAM_STACK_GUARD        0x1000
+
+/* Резерв под кадром sram_scrub_wait() при заполнении остатка DTCM CPU (байт) */
+#define SRAM_STACK_MARGIN       64
+
+/* Private types ----------------------------------------------------------- */
+
+/**
+ * @brief           Определение структуры данных заполняемой области
+ */
+struct sram_region {
+    struct dma dma;                             /*!< Передача нулей в область */
+
+    uint32_t end;                               /*!< Адрес конца области */
+
+    bool busy;                                  /*!< Заполнение выполняется */
+};
+
+/* Private variables ------------------------------------------------------- */
+
+/* Символы скрипта компоновщика */
+extern uint32_t _ebss_dma[];
+extern uint32_t _end[];
+extern uint32_t _eitcm_text[];
+
+static struct sram_region region[SRAM_REGION_COUNT] = {
+    { .dma.channel = HPDMA1_Channel1 },         /* AXI SRAM */
+    { .dma.channel = HPDMA1_Channel2 },         /* SRAM_AHB */
+    { .dma.channel = HPDMA1_Channel3 },         /* DTCM */
+    { .dma.channel = HPDMA1_Channel4 },         /* ITCM */
+};
+
+/* Private function prototypes --------------------------------------------- */
+
+static void sram_scrub_region(struct sram_region *area, uint32_t start, uint32_t end);
+
+static void sram_fill_zero(uint32_t start, uint32_t end);
+
+/* Private user code ------------------------------------------------------- */
+
+/**
+ * @brief           Запустить заполнение нулями неиспользуемой ОЗУ
+ *
+ * @note            ОЗУ защищены ECC (RAMECC1/RAMECC2): чтение или запись
+ *                  части слова, не записанного после включения питания,
+ *                  вызывают ошибку ECC. HPDMA1 заполняет AXI SRAM, SRAM_AHB
+ *                  (после .bss_dma), DTCM (после данных Boot до стека) и ITCM
+ *                  (после кода Boot, область загрузки сжатого образа: LZ4
+ *                  записывает байты) словами 64 бит, четырьмя каналами
+ *                  одновременно, пока CPU настраивает тактирование.
+ *                  Вызывается до включения D-Cache
+ */
+void sram_scrub_start(void)
+{
+    uint32_t stack = (__get_MSP() - SRAM_STACK_GUARD) & ~0x07;
+
+    sram_scrub_region(&region[0], SRAM_AXI_ADDRESS, SRAM_AXI_ADDRESS + SRAM_AXI_LENGTH);
+    sram_scrub_region(&region[1], (uint32_t) _ebss_dma, SRAM_AHB_ADDRESS + SRAM_AHB_LENGTH);
+    sram_scrub_region(&region[2], (uint32_t) _end, stack);
+    sram_scrub_region(&region[3], (uint32_t) _eitcm_text, SRAM_ITCM_ADDRESS + SRAM_ITCM_LENGTH);
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Продолжить заполнение
+ *
+ * @return          Статус:
+ *                      - SRAM_BUSY
+ *                      - SRAM_OK
+ *
+ * @note            При ошибке DMA остаток области заполняется CPU
+ */
+int32_t sram_scrub_process(void)
+{
+    int32_t result = SRAM_OK;
+
+    for (uint32_t i = 0; i < SRAM_REGION_COUNT; i++) {
+        if (!region[i].busy)
+            continue;
+
+        int32_t status = dma_process(&region[i].dma);
+
+        if (status == DMA_BUSY) {
+            result = SRAM_BUSY;
+            continue;
+        } else if (status != DMA_OK) {
+            /* Заполнить остаток, начиная с блока, переданного с ошибкой */
+            sram_fill_zero(region[i].dma.dst, region[i].end);
+        }
+
+        region[i].busy = false;
+    }
+
+    return result;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Дождаться завершения заполнения
+ *
+ * @return          Статус:
+ *                      - SRAM_ERROR
+ *                      - SRAM_OK
+ *
+ * @note            Резерв стека под SP, оставленный на время работы DMA,
+ *                  заполняется CPU: стек App начинается там же
+ */
+int32_t sram_scrub_wait(void)
+{
+    uint32_t tickstart = systick_get_tick();
+
+    while (sram_scrub_process() == SRAM_BUSY) {
+        if (systick_get_tick() - tickstart >= SRAM_TIMEOUT)
+            return SRAM_ERROR;
+    }
+
+    sram_fill_zero(region[2].end, (__get_MSP() - SRAM_STACK_MARGIN) & ~0x07);
+
+    return SRAM_OK;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Запустить заполнение области
+ *
+ * @param[in]       area: Указатель на структуру данных области
+ * @param[in]       start: Адрес начала области
+ * @param[in]       end: Адрес конца области
+ *
+ * @note            Источник DMA - первое двойное слово области, обнуленное CPU
+ */
+static void sram_scrub_region(struct sram_region *area, uint32_t start, uint32_t end)
+{
+    start = (start + 0x07) & ~0x07;
+    end &= ~0x07;
+
+    area->end = end;
+    area->busy = false;
+
+    if (end <= start + 8) {
+        sram_fill_zero(start, end);
+        return;
+    }
+
+    *(volatile uint64_t *) start = 0;
+
+    dma_start(&area->dma, start, start + 8, end - start - 8, DMA_DST_INC | DMA_WIDTH_64);
+    area->busy = true;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Заполнить область нулями (CPU)
+ *
+ * @param[in]       start: Адрес начала области (кратно 8)
+ * @param[in]       end: Адрес конца области (кратно 8)
+ */
+static void sram_fill_zero(uint32_t start, uint32_t end)
+{
+    for (volatile uint64_t *p = (uint64_t *) start; p < (uint64_t *) end; p++)
+        *p = 0;
+}
+/* ------------------------------------------------------------------------- */
@@ -0,0 +1,139 @@
+/**
+ * Copyright (C) 2025 zhmaksim <zhiharev.maxim.alexandrovich@yandex.ru>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/* Includes ---------------------------------------------------------------- */
+
+#include "standby.h"
+
+/* Private macros ---------------------------------------------------------- */
+
+/* Private constants ------------------------------------------------------- */
+
+/* Private types ----------------------------------------------------------- */
+
+/* Private variables ------------------------------------------------------- */
+
+static struct standby_state *const state = (struct standby_state *) STANDBY_STATE_ADDRESS;
+
+static bool resume;
+
+/* Private function prototypes --------------------------------------------- */
+
+static bool standby_is_valid(void);
+
+static uint32_t standby_checksum(const struct standby_state *block);
+
+/* Private user code ------------------------------------------------------- */
+
+/**
+ * @brief           Определить пробуждение по RTC из Standby
+ *
+ * @note            Запуск считается пробуждением, если установлены PWR SBF
+ *                  и RTC WUTF, а App сохранила состояние перед Standby.
+ *                  Время запуска (RTC_TR, RTC_SSR) записывается в состояние:
+ *                  пробуждение совпадает с началом секунды ck_spre, App
+ *                  рассчитывает по нему задержки. Иначе состояние
+ *                  сбрасывается - цикл пробуждений прерван.
+ *                  Вызывается после telemetry_init() (доступ к SRAM_BKP)
+ */
+void standby_init(void)
+{
+    bool standby = READ_BIT(PWR->CSR3, PWR_CSR3_SBF_Msk);
+
+    /* Сбросить флаги Standby/Stop для следующего запуска */
+    SET_BIT(PWR->CSR3, PWR_CSR3_CSSF_Msk);
+
+    /* Включить тактирование интерфейса RTC (регистры RTC сохраняются в Standby) */
+    SET_BIT(RCC->APB4ENR, RCC_APB4ENR_RTCAPBEN_Msk);
+    (void) READ_REG(RCC->APB4ENR);
+
+    /* App настраивает RTC с BYPSHAD: чтение счетчиков без ожидания RSF */
+    uint32_t ssr;
+    uint32_t tr;
+
+    do {
+        ssr = READ_REG(RTC->SSR);
+        tr = READ_REG(RTC->TR);
+    } while (ssr != READ_REG(RTC->SSR));
+
+    resume = standby
+          && READ_BIT(RTC->SR, RTC_SR_WUTF_Msk)
+          && standby_is_valid();
+
+    if (!resume) {
+        state->magic = 0;
+        return;
+    }
+
+    state->wake = true;
+    state->wake_tr = tr;
+    state->wake_ssr = ssr;
+    state->fast_resume = false;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Получить состояние App при пробуждении из Standby
+ *
+ * @return          Указатель на состояние (NULL - холодный запуск)
+ */
+const struct standby_state *standby_get_resume(void)
+{
+    return resume ? state : NULL;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Отметить запуск образа без проверки подписи
+ */
+void standby_set_fast_resume(void)
+{
+    if (resume)
+        state->fast_resume = true;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Проверить состояние, сохраненное App
+ *
+ * @return          Признак корректного состояния
+ */
+static bool standby_is_valid(void)
+{
+    return state->magic == STANDBY_STATE_MAGIC
+        && state->checksum == standby_checksum(state);
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Вычислить контрольную сумму состояния
+ *
+ * @param[in]       block: Указатель на состояние
+ * @return          Контрольная сумма
+ */
+static uint32_t standby_checksum(const struct standby_state *block)
+{
+    const uint32_t *word = (const uint32_t *) block;
+    uint32_t checksum = 0;
+
+    /* Все слова после magic до checksum */
+    for (uint32_t i = 1; i < offsetof(struct standby_state, checksum) / 4; i++)
+        checksum = (checksum << 5 | checksum >> 27) ^ word[i];
+
+    return checksum;
+}
+/* ------------------------------------------------------------------------- */
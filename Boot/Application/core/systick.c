@@ -23,14 +23,31 @@
 
 /* Private constants ------------------------------------------------------- */
 
+#define SYSTICK_NS_PER_TICK      1000000
+#define SYSTICK_NS_SHIFT         22             /* ns = такты * ns_scale >> SYSTICK_NS_SHIFT */
+
 /* Private types ----------------------------------------------------------- */
 
 /* Private variables ------------------------------------------------------- */
 
 static volatile uint32_t tick;
+static volatile uint32_t tick_high;             /* Старшее слово 64-битного счетчика тиков */
+static volatile uint32_t tick_cycles;           /* CYCCNT в начале текущего тика */
+
+static volatile uint32_t cycles_high;           /* Старшее слово 64-битного счетчика тактов */
+static volatile uint32_t cycles_last;           /* CYCCNT при последнем обновлении */
+
+static volatile uint32_t ns_scale;              /* Длительность такта CPU (нс << SYSTICK_NS_SHIFT) */
+
+/* Номер обновления: чтение повторяется, если обновление произошло во время чтения */
+static volatile uint32_t sequence;
 
 /* Private function prototypes --------------------------------------------- */
 
+static void systick_advance(const uint32_t ticks);
+
+static void systick_set_ns_scale(const uint32_t frequency);
+
 /* Private user code ------------------------------------------------------- */
 
 /**
@@ -38,9 +55,15 @@ static volatile uint32_t tick;
  */
 void systick_init(const uint32_t frequency)
 {
+    /* Повторная инициализация: незавершенный период считается тиком,
+     * время не убывает */
+    bool running = READ_BIT(SysTick->CTRL, SysTick_CTRL_ENABLE_Msk);
+
     /* Сбросить регистр управления */
     CLEAR_REG(SysTick->CTRL);
 
+    systick_set_ns_scale(frequency);
+
     /* Установить значение перезагрузки счетчика = 1 мс */
     WRITE_REG(SysTick->LOAD, (frequency / 1000) - 1);
 
@@ -52,6 +75,13 @@ void systick_init(const uint32_t frequency)
               SysTick_CTRL_CLKSOURCE_Msk
             | SysTick_CTRL_TICKINT_Msk
             | SysTick_CTRL_ENABLE_Msk);
+
+    if (running) {
+        systick_advance(1);
+    } else {
+        cycles_last = READ_REG(DWT->CYCCNT);
+        tick_cycles = cycles_last;
+    }
 }
 /* ------------------------------------------------------------------------- */
 
@@ -63,7 +93,7 @@ void systick_it_handler(void)
     /* Если счетчик таймера достиг нулевого значения */
     if (READ_BIT(SysTick->CTRL, SysTick_CTRL_COUNTFLAG_Msk)) {
         /* Изменить значение системного таймера */
-        ++tick;
+        systick_advance(1);
 
         /* Вызвать функцию обратного вызова */
         systick_period_elapsed_callback();
@@ -82,6 +112,141 @@ inline uint32_t systick_get_tick(void)
 }
 /* ------------------------------------------------------------------------- */
 
+/**
+ * @brief           Получить значение 64-битного системного таймера
+ *
+ * @return          Значение таймера (тиков)
+ */
+uint64_t systick_get_tick64(void)
+{
+    uint32_t seq;
+    uint32_t low;
+    uint32_t high;
+
+    do {
+        seq = sequence;
+        low = tick;
+        high = tick_high;
+    } while (seq != sequence);
+
+    return (uint64_t) high << 32 | low;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Получить 64-битное значение счетчика тактов CPU
+ *
+ * @return          Значение счетчика (DWT CYCCNT, дополненный старшим словом)
+ *
+ * @note            Безопасно в любом контексте. Старшее слово обновляется
+ *                  каждый тик, переполнение CYCCNT между тиками учитывается
+ *                  при чтении
+ */
+uint64_t systick_get_cycles(void)
+{
+    uint32_t seq;
+    uint32_t high;
+    uint32_t last;
+    uint32_t cycles;
+
+    do {
+        seq = sequence;
+        high = cycles_high;
+        last = cycles_last;
+        cycles = READ_REG(DWT->CYCCNT);
+    } while (seq != sequence);
+
+    if (cycles < last)
+        high++;
+
+    return (uint64_t) high << 32 | cycles;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Получить монотонное время от запуска
+ *
+ * @return          Время (нс)
+ *
+ * @note            Безопасно в любом контексте. Тики задают миллисекунды,
+ *                  DWT CYCCNT от начала тика - доли миллисекунды. Доля
+ *                  ограничена длительностью тика: время не убывает, если
+ *                  прерывание SysTick ожидает обработки
+ */
+uint64_t systick_get_ns(void)
+{
+    uint32_t seq;
+    uint32_t low;
+    uint32_t high;
+    uint32_t start;
+    uint32_t scale;
+    uint32_t cycles;
+
+    do {
+        seq = sequence;
+        low = tick;
+        high = tick_high;
+        start = tick_cycles;
+        scale = ns_scale;
+        cycles = READ_REG(DWT->CYCCNT);
+    } while (seq != sequence);
+
+    uint32_t ns = (uint64_t) (cycles - start) * scale >> SYSTICK_NS_SHIFT;
+
+    if (ns >= SYSTICK_NS_PER_TICK)
+        ns = SYSTICK_NS_PER_TICK - 1;
+
+    return ((uint64_t) high << 32 | low) * SYSTICK_NS_PER_TICK + ns;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Учесть тики и обновить 64-битные счетчики
+ *
+ * @param[in]       ticks: Количество тиков
+ *
+ * @note            Выполняется с запретом прерываний: чтение в прерывании
+ *                  с более высоким приоритетом видит согласованные значения
+ */
+static void systick_advance(const uint32_t ticks)
+{
+    uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+
+    uint32_t cycles = READ_REG(DWT->CYCCNT);
+
+    if (cycles < cycles_last)
+        cycles_high++;
+
+    cycles_last = cycles;
+
+    /* Начало тика: SysTick считает такты CPU от значения перезагрузки */
+    tick_cycles = cycles - (READ_REG(SysTick->LOAD) - READ_REG(SysTick->VAL));
+
+    uint32_t next = tick + ticks;
+
+    if (next < tick)
+        tick_high++;
+
+    tick = next;
+    sequence++;
+
+    __set_PRIMASK(primask);
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Настроить перевод тактов CPU в нс
+ *
+ * @param[in]       frequency: Частота CPU (Гц, кратно 1MHz)
+ */
+static void systick_set_ns_scale(const uint32_t frequency)
+{
+    ns_scale = (1000UL << SYSTICK_NS_SHIFT) / (frequency / 1000000);
+}
+/* ------------------------------------------------------------------------- */
+
 __WEAK void systick_period_elapsed_callback(void)
 {
 
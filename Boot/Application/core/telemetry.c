@@ -0,0 +1,107 @@
+/**
+ * Copyright (C) 2025 zhmaksim <zhiharev.maxim.alexandrovich@yandex.ru>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/* Includes ---------------------------------------------------------------- */
+
+#include "telemetry.h"
+#include "dwt.h"
+
+/* Private macros ---------------------------------------------------------- */
+
+/* Private constants ------------------------------------------------------- */
+
+/* Private types ----------------------------------------------------------- */
+
+/* Private variables ------------------------------------------------------- */
+
+static struct telemetry *const telemetry = (struct telemetry *) TELEMETRY_ADDRESS;
+
+/* Private function prototypes --------------------------------------------- */
+
+static uint32_t telemetry_checksum(void);
+
+/* Private user code ------------------------------------------------------- */
+
+/**
+ * @brief           Инициализировать запись телеметрии загрузки
+ */
+void telemetry_init(void)
+{
+    /* Выключить защиту от записи Backup домена */
+    SET_BIT(PWR->CR1, PWR_CR1_DBP_Msk);
+
+    /* Включить тактирование BKPSRAM */
+    SET_BIT(RCC->AHB4ENR, RCC_AHB4ENR_BKPRAMEN_Msk);
+
+    /* Сбросить запись (признак записывается последним в telemetry_commit) */
+    telemetry->magic = 0;
+    telemetry->version = TELEMETRY_VERSION;
+    telemetry->size = sizeof(struct telemetry);
+
+    for (uint32_t i = 0; i < TELEMETRY_STAGE_COUNT; i++) {
+        telemetry->stamp[i].cycles = 0;
+        telemetry->stamp[i].frequency = 0;
+    }
+
+    telemetry->checksum = 0;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Зафиксировать завершение этапа загрузки
+ *
+ * @param[in]       stage: Этап @ref enum telemetry_stage
+ * @param[in]       frequency: Частота CPU во время этапа (Гц)
+ */
+void telemetry_stamp(uint32_t stage, uint32_t frequency)
+{
+    assert(stage < TELEMETRY_STAGE_COUNT);
+
+    telemetry->stamp[stage].cycles = dwt_get_cycles();
+    telemetry->stamp[stage].frequency = frequency;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Завершить запись телеметрии загрузки
+ */
+void telemetry_commit(void)
+{
+    telemetry->checksum = telemetry_checksum();
+    telemetry->magic = TELEMETRY_MAGIC;
+
+    __DSB();
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Вычислить контрольную сумму записи
+ *
+ * @return          Контрольная сумма
+ */
+static uint32_t telemetry_checksum(void)
+{
+    uint32_t checksum = telemetry->version ^ telemetry->size;
+
+    for (uint32_t i = 0; i < TELEMETRY_STAGE_COUNT; i++) {
+        checksum = (checksum << 5 | checksum >> 27) ^ telemetry->stamp[i].cycles;
+        checksum = (checksum << 5 | checksum >> 27) ^ telemetry->stamp[i].frequency;
+    }
+
+    return checksum;
+}
+/* ------------------------------------------------------------------------- */
@@ -0,0 +1,242 @@
+/**
+ * Copyright (C) 2025 zhmaksim <zhiharev.maxim.alexandrovich@yandex.ru>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/* Includes ---------------------------------------------------------------- */
+
+#include "usart.h"
+#include "rcc.h"
+
+/* Private macros ---------------------------------------------------------- */
+
+/* Private constants ------------------------------------------------------- */
+
+#define USART_VCP               USART3
+#define USART_DMA               GPDMA1_Channel0
+
+/* Запрос GPDMA1 usart3_rx_dma: RM0477, глава GPDMA, таблица
+ * "Programmed GPDMA1 request", строка 29 (значение CTR2.REQSEL).
+ * Номера запросов зависят от серии: при переносе сверить с RM серии */
+#define USART_DMA_REQUEST       29
+
+/* Private types ----------------------------------------------------------- */
+
+/**
+ * @brief           Определение структуры данных узла связанного списка GPDMA
+ */
+struct usart_lli {
+    uint32_t cbr1;                              /*!< Размер блока */
+
+    uint32_t cdar;                              /*!< Адрес приемника */
+
+    uint32_t cllr;                              /*!< Адрес следующего узла */
+};
+
+
+/**
+ * @brief           Определение структуры данных приема в двойной буфер
+ */
+struct usart_rx {
+    void *buffer[2];                            /*!< Указатели на буферы */
+
+    uint32_t size;                              /*!< Размер буфера (байт) */
+
+    uint32_t index;                             /*!< Индекс заполняемого буфера */
+};
+
+/* Private variables ------------------------------------------------------- */
+
+static struct usart_rx rx;
+
+static struct usart_lli lli[2] __DMA_BUFFER;
+
+/* Private function prototypes --------------------------------------------- */
+
+static void usart_restart_receive(void);
+
+/* Private user code ------------------------------------------------------- */
+
+/**
+ * @brief           Инициализировать USART (ST-LINK VCP)
+ */
+void usart_init(void)
+{
+    /* Включить тактирование */
+    SET_BIT(RCC->APB1ENR1, RCC_APB1ENR1_USART3EN_Msk);
+
+    /* Выключить USART перед настройкой */
+    CLEAR_REG(USART_VCP->CR1);
+
+    /* Настроить скорость (ядро USART тактируется от PCLK1) */
+    WRITE_REG(USART_VCP->BRR, (RCC_APB1_CLOCK + USART_BAUDRATE / 2) / USART_BAUDRATE);
+
+    /* Включить запросы DMA приема, потерянные байты выявляются
+     * контрольной суммой кадра */
+    WRITE_REG(USART_VCP->CR3,
+              USART_CR3_DMAR_Msk
+            | USART_CR3_OVRDIS_Msk);
+
+    /* Включить FIFO, приемник, передатчик и USART */
+    WRITE_REG(USART_VCP->CR1,
+              USART_CR1_FIFOEN_Msk
+            | USART_CR1_TE_Msk
+            | USART_CR1_RE_Msk
+            | USART_CR1_UE_Msk);
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Запустить прием в двойной буфер
+ *
+ * @param[in]       buffer0: Указатель на первый буфер (SRAM_AHB, @ref __DMA_BUFFER)
+ * @param[in]       buffer1: Указатель на второй буфер (SRAM_AHB, @ref __DMA_BUFFER)
+ * @param[in]       size: Размер каждого буфера (байт)
+ *
+ * @note            GPDMA переключает буферы по связанному списку без участия
+ *                  CPU, заполненный буфер возвращает @ref usart_receive
+ */
+void usart_start_receive(void *buffer0, void *buffer1, uint32_t size)
+{
+    rx.buffer[0] = buffer0;
+    rx.buffer[1] = buffer1;
+    rx.size = size;
+
+    /* Узлы списка загружают CBR1, CDAR и CLLR следующего блока */
+    for (uint32_t i = 0; i < 2; i++) {
+        lli[i].cbr1 = size << DMA_CBR1_BNDT_Pos;
+        lli[i].cdar = (uint32_t) rx.buffer[i];
+        lli[i].cllr = ((uint32_t) &lli[i ^ 1] & DMA_CLLR_LA_Msk)
+                    | DMA_CLLR_UB1_Msk
+                    | DMA_CLLR_UDA_Msk
+                    | DMA_CLLR_ULL_Msk;
+    }
+
+    usart_restart_receive();
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Получить заполненный буфер приема
+ *
+ * @param[out]      buffer: Указатель на заполненный буфер
+ * @return          Статус:
+ *                      - USART_ERROR (неполный блок по паузе на линии, прием перезапущен)
+ *                      - USART_BUSY
+ *                      - USART_OK
+ */
+int32_t usart_receive(void **buffer)
+{
+    if (READ_BIT(USART_DMA->CSR, DMA_CSR_TCF_Msk)) {
+        WRITE_REG(USART_DMA->CFCR, DMA_CFCR_TCF_Msk);
+
+        *buffer = rx.buffer[rx.index];
+        rx.index ^= 1;
+
+        return USART_OK;
+    }
+
+    if (READ_BIT(USART_DMA->CSR,
+                 DMA_CSR_DTEF_Msk
+               | DMA_CSR_ULEF_Msk
+               | DMA_CSR_USEF_Msk)) {
+        usart_restart_receive();
+        return USART_ERROR;
+    }
+
+    if (READ_BIT(USART_VCP->ISR, USART_ISR_IDLE_Msk)) {
+        WRITE_REG(USART_VCP->ICR, USART_ICR_IDLECF_Msk);
+
+        /* Пауза посреди блока - начать прием блока заново */
+        if ((READ_REG(USART_DMA->CBR1) & DMA_CBR1_BNDT_Msk) != rx.size) {
+            usart_restart_receive();
+            return USART_ERROR;
+        }
+    }
+
+    return USART_BUSY;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Передать данные
+ *
+ * @param[in]       data: Указатель на данные
+ * @param[in]       size: Размер данных (байт)
+ */
+void usart_transmit(const void *data, uint32_t size)
+{
+    const uint8_t *pdata = data;
+
+    while (size > 0) {
+        /* Ожидание места в FIFO передатчика */
+        while (!READ_BIT(USART_VCP->ISR, USART_ISR_TXE_TXFNF_Msk))
+            continue;
+
+        WRITE_REG(USART_VCP->TDR, *pdata);
+
+        pdata++;
+        size--;
+    }
+
+    /* Ожидание завершения передачи */
+    while (!READ_BIT(USART_VCP->ISR, USART_ISR_TC_Msk))
+        continue;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Перезапустить прием с первого буфера
+ */
+static void usart_restart_receive(void)
+{
+    /* Сбросить канал */
+    SET_BIT(USART_DMA->CCR, DMA_CCR_RESET_Msk);
+
+    /* Сбросить флаги канала */
+    WRITE_REG(USART_DMA->CFCR,
+              DMA_CFCR_TCF_Msk
+            | DMA_CFCR_HTF_Msk
+            | DMA_CFCR_DTEF_Msk
+            | DMA_CFCR_ULEF_Msk
+            | DMA_CFCR_USEF_Msk
+            | DMA_CFCR_SUSPF_Msk
+            | DMA_CFCR_TOF_Msk);
+
+    /* Отбросить принятые байты */
+    SET_BIT(USART_VCP->RQR, USART_RQR_RXFRQ_Msk);
+    WRITE_REG(USART_VCP->ICR, USART_ICR_IDLECF_Msk);
+
+    /* Настроить ширину данных = 8 бит и инкремент адреса приемника */
+    WRITE_REG(USART_DMA->CTR1, DMA_CTR1_DINC_Msk);
+
+    /* Настроить запрос USART RX, событие завершения - по каждому блоку */
+    WRITE_REG(USART_DMA->CTR2, USART_DMA_REQUEST << DMA_CTR2_REQSEL_Pos);
+
+    /* Настроить первый блок */
+    WRITE_REG(USART_DMA->CBR1, rx.size << DMA_CBR1_BNDT_Pos);
+    WRITE_REG(USART_DMA->CSAR, (uint32_t) &USART_VCP->RDR);
+    WRITE_REG(USART_DMA->CDAR, (uint32_t) rx.buffer[0]);
+
+    /* Настроить связанный список (узлы в одном сегменте 64KB) */
+    WRITE_REG(USART_DMA->CLBAR, (uint32_t) &lli[0] & DMA_CLBAR_LBA_Msk);
+    WRITE_REG(USART_DMA->CLLR, lli[0].cllr);
+
+    rx.index = 0;
+
+    /* Включить канал */
+    SET_BIT(USART_DMA->CCR, DMA_CCR_EN_Msk);
+}
+/* ------------------------------------------------------------------------- */
@@ -0,0 +1,464 @@
+/**
+ * Copyright (C) 2025 zhmaksim <zhiharev.maxim.alexandrovich@yandex.ru>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/* Includes ---------------------------------------------------------------- */
+
+#include "image.h"
+#include "image_key.h"
+#include "hash.h"
+#include "pka.h"
+#include "rcc.h"
+#include "telemetry.h"
+#include "lz4.h"
+#include "cache.h"
+
+/* Private macros ---------------------------------------------------------- */
+
+/* Private constants ------------------------------------------------------- */
+
+#if IMAGE_RELEASE && IMAGE_KEY_DEVELOPMENT
+#error "image_key.h: ключ разработки в сборке выпуска (Tools/ecdsa_tool.py export)"
+#endif
+
+/* Private types ----------------------------------------------------------- */
+
+/* Private variables ------------------------------------------------------- */
+
+static const uint32_t image_slot[IMAGE_SLOT_COUNT] = {
+    IMAGE_SLOT_A_ADDRESS,
+    IMAGE_SLOT_B_ADDRESS,
+};
+
+static struct image_state *const state = (struct image_state *) IMAGE_STATE_ADDRESS;
+
+/* Открытый ключ проверки подписи (Tools/ecdsa_tool.py export) */
+static const uint8_t image_public_key[2 * PKA_P256_SIZE] = IMAGE_PUBLIC_KEY;
+
+/* SHA-256 подписанных полей заголовка выбранного образа (передается App) */
+static uint8_t image_header_digest[IMAGE_DIGEST_SIZE];
+
+extern uint32_t _eitcm_text[];
+
+/* Private function prototypes --------------------------------------------- */
+
+static uint32_t image_get_version(uint32_t slot);
+
+static int32_t image_check_header(uint32_t slot);
+
+static int32_t image_check_load_region(const struct image_header *header);
+
+static int32_t image_check_reset_vector(const struct image_header *header);
+
+static int32_t image_verify(const struct image_header *header);
+
+static int32_t image_verify_signature(const struct image_header *header);
+
+static int32_t image_hash_header(const struct image_header *header);
+
+static int32_t image_verify_digest(const struct image_header *header);
+
+static bool image_is_unconfirmed(uint32_t slot, const struct image_header *header);
+
+static void image_update_state(uint32_t slot, const struct image_header *header);
+
+/* Private user code ------------------------------------------------------- */
+
+/**
+ * @brief           Выбрать и проверить образ App
+ *
+ * @param[out]      header: Указатель на заголовок выбранного образа
+ * @return          Статус:
+ *                      - IMAGE_ERROR
+ *                      - IMAGE_OK
+ *
+ * @note            Слоты проверяются в порядке убывания версии образа.
+ *                  Слот, не подтвердивший IMAGE_BOOT_ATTEMPTS запусков,
+ *                  пропускается, пока есть другой корректный образ
+ */
+int32_t image_select(const struct image_header **header)
+{
+    bool failed[IMAGE_SLOT_COUNT] = { false };
+    uint32_t order[IMAGE_SLOT_COUNT] = { 0, 1 };
+
+    /* Проверять сначала более новый образ */
+    if (image_get_version(1) > image_get_version(0)) {
+        order[0] = 1;
+        order[1] = 0;
+    }
+
+    for (uint32_t pass = 0; pass < 2; pass++) {
+        for (uint32_t i = 0; i < IMAGE_SLOT_COUNT; i++) {
+            uint32_t slot = order[i];
+            const struct image_header *slot_header = (const struct image_header *) image_slot[slot];
+
+            if (failed[slot])
+                continue;
+
+            /* Первый проход: пропустить неподтвержденный образ */
+            if (pass == 0 && image_is_unconfirmed(slot, slot_header))
+                continue;
+
+            if (image_check_header(slot) != IMAGE_OK || image_verify(slot_header) != IMAGE_OK) {
+                failed[slot] = true;
+                continue;
+            }
+
+            image_update_state(slot, slot_header);
+
+            *header = slot_header;
+            return IMAGE_OK;
+        }
+    }
+
+    return IMAGE_ERROR;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Выбрать образ, запущенный до перехода в Standby
+ *
+ * @param[in]       address: Адрес заголовка образа
+ * @param[in]       image_version: Версия образа
+ * @param[in]       header_digest: SHA-256 подписанных полей заголовка
+ * @param[out]      header: Указатель на заголовок образа
+ * @return          Статус:
+ *                      - IMAGE_ERROR
+ *                      - IMAGE_OK
+ *
+ * @note            Подпись заголовка не проверяется: образ проверен
+ *                  image_select() при холодном запуске, App сохранила
+ *                  SHA-256 подписанных полей заголовка (блок передачи Boot)
+ *                  в SRAM_BKP. SHA-256 полей magic...digest заголовка в слоте
+ *                  должен совпадать с сохраненным - все поля заголовка
+ *                  остаются защищенными. SHA-256 образа в слоте
+ *                  рассчитывается заново (содержимое FLASH не защищено
+ *                  подписью до следующего холодного запуска), иначе
+ *                  выполняется полная проверка. Пробуждение не считается
+ *                  попыткой запуска
+ */
+int32_t image_resume(uint32_t address, uint32_t image_version, const uint8_t *header_digest, const struct image_header **header)
+{
+    uint32_t slot;
+    uint8_t diff = 0;
+
+    for (slot = 0; slot < IMAGE_SLOT_COUNT; slot++) {
+        if (image_slot[slot] == address)
+            break;
+    }
+
+    if (slot == IMAGE_SLOT_COUNT)
+        return IMAGE_ERROR;
+
+    const struct image_header *slot_header = (const struct image_header *) image_slot[slot];
+
+    if (state->magic != IMAGE_STATE_MAGIC
+            || state->slot != slot
+            || state->image_version != image_version) {
+        return IMAGE_ERROR;
+    }
+
+    if (image_check_header(slot) != IMAGE_OK || slot_header->image_version != image_version)
+        return IMAGE_ERROR;
+
+    if (image_hash_header(slot_header) != IMAGE_OK)
+        return IMAGE_ERROR;
+
+    for (uint32_t i = 0; i < IMAGE_DIGEST_SIZE; i++)
+        diff |= header_digest[i] ^ image_header_digest[i];
+
+    if (diff != 0 || image_verify_digest(slot_header) != IMAGE_OK)
+        return IMAGE_ERROR;
+
+    *header = slot_header;
+    return IMAGE_OK;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Загрузить выбранный образ App
+ *
+ * @param[in]       header: Указатель на заголовок образа (@ref image_select)
+ * @return          Статус:
+ *                      - IMAGE_ERROR
+ *                      - IMAGE_OK
+ *
+ * @note            Образ XIP выполняется на месте. Сжатый образ читается
+ *                  через memory-mapped окно XSPI и распаковывается в ITCM/SRAM
+ */
+int32_t image_load(const struct image_header *header)
+{
+    if (!(header->flags & IMAGE_FLAG_LZ4))
+        return IMAGE_OK;
+
+    const void *src = (const uint8_t *) header + header->header_size;
+    void *dst = (void *) header->vector_address;
+
+    if (lz4_decompress(src, header->image_size, dst, header->load_size) != LZ4_OK)
+        return IMAGE_ERROR;
+
+    /* Записать образ из D-Cache в память до выборки инструкций */
+    cache_clean(dst, header->load_size);
+
+    return image_check_reset_vector(header);
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Получить SHA-256 подписанных полей заголовка выбранного образа
+ *
+ * @return          Указатель на дайджест (IMAGE_DIGEST_SIZE байт)
+ *
+ * @note            Действителен после успешного image_select() или
+ *                  image_resume(). App сохраняет его перед переходом в Standby
+ */
+const uint8_t *image_get_header_digest(void)
+{
+    return image_header_digest;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Получить версию образа слота
+ *
+ * @param[in]       slot: Номер слота
+ * @return          Версия образа (0 - заголовок отсутствует)
+ */
+static uint32_t image_get_version(uint32_t slot)
+{
+    const struct image_header *header = (const struct image_header *) image_slot[slot];
+
+    return header->magic == IMAGE_HEADER_MAGIC ? header->image_version : 0;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Проверить заголовок образа
+ *
+ * @param[in]       slot: Номер слота
+ * @return          Статус:
+ *                      - IMAGE_ERROR
+ *                      - IMAGE_OK
+ */
+static int32_t image_check_header(uint32_t slot)
+{
+    const struct image_header *header = (const struct image_header *) image_slot[slot];
+
+    if (header->magic != IMAGE_HEADER_MAGIC) {
+        return IMAGE_ERROR;
+    } else if (header->version != IMAGE_HEADER_VERSION) {
+        return IMAGE_ERROR;
+    } else if (header->header_size != IMAGE_HEADER_SIZE) {
+        return IMAGE_ERROR;
+    } else if (header->image_size == 0 || header->image_size > IMAGE_SLOT_SIZE - IMAGE_HEADER_SIZE) {
+        return IMAGE_ERROR;
+    } else if (header->flags & IMAGE_FLAG_LZ4) {
+        /* Вектор сброса сжатого образа проверяется после распаковки */
+        return image_check_load_region(header);
+    } else if (header->flags != 0 || header->load_size != header->image_size) {
+        return IMAGE_ERROR;
+    } else if (header->vector_address != image_slot[slot] + IMAGE_HEADER_SIZE) {
+        return IMAGE_ERROR;
+    } else {
+        return image_check_reset_vector(header);
+    }
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Проверить область загрузки сжатого образа
+ *
+ * @param[in]       header: Указатель на заголовок образа
+ * @return          Статус:
+ *                      - IMAGE_ERROR
+ *                      - IMAGE_OK
+ *
+ * @note            Данные Boot размещены в DTCM, поэтому SRAM полностью
+ *                  доступна для образа, ITCM - после кода Boot (.itcm_text).
+ *                  Обе области заполнены sram_scrub_start(): распаковка
+ *                  записывает байты и не вызывает ошибку ECC
+ */
+static int32_t image_check_load_region(const struct image_header *header)
+{
+    uint32_t address = header->vector_address;
+    uint32_t size = header->load_size;
+    uint32_t itcm_end = IMAGE_ITCM_ADDRESS + IMAGE_ITCM_SIZE;
+
+    if (size == 0 || (address & 0x3FF) != 0) {
+        return IMAGE_ERROR;
+    } else if (address < itcm_end) {
+        if (address < (uint32_t) _eitcm_text)
+            return IMAGE_ERROR;
+
+        return size <= itcm_end - address ? IMAGE_OK : IMAGE_ERROR;
+    } else if (address - IMAGE_SRAM_ADDRESS < IMAGE_SRAM_SIZE) {
+        return size <= IMAGE_SRAM_SIZE - (address - IMAGE_SRAM_ADDRESS) ? IMAGE_OK : IMAGE_ERROR;
+    } else {
+        return IMAGE_ERROR;
+    }
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Проверить, что вектор сброса указывает внутрь образа
+ *
+ * @param[in]       header: Указатель на заголовок образа
+ * @return          Статус:
+ *                      - IMAGE_ERROR
+ *                      - IMAGE_OK
+ */
+static int32_t image_check_reset_vector(const struct image_header *header)
+{
+    uint32_t reset = *(const uint32_t *) (header->vector_address + 4) & ~0x01;
+
+    if (reset < header->vector_address || reset >= header->vector_address + header->load_size) {
+        return IMAGE_ERROR;
+    } else {
+        return IMAGE_OK;
+    }
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Проверить подлинность и целостность образа
+ *
+ * @param[in]       header: Указатель на заголовок образа
+ * @return          Статус:
+ *                      - IMAGE_ERROR
+ *                      - IMAGE_OK
+ *
+ * @note            Подпись заголовка проверяется первой: образ с чужим
+ *                  ключом отклоняется без расчета SHA-256 всего образа
+ */
+static int32_t image_verify(const struct image_header *header)
+{
+    if (image_verify_signature(header) != IMAGE_OK)
+        return IMAGE_ERROR;
+
+    telemetry_stamp(TELEMETRY_STAGE_IMAGE_SIGNATURE, RCC_CPU_CLOCK);
+
+    return image_verify_digest(header);
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Проверить подпись заголовка образа (ECDSA P-256)
+ *
+ * @param[in]       header: Указатель на заголовок образа
+ * @return          Статус:
+ *                      - IMAGE_ERROR
+ *                      - IMAGE_OK
+ *
+ * @note            Дайджест полей magic...digest рассчитывает HASH,
+ *                  проверку подписи - PKA. Поле digest связывает подпись
+ *                  заголовка с содержимым образа
+ */
+static int32_t image_verify_signature(const struct image_header *header)
+{
+    if (image_hash_header(header) != IMAGE_OK)
+        return IMAGE_ERROR;
+
+    if (pka_ecdsa_verify_p256(image_public_key, image_header_digest, header->signature) != PKA_OK)
+        return IMAGE_ERROR;
+
+    return IMAGE_OK;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Рассчитать SHA-256 подписанных полей заголовка
+ *
+ * @param[in]       header: Указатель на заголовок образа
+ * @return          Статус:
+ *                      - IMAGE_ERROR
+ *                      - IMAGE_OK
+ *
+ * @note            Результат сохраняется для App (@ref image_get_header_digest)
+ */
+static int32_t image_hash_header(const struct image_header *header)
+{
+    if (hash_sha256(header, offsetof(struct image_header, signature), image_header_digest) != HASH_OK)
+        return IMAGE_ERROR;
+
+    return IMAGE_OK;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Проверить SHA-256 образа в слоте
+ *
+ * @param[in]       header: Указатель на заголовок образа
+ * @return          Статус:
+ *                      - IMAGE_ERROR
+ *                      - IMAGE_OK
+ *
+ * @note            Рассчитывается по данным слота (header + header_size):
+ *                  для сжатого образа vector_address указывает на область
+ *                  загрузки, еще не заполненную распаковкой
+ */
+static int32_t image_verify_digest(const struct image_header *header)
+{
+    uint8_t digest[HASH_SHA256_SIZE];
+    uint8_t diff = 0;
+
+    if (hash_sha256((const uint8_t *) header + header->header_size, header->image_size, digest) != HASH_OK)
+        return IMAGE_ERROR;
+
+    for (uint32_t i = 0; i < IMAGE_DIGEST_SIZE; i++)
+        diff |= digest[i] ^ header->digest[i];
+
+    telemetry_stamp(TELEMETRY_STAGE_IMAGE_DIGEST, RCC_CPU_CLOCK);
+
+    return diff == 0 ? IMAGE_OK : IMAGE_ERROR;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Проверить, исчерпал ли образ попытки запуска без подтверждения
+ *
+ * @param[in]       slot: Номер слота
+ * @param[in]       header: Указатель на заголовок образа
+ * @return          Признак неподтвержденного образа
+ */
+static bool image_is_unconfirmed(uint32_t slot, const struct image_header *header)
+{
+    return state->magic == IMAGE_STATE_MAGIC
+        && state->slot == slot
+        && state->image_version == header->image_version
+        && state->attempts >= IMAGE_BOOT_ATTEMPTS;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Обновить состояние запуска образа
+ *
+ * @param[in]       slot: Номер слота
+ * @param[in]       header: Указатель на заголовок образа
+ */
+static void image_update_state(uint32_t slot, const struct image_header *header)
+{
+    if (state->magic == IMAGE_STATE_MAGIC
+            && state->slot == slot
+            && state->image_version == header->image_version) {
+        state->attempts++;
+    } else {
+        state->slot = slot;
+        state->image_version = header->image_version;
+        state->attempts = 1;
+        state->magic = IMAGE_STATE_MAGIC;
+    }
+}
+/* ------------------------------------------------------------------------- */
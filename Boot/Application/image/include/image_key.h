@@ -0,0 +1,26 @@
+/**
+ * Открытый ключ ECDSA P-256 для проверки подписи образа App.
+ *
+ * Сформирован Tools/ecdsa_tool.py export из image_key.pem,
+ * формат: x || y (big-endian)
+ */
+
+#ifndef IMAGE_KEY_H_
+#define IMAGE_KEY_H_
+
+/* 1 - ключ разработки: закрытый ключ опубликован, сборка с IMAGE_RELEASE запрещена */
+#define IMAGE_KEY_DEVELOPMENT           1
+
+#define IMAGE_PUBLIC_KEY                                \
+{                                                       \
+    0x6A, 0x78, 0xF6, 0x13, 0x98, 0x3E, 0x3E, 0x38,     \
+    0x5C, 0xCF, 0x4C, 0xC4, 0x99, 0xF1, 0x8D, 0x3C,     \
+    0xF8, 0x98, 0x55, 0x80, 0x2D, 0x1D, 0xE8, 0x2C,     \
+    0x94, 0xAF, 0xF6, 0x7E, 0x28, 0x0E, 0xE1, 0x63,     \
+    0x69, 0x6F, 0x2C, 0x2A, 0x48, 0x01, 0x3E, 0x00,     \
+    0xEF, 0x33, 0x2C, 0xD7, 0x1D, 0x0B, 0xCA, 0x79,     \
+    0x81, 0x33, 0x41, 0x92, 0x33, 0x6B, 0x95, 0xD9,     \
+    0x07, 0xDD, 0xB8, 0x62, 0xA7, 0x08, 0xAE, 0x20      \
+}
+
+#endif /* IMAGE_KEY_H_ */
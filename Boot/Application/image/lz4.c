@@ -0,0 +1,168 @@
+/**
+ * Copyright (C) 2025 zhmaksim <zhiharev.maxim.alexandrovich@yandex.ru>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/* Includes ---------------------------------------------------------------- */
+
+#include "lz4.h"
+
+/* Private macros ---------------------------------------------------------- */
+
+/* Private constants ------------------------------------------------------- */
+
+#define LZ4_MIN_MATCH                   4
+
+/* Private types ----------------------------------------------------------- */
+
+/* Private variables ------------------------------------------------------- */
+
+/* Private function prototypes --------------------------------------------- */
+
+static int32_t lz4_read_length(const uint8_t **ip, const uint8_t *ip_end, uint32_t *length);
+
+static inline void lz4_copy(uint8_t *dst, const uint8_t *src, uint32_t size);
+
+/* Private user code ------------------------------------------------------- */
+
+/**
+ * @brief           Распаковать блок LZ4
+ *
+ * @param[in]       src: Указатель на сжатые данные (блочный формат LZ4)
+ * @param[in]       src_size: Размер сжатых данных (байт)
+ * @param[out]      dst: Указатель на буфер распакованных данных
+ * @param[in]       dst_size: Ожидаемый размер распакованных данных (байт)
+ * @return          Статус:
+ *                      - LZ4_ERROR
+ *                      - LZ4_OK
+ *
+ * @note            Все длины и смещения проверяются, поврежденный блок
+ *                  не приводит к записи за пределы dst
+ */
+int32_t lz4_decompress(const void *src, uint32_t src_size, void *dst, uint32_t dst_size)
+{
+    const uint8_t *ip = src;
+    const uint8_t *const ip_end = ip + src_size;
+    uint8_t *op = dst;
+    uint8_t *const op_start = dst;
+    uint8_t *const op_end = op + dst_size;
+
+    while (ip < ip_end) {
+        uint32_t token = *ip++;
+
+        /* Литералы */
+        uint32_t length = token >> 4;
+
+        if (length == 15 && lz4_read_length(&ip, ip_end, &length) != LZ4_OK)
+            return LZ4_ERROR;
+
+        if (length > (uint32_t) (ip_end - ip) || length > (uint32_t) (op_end - op))
+            return LZ4_ERROR;
+
+        lz4_copy(op, ip, length);
+        ip += length;
+        op += length;
+
+        /* Последняя последовательность содержит только литералы */
+        if (ip == ip_end)
+            break;
+
+        /* Совпадение */
+        if (ip_end - ip < 2)
+            return LZ4_ERROR;
+
+        uint32_t offset = ip[0] | ip[1] << 8;
+        ip += 2;
+
+        if (offset == 0 || offset > (uint32_t) (op - op_start))
+            return LZ4_ERROR;
+
+        length = token & 0x0F;
+
+        if (length == 15 && lz4_read_length(&ip, ip_end, &length) != LZ4_OK)
+            return LZ4_ERROR;
+
+        length += LZ4_MIN_MATCH;
+
+        if (length > (uint32_t) (op_end - op))
+            return LZ4_ERROR;
+
+        if (offset >= 4) {
+            lz4_copy(op, op - offset, length);
+        } else {
+            /* Перекрытие источника и приемника ближе слова - побайтно */
+            const uint8_t *match = op - offset;
+
+            for (uint32_t i = 0; i < length; i++)
+                op[i] = match[i];
+        }
+
+        op += length;
+    }
+
+    return op == op_end ? LZ4_OK : LZ4_ERROR;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Прочитать продолжение длины (байты 255 ... 255, N)
+ *
+ * @param[in,out]   ip: Указатель на текущую позицию сжатых данных
+ * @param[in]       ip_end: Указатель на конец сжатых данных
+ * @param[in,out]   length: Длина
+ * @return          Статус:
+ *                      - LZ4_ERROR
+ *                      - LZ4_OK
+ */
+static int32_t lz4_read_length(const uint8_t **ip, const uint8_t *ip_end, uint32_t *length)
+{
+    uint32_t value;
+
+    do {
+        if (*ip >= ip_end)
+            return LZ4_ERROR;
+
+        value = *(*ip)++;
+        *length += value;
+    } while (value == 255);
+
+    return LZ4_OK;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Копировать данные словами
+ *
+ * @param[out]      dst: Указатель на приемник
+ * @param[in]       src: Указатель на источник
+ * @param[in]       size: Размер (байт)
+ *
+ * @note            Cortex-M7 выполняет невыровненные LDR/STR в Normal памяти,
+ *                  при копировании совпадения src должен отставать от dst
+ *                  не менее чем на слово
+ */
+static inline void lz4_copy(uint8_t *dst, const uint8_t *src, uint32_t size)
+{
+    while (size >= 4) {
+        __UNALIGNED_UINT32_WRITE(dst, __UNALIGNED_UINT32_READ(src));
+        dst += 4;
+        src += 4;
+        size -= 4;
+    }
+
+    while (size--)
+        *dst++ = *src++;
+}
+/* ------------------------------------------------------------------------- */
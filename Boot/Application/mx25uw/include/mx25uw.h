@@ -145,8 +145,19 @@ extern "C" {
 #define MX25UW_OPI_WRITE_BUFFER_INITIAL                 0x22DD          /* OPI Write Buffer Initial */
 #define MX25UW_OPI_WRITE_BUFFER_CONTINUE                0x24DB          /* OPI Write Buffer Continue */
 
+#define MX25UW_SR_WIP_Msk                               0x01            /* Write In Progress */
+
+#define MX25UW_FBR_FBE_Msk                              0x00000001      /* Fast Boot Enable (0 - включен) */
+#define MX25UW_FBR_FBSD_Pos                             1
+#define MX25UW_FBR_FBSD_Msk                             0x00000006      /* Fast Boot Start Delay */
+#define MX25UW_FBR_FBSA_Msk                             0xFFFFFFF0      /* Fast Boot Start Address (выравнивание 16 байт) */
+
+#define MX25UW_FAST_BOOT_FBSD                           0x03            /* Задержка выдачи данных после CS# */
+#define MX25UW_FAST_BOOT_DCYC                           13              /* Такты ожидания для FBSD = 11 */
+
 #define MX25UW_OK            0
 #define MX25UW_ERROR        -1
+#define MX25UW_BUSY          1
 
 /* Exported types ---------------------------------------------------------- */
 
@@ -177,10 +188,24 @@ struct mx25uw {
 
 int32_t mx25uw_init(void);
 
+int32_t mx25uw_read_fast_boot(void *data, uint32_t size);
+
+int32_t mx25uw_setup_fast_boot(uint32_t address);
+
 int32_t mx25uw_setup_opi_dtr(void);
 
 int32_t mx25uw_setup_memory_mapped_mode(void);
 
+int32_t mx25uw_reset(void);
+
+int32_t mx25uw_exit_memory_mapped_mode(void);
+
+int32_t mx25uw_erase_sector(uint32_t addr);
+
+int32_t mx25uw_program_page(uint32_t addr, const void *data, uint32_t size);
+
+int32_t mx25uw_get_status(void);
+
 /* Exported callback function prototypes ----------------------------------- */
 
 #ifdef __cplusplus
@@ -18,13 +18,15 @@
 /* Includes ---------------------------------------------------------------- */
 
 #include "mx25uw.h"
-#include "systick.h"
+#include "dwt.h"
 
 /* Private macros ---------------------------------------------------------- */
 
 /* Private constants ------------------------------------------------------- */
 
-#define MX25UW_XSPI_TIMEOUT     5000
+#define MX25UW_XSPI_TIMEOUT     1000            /* Операция XSPI (мкс) */
+#define MX25UW_WRITE_TIMEOUT    100000          /* Запись регистра MX25UW (мкс) */
+#define MX25UW_RESET_TIME       100             /* Восстановление после программного сброса (мкс) */
 
 /* Private types ----------------------------------------------------------- */
 
@@ -37,13 +39,19 @@ struct mx25uw mx25uw = {
 
 /* Private function prototypes --------------------------------------------- */
 
+static int32_t mx25uw_check_id(void);
+
 static int32_t mx25uw_read_id(void);
 
 static int32_t mx25uw_write_enable(void);
 
+static int32_t mx25uw_send_command(uint8_t cmd, uint16_t opi_cmd);
+
 static int32_t mx25uw_write_cfg_reg2(uint32_t addr, uint8_t val);
 
-static uint32_t mx25uw_tick(void);
+static int32_t mx25uw_spi_command(uint8_t cmd, uint32_t dcyc, bool read, void *data, uint32_t size);
+
+static int32_t mx25uw_wait_ready(void);
 
 /* Private user code ------------------------------------------------------- */
 
@@ -53,8 +61,37 @@ static uint32_t mx25uw_tick(void);
  * @return          Статус:
  *                      - MX25UW_ERROR
  *                      - MX25UW_OK
+ *
+ * @note            После программного сброса MCU (сбой App, пробуждение из
+ *                  Standby) MX25UW может остаться в режиме OPI DTR и не
+ *                  отвечает на чтение ID в режиме SPI. В этом случае
+ *                  выполняется сброс MX25UW командами OPI DTR и повторное
+ *                  чтение ID в режиме SPI
  */
 int32_t mx25uw_init(void)
+{
+    if (mx25uw_check_id() == MX25UW_OK)
+        return MX25UW_OK;
+
+    mx25uw.interface = MX25UW_OPI_DTR;
+
+    if (mx25uw_reset() < 0) {
+        mx25uw.interface = MX25UW_SPI;
+        return MX25UW_ERROR;
+    }
+
+    return mx25uw_check_id();
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Прочитать и проверить идентификатор производителя
+ *
+ * @return          Статус:
+ *                      - MX25UW_ERROR
+ *                      - MX25UW_OK
+ */
+static int32_t mx25uw_check_id(void)
 {
     if (mx25uw_read_id() < 0) {
         return MX25UW_ERROR;
@@ -75,7 +112,9 @@ int32_t mx25uw_init(void)
  */
 static int32_t mx25uw_read_id(void)
 {
-    uint32_t tickstart = mx25uw_tick();
+    struct dwt_deadline deadline;
+
+    dwt_deadline_start(&deadline, MX25UW_XSPI_TIMEOUT);
 
     /* Размер данных идентификатора */
     uint32_t data_size = sizeof(mx25uw.id);
@@ -86,7 +125,7 @@ static int32_t mx25uw_read_id(void)
 
     /* Ожидание готовности XSPI */
     while (READ_BIT(mx25uw.xspi->SR, XSPI_SR_BUSY_Msk)) {
-        if (mx25uw_tick() - tickstart >= MX25UW_XSPI_TIMEOUT)
+        if (dwt_deadline_expired(&deadline))
             return MX25UW_ERROR;
     }
 
@@ -158,7 +197,7 @@ static int32_t mx25uw_read_id(void)
         while (!READ_BIT(mx25uw.xspi->SR,
                          XSPI_SR_FTF_Msk
                        | XSPI_SR_TCF_Msk)) {
-            if (mx25uw_tick() - tickstart >= MX25UW_XSPI_TIMEOUT)
+            if (dwt_deadline_expired(&deadline))
                 return MX25UW_ERROR;
         }
 
@@ -171,7 +210,7 @@ static int32_t mx25uw_read_id(void)
 
     /* Ожидание завершения операции */
     while (!READ_BIT(mx25uw.xspi->SR, XSPI_SR_TCF_Msk)) {
-        if (mx25uw_tick() - tickstart >= MX25UW_XSPI_TIMEOUT)
+        if (dwt_deadline_expired(&deadline))
             return MX25UW_ERROR;
     }
 
@@ -191,11 +230,28 @@ static int32_t mx25uw_read_id(void)
  */
 static int32_t mx25uw_write_enable(void)
 {
-    uint32_t tickstart = mx25uw_tick();
+    return mx25uw_send_command(MX25UW_WRITE_ENABLE_CMD, MX25UW_OPI_WRITE_ENABLE_CMD);
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Передать команду без адреса и данных
+ *
+ * @param[in]       cmd: Команда в режиме SPI
+ * @param[in]       opi_cmd: Команда в режиме OPI
+ * @return          Статус:
+ *                      - MX25UW_ERROR
+ *                      - MX25UW_OK
+ */
+static int32_t mx25uw_send_command(uint8_t cmd, uint16_t opi_cmd)
+{
+    struct dwt_deadline deadline;
+
+    dwt_deadline_start(&deadline, MX25UW_XSPI_TIMEOUT);
 
     /* Ожидание готовности XSPI */
     while (READ_BIT(mx25uw.xspi->SR, XSPI_SR_BUSY_Msk)) {
-        if (mx25uw_tick() - tickstart >= MX25UW_XSPI_TIMEOUT)
+        if (dwt_deadline_expired(&deadline))
             return MX25UW_ERROR;
     }
 
@@ -214,7 +270,7 @@ static int32_t mx25uw_write_enable(void)
                   0x01 << XSPI_CCR_IMODE_Pos);
 
         /* Настроить IR */
-        WRITE_REG(mx25uw.xspi->IR, MX25UW_WRITE_ENABLE_CMD);
+        WRITE_REG(mx25uw.xspi->IR, cmd);
     } else if (mx25uw.interface == MX25UW_OPI_STR) {
         /* Настоить TCR */
         CLEAR_REG(mx25uw.xspi->TCR);
@@ -225,7 +281,7 @@ static int32_t mx25uw_write_enable(void)
                 | 0x01 << XSPI_CCR_ISIZE_Pos);
 
         /* Настроить IR */
-        WRITE_REG(mx25uw.xspi->IR, MX25UW_OPI_WRITE_ENABLE_CMD);
+        WRITE_REG(mx25uw.xspi->IR, opi_cmd);
     } else if (mx25uw.interface == MX25UW_OPI_DTR) {
         /* Настроить TCR */
         WRITE_REG(mx25uw.xspi->TCR, XSPI_TCR_DHQC_Msk);
@@ -237,14 +293,14 @@ static int32_t mx25uw_write_enable(void)
                 | 0x01 << XSPI_CCR_ISIZE_Pos);
 
         /* Настроить IR */
-        WRITE_REG(mx25uw.xspi->IR, MX25UW_OPI_WRITE_ENABLE_CMD);
+        WRITE_REG(mx25uw.xspi->IR, opi_cmd);
     } else {
         return MX25UW_ERROR;
     }
 
     /* Ожидание завершения операции */
     while (!READ_BIT(mx25uw.xspi->SR, XSPI_SR_TCF_Msk)) {
-        if (mx25uw_tick() - tickstart >= MX25UW_XSPI_TIMEOUT)
+        if (dwt_deadline_expired(&deadline))
             return MX25UW_ERROR;
     }
 
@@ -266,7 +322,9 @@ static int32_t mx25uw_write_enable(void)
  */
 static int32_t mx25uw_write_cfg_reg2(uint32_t addr, uint8_t val)
 {
-    uint32_t tickstart = mx25uw_tick();
+    struct dwt_deadline deadline;
+
+    dwt_deadline_start(&deadline, MX25UW_XSPI_TIMEOUT);
 
     /* Размер данных регистра */
     uint32_t data_size = sizeof(val);
@@ -277,7 +335,7 @@ static int32_t mx25uw_write_cfg_reg2(uint32_t addr, uint8_t val)
 
     /* Ожидание готовности XSPI */
     while (READ_BIT(mx25uw.xspi->SR, XSPI_SR_BUSY_Msk)) {
-        if (mx25uw_tick() - tickstart >= MX25UW_XSPI_TIMEOUT)
+        if (dwt_deadline_expired(&deadline))
             return MX25UW_ERROR;
     }
 
@@ -348,7 +406,7 @@ static int32_t mx25uw_write_cfg_reg2(uint32_t addr, uint8_t val)
     while (data_size > 0) {
         /* Ожидание возможности передачи данных */
         while (!READ_BIT(mx25uw.xspi->SR, XSPI_SR_FTF_Msk)) {
-            if (mx25uw_tick() - tickstart >= MX25UW_XSPI_TIMEOUT)
+            if (dwt_deadline_expired(&deadline))
                 return MX25UW_ERROR;
         }
 
@@ -361,7 +419,156 @@ static int32_t mx25uw_write_cfg_reg2(uint32_t addr, uint8_t val)
 
     /* Ожидание завершения операции */
     while (!READ_BIT(mx25uw.xspi->SR, XSPI_SR_TCF_Msk)) {
-        if (mx25uw_tick() - tickstart >= MX25UW_XSPI_TIMEOUT)
+        if (dwt_deadline_expired(&deadline))
+            return MX25UW_ERROR;
+    }
+
+    /* Очистить статус завершения операции */
+    SET_BIT(mx25uw.xspi->FCR, XSPI_FCR_CTCF_Msk);
+
+    return MX25UW_OK;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Прочитать данные в режиме Fast Boot
+ *
+ * @param[out]      data: Указатель на данные
+ * @param[in]       size: Размер данных (байт)
+ * @return          Статус:
+ *                      - MX25UW_ERROR
+ *                      - MX25UW_OK
+ *
+ * @note            После сброса питания MX25UW с включенным Fast Boot выдает
+ *                  данные с адреса FBSA по первому CS# без команды и адреса.
+ *                  Если Fast Boot выключен или MX25UW не сбрасывалась,
+ *                  данные некорректны и вызывающий выполняет обычную
+ *                  инициализацию (@ref mx25uw_init)
+ */
+int32_t mx25uw_read_fast_boot(void *data, uint32_t size)
+{
+    if (mx25uw.interface != MX25UW_SPI)
+        return MX25UW_ERROR;
+
+    return mx25uw_spi_command(0, MX25UW_FAST_BOOT_DCYC, true, data, size);
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Настроить Fast Boot
+ *
+ * @param[in]       address: Адрес, с которого MX25UW выдает данные после сброса
+ * @return          Статус:
+ *                      - MX25UW_ERROR
+ *                      - MX25UW_OK
+ *
+ * @note            Регистр Fast Boot энергонезависимый, запись выполняется
+ *                  только если его значение отличается. Выполняется в режиме SPI
+ */
+int32_t mx25uw_setup_fast_boot(uint32_t address)
+{
+    uint32_t fbr = (address & MX25UW_FBR_FBSA_Msk)
+                 | MX25UW_FAST_BOOT_FBSD << MX25UW_FBR_FBSD_Pos;
+    uint32_t val;
+
+    if (mx25uw.interface != MX25UW_SPI || (address & ~MX25UW_FBR_FBSA_Msk) != 0)
+        return MX25UW_ERROR;
+
+    if (mx25uw_spi_command(MX25UW_READ_FAST_BOOT_REG_CMD, 0, true, &val, sizeof(val)) < 0)
+        return MX25UW_ERROR;
+
+    /* Зарезервированный бит 3 читается как 1 */
+    if ((val & ~0x08) == fbr)
+        return MX25UW_OK;
+
+    /* Стереть регистр (FBE = 1) и записать новое значение */
+    if (mx25uw_write_enable() < 0) {
+        return MX25UW_ERROR;
+    } else if (mx25uw_spi_command(MX25UW_ERASE_FAST_BOOT_REG_CMD, 0, false, NULL, 0) < 0) {
+        return MX25UW_ERROR;
+    } else if (mx25uw_wait_ready() < 0) {
+        return MX25UW_ERROR;
+    } else if (mx25uw_write_enable() < 0) {
+        return MX25UW_ERROR;
+    } else if (mx25uw_spi_command(MX25UW_WRITE_FAST_BOOT_REG_CMD, 0, false, &fbr, sizeof(fbr)) < 0) {
+        return MX25UW_ERROR;
+    } else {
+        return mx25uw_wait_ready();
+    }
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Выполнить команду в режиме SPI
+ *
+ * @param[in]       cmd: Команда (0 - без фазы команды)
+ * @param[in]       dcyc: Количество тактов ожидания
+ * @param[in]       read: Направление данных (true - прием)
+ * @param[in,out]   data: Указатель на данные (NULL - без фазы данных)
+ * @param[in]       size: Размер данных (байт)
+ * @return          Статус:
+ *                      - MX25UW_ERROR
+ *                      - MX25UW_OK
+ */
+static int32_t mx25uw_spi_command(uint8_t cmd, uint32_t dcyc, bool read, void *data, uint32_t size)
+{
+    struct dwt_deadline deadline;
+
+    dwt_deadline_start(&deadline, MX25UW_XSPI_TIMEOUT);
+
+    /* Указатель на данные */
+    uint8_t *pdata = data;
+    /* Указатель на регистр данных XSPI */
+    volatile uint8_t *DR = (uint8_t *) &mx25uw.xspi->DR;
+
+    /* Ожидание готовности XSPI */
+    while (READ_BIT(mx25uw.xspi->SR, XSPI_SR_BUSY_Msk)) {
+        if (dwt_deadline_expired(&deadline))
+            return MX25UW_ERROR;
+    }
+
+    /* Настроить Functional Mode */
+    MODIFY_REG(mx25uw.xspi->CR,
+               XSPI_CR_FMODE_Msk,
+               (read ? 0x01 : 0x00) << XSPI_CR_FMODE_Pos);
+
+    /* Настроить DLR */
+    WRITE_REG(mx25uw.xspi->DLR, size > 0 ? size - 1 : 0);
+
+    /* Настроить TCR */
+    WRITE_REG(mx25uw.xspi->TCR, dcyc << XSPI_TCR_DCYC_Pos);
+
+    /* Настроить CCR */
+    WRITE_REG(mx25uw.xspi->CCR,
+              (cmd != 0 ? 0x01 : 0x00) << XSPI_CCR_IMODE_Pos
+            | (size > 0 ? 0x01 : 0x00) << XSPI_CCR_DMODE_Pos);
+
+    /* Настроить IR */
+    WRITE_REG(mx25uw.xspi->IR, cmd);
+
+    /* Передать/принять данные */
+    while (size > 0) {
+        /* Ожидание готовности FIFO */
+        while (!READ_BIT(mx25uw.xspi->SR,
+                         XSPI_SR_FTF_Msk
+                       | XSPI_SR_TCF_Msk)) {
+            if (dwt_deadline_expired(&deadline))
+                return MX25UW_ERROR;
+        }
+
+        if (read) {
+            *pdata = *DR;
+        } else {
+            *DR = *pdata;
+        }
+
+        pdata++;
+        size--;
+    }
+
+    /* Ожидание завершения операции */
+    while (!READ_BIT(mx25uw.xspi->SR, XSPI_SR_TCF_Msk)) {
+        if (dwt_deadline_expired(&deadline))
             return MX25UW_ERROR;
     }
 
@@ -372,6 +579,32 @@ static int32_t mx25uw_write_cfg_reg2(uint32_t addr, uint8_t val)
 }
 /* ------------------------------------------------------------------------- */
 
+/**
+ * @brief           Ожидание завершения записи/стирания в режиме SPI
+ *
+ * @return          Статус:
+ *                      - MX25UW_ERROR
+ *                      - MX25UW_OK
+ */
+static int32_t mx25uw_wait_ready(void)
+{
+    struct dwt_deadline deadline;
+    uint8_t status;
+
+    dwt_deadline_start(&deadline, MX25UW_WRITE_TIMEOUT);
+
+    do {
+        if (mx25uw_spi_command(MX25UW_READ_STATUS_REG_CMD, 0, true, &status, sizeof(status)) < 0)
+            return MX25UW_ERROR;
+
+        if (dwt_deadline_expired(&deadline))
+            return MX25UW_ERROR;
+    } while (status & MX25UW_SR_WIP_Msk);
+
+    return MX25UW_OK;
+}
+/* ------------------------------------------------------------------------- */
+
 /**
  * @brief           Настроить интерфейс OPI DTR
  *
@@ -401,11 +634,13 @@ int32_t mx25uw_setup_opi_dtr(void)
  */
 int32_t mx25uw_setup_memory_mapped_mode(void)
 {
-    uint32_t tickstart = mx25uw_tick();
+    struct dwt_deadline deadline;
+
+    dwt_deadline_start(&deadline, MX25UW_XSPI_TIMEOUT);
 
     /* Ожидание готовности XSPI */
     while (READ_BIT(mx25uw.xspi->SR, XSPI_SR_BUSY_Msk)) {
-        if (mx25uw_tick() - tickstart >= MX25UW_XSPI_TIMEOUT)
+        if (dwt_deadline_expired(&deadline))
             return MX25UW_ERROR;
     }
 
@@ -510,7 +745,7 @@ int32_t mx25uw_setup_memory_mapped_mode(void)
 
     /* Ожидание готовности XSPI */
     while (READ_BIT(mx25uw.xspi->SR, XSPI_SR_BUSY_Msk)) {
-        if (mx25uw_tick() - tickstart >= MX25UW_XSPI_TIMEOUT)
+        if (dwt_deadline_expired(&deadline))
             return MX25UW_ERROR;
     }
 
@@ -524,12 +759,314 @@ int32_t mx25uw_setup_memory_mapped_mode(void)
 /* ------------------------------------------------------------------------- */
 
 /**
- * @brief           Получить значение системного таймера (мс)
+ * @brief           Выполнить программный сброс MX25UW
+ *
+ * @return          Статус:
+ *                      - MX25UW_ERROR
+ *                      - MX25UW_OK
+ *
+ * @note            MX25UW возвращается в режим SPI (и Fast Boot), как после
+ *                  включения питания. Выполняется перед программным сбросом
+ *                  MCU, иначе Boot читает ID только после сброса MX25UW
+ *                  из @ref mx25uw_init
+ */
+int32_t mx25uw_reset(void)
+{
+    if (READ_BIT(mx25uw.xspi->CR, XSPI_CR_FMODE_Msk) == XSPI_CR_FMODE_Msk
+            && mx25uw_exit_memory_mapped_mode() < 0) {
+        return MX25UW_ERROR;
+    } else if (mx25uw_send_command(MX25UW_RESET_ENABLE_CMD, MX25UW_OPI_RESET_ENABLE_CMD) < 0) {
+        return MX25UW_ERROR;
+    } else if (mx25uw_send_command(MX25UW_RESET_MEMORY_CMD, MX25UW_OPI_RESET_MEMORY_CMD) < 0) {
+        return MX25UW_ERROR;
+    } else {
+        /* Дождаться готовности MX25UW к командам после сброса */
+        dwt_delay_us(MX25UW_RESET_TIME);
+
+        mx25uw.interface = MX25UW_SPI;
+        return MX25UW_OK;
+    }
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Выйти из Memory Mapped Mode
+ *
+ * @return          Статус:
+ *                      - MX25UW_ERROR
+ *                      - MX25UW_OK
+ */
+int32_t mx25uw_exit_memory_mapped_mode(void)
+{
+    struct dwt_deadline deadline;
+
+    dwt_deadline_start(&deadline, MX25UW_XSPI_TIMEOUT);
+
+    /* Прервать текущую операцию XSPI */
+    SET_BIT(mx25uw.xspi->CR, XSPI_CR_ABORT_Msk);
+
+    while (READ_BIT(mx25uw.xspi->CR, XSPI_CR_ABORT_Msk)
+        || READ_BIT(mx25uw.xspi->SR, XSPI_SR_BUSY_Msk)) {
+        if (dwt_deadline_expired(&deadline))
+            return MX25UW_ERROR;
+    }
+
+    /* Настроить Functional Mode = Indirect Write */
+    CLEAR_BIT(mx25uw.xspi->CR, XSPI_CR_FMODE_Msk);
+
+    return MX25UW_OK;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Запустить стирание сектора 4KB
+ *
+ * @param[in]       addr: Адрес сектора
+ * @return          Статус:
+ *                      - MX25UW_ERROR
+ *                      - MX25UW_OK
+ *
+ * @note            Выполняется в режиме OPI DTR вне Memory Mapped Mode.
+ *                  Завершение стирания - @ref mx25uw_get_status
+ */
+int32_t mx25uw_erase_sector(uint32_t addr)
+{
+    struct dwt_deadline deadline;
+
+    dwt_deadline_start(&deadline, MX25UW_XSPI_TIMEOUT);
+
+    if (mx25uw.interface != MX25UW_OPI_DTR || addr % MX25UW_SECTOR_SIZE != 0)
+        return MX25UW_ERROR;
+
+    if (mx25uw_write_enable() < 0)
+        return MX25UW_ERROR;
+
+    /* Ожидание готовности XSPI */
+    while (READ_BIT(mx25uw.xspi->SR, XSPI_SR_BUSY_Msk)) {
+        if (dwt_deadline_expired(&deadline))
+            return MX25UW_ERROR;
+    }
+
+    /* Настроить Functional Mode */
+    CLEAR_BIT(mx25uw.xspi->CR, XSPI_CR_FMODE_Msk);
+
+    /* Настроить TCR */
+    WRITE_REG(mx25uw.xspi->TCR, XSPI_TCR_DHQC_Msk);
+
+    /* Настроить CCR */
+    WRITE_REG(mx25uw.xspi->CCR,
+              0x04 << XSPI_CCR_IMODE_Pos
+            | XSPI_CCR_IDTR_Msk
+            | 0x01 << XSPI_CCR_ISIZE_Pos
+            | 0x04 << XSPI_CCR_ADMODE_Pos
+            | XSPI_CCR_ADDTR_Msk
+            | 0x03 << XSPI_CCR_ADSIZE_Pos);
+
+    /* Настроить IR */
+    WRITE_REG(mx25uw.xspi->IR, MX25UW_OPI_SECTOR_ERASE_CMD);
+
+    /* Настроить AR */
+    WRITE_REG(mx25uw.xspi->AR, addr);
+
+    /* Ожидание завершения операции */
+    while (!READ_BIT(mx25uw.xspi->SR, XSPI_SR_TCF_Msk)) {
+        if (dwt_deadline_expired(&deadline))
+            return MX25UW_ERROR;
+    }
+
+    /* Очистить статус завершения операции */
+    SET_BIT(mx25uw.xspi->FCR, XSPI_FCR_CTCF_Msk);
+
+    return MX25UW_OK;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Запустить программирование страницы
+ *
+ * @param[in]       addr: Адрес
+ * @param[in]       data: Указатель на данные
+ * @param[in]       size: Размер данных (байт, четный, в пределах страницы)
+ * @return          Статус:
+ *                      - MX25UW_ERROR
+ *                      - MX25UW_OK
+ *
+ * @note            Выполняется в режиме OPI DTR вне Memory Mapped Mode.
+ *                  Завершение программирования - @ref mx25uw_get_status
+ */
+int32_t mx25uw_program_page(uint32_t addr, const void *data, uint32_t size)
+{
+    struct dwt_deadline deadline;
+
+    dwt_deadline_start(&deadline, MX25UW_XSPI_TIMEOUT);
+
+    /* Указатель на данные */
+    const uint8_t *pdata = data;
+    /* Указатель на регистр данных XSPI */
+    volatile uint8_t *DR = (uint8_t *) &mx25uw.xspi->DR;
+
+    if (mx25uw.interface != MX25UW_OPI_DTR) {
+        return MX25UW_ERROR;
+    } else if (size == 0 || size % 2 != 0) {
+        return MX25UW_ERROR;
+    } else if (addr % MX25UW_PAGE_SIZE + size > MX25UW_PAGE_SIZE) {
+        return MX25UW_ERROR;
+    }
+
+    if (mx25uw_write_enable() < 0)
+        return MX25UW_ERROR;
+
+    /* Ожидание готовности XSPI */
+    while (READ_BIT(mx25uw.xspi->SR, XSPI_SR_BUSY_Msk)) {
+        if (dwt_deadline_expired(&deadline))
+            return MX25UW_ERROR;
+    }
+
+    /* Настроить Functional Mode */
+    CLEAR_BIT(mx25uw.xspi->CR, XSPI_CR_FMODE_Msk);
+
+    /* Настроить DLR */
+    WRITE_REG(mx25uw.xspi->DLR, size - 1);
+
+    /* Настроить TCR */
+    CLEAR_REG(mx25uw.xspi->TCR);
+
+    /* Настроить CCR */
+    WRITE_REG(mx25uw.xspi->CCR,
+              0x04 << XSPI_CCR_IMODE_Pos
+            | XSPI_CCR_IDTR_Msk
+            | 0x01 << XSPI_CCR_ISIZE_Pos
+            | 0x04 << XSPI_CCR_ADMODE_Pos
+            | XSPI_CCR_ADDTR_Msk
+            | 0x03 << XSPI_CCR_ADSIZE_Pos
+            | 0x04 << XSPI_CCR_DMODE_Pos
+            | XSPI_CCR_DDTR_Msk);
+
+    /* Настроить IR */
+    WRITE_REG(mx25uw.xspi->IR, MX25UW_OPI_PAGE_PROG_CMD);
+
+    /* Настроить AR */
+    WRITE_REG(mx25uw.xspi->AR, addr);
+
+    /* Передать данные */
+    while (size > 0) {
+        /* Ожидание возможности передачи данных */
+        while (!READ_BIT(mx25uw.xspi->SR, XSPI_SR_FTF_Msk)) {
+            if (dwt_deadline_expired(&deadline))
+                return MX25UW_ERROR;
+        }
+
+        /* Записать передаваемые данные */
+        *DR = *pdata;
+
+        pdata++;
+        size--;
+    }
+
+    /* Ожидание завершения операции */
+    while (!READ_BIT(mx25uw.xspi->SR, XSPI_SR_TCF_Msk)) {
+        if (dwt_deadline_expired(&deadline))
+            return MX25UW_ERROR;
+    }
+
+    /* Очистить статус завершения операции */
+    SET_BIT(mx25uw.xspi->FCR, XSPI_FCR_CTCF_Msk);
+
+    return MX25UW_OK;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Получить состояние выполнения записи/стирания
+ *
+ * @return          Статус:
+ *                      - MX25UW_ERROR
+ *                      - MX25UW_BUSY
+ *                      - MX25UW_OK
  *
- * @return          Значение таймера
+ * @note            Выполняется в режиме OPI DTR вне Memory Mapped Mode
  */
-static inline uint32_t mx25uw_tick(void)
+int32_t mx25uw_get_status(void)
 {
-    return systick_get_tick();
+    struct dwt_deadline deadline;
+
+    dwt_deadline_start(&deadline, MX25UW_XSPI_TIMEOUT);
+
+    /* Регистр статуса в режиме DTR передается дважды */
+    uint8_t status[2];
+    /* Размер данных регистра */
+    uint32_t data_size = sizeof(status);
+    /* Указатель на данные регистра */
+    uint8_t *pdata = status;
+    /* Указатель на регистр данных XSPI */
+    volatile uint8_t *DR = (uint8_t *) &mx25uw.xspi->DR;
+
+    if (mx25uw.interface != MX25UW_OPI_DTR)
+        return MX25UW_ERROR;
+
+    /* Ожидание готовности XSPI */
+    while (READ_BIT(mx25uw.xspi->SR, XSPI_SR_BUSY_Msk)) {
+        if (dwt_deadline_expired(&deadline))
+            return MX25UW_ERROR;
+    }
+
+    /* Настроить Functional Mode */
+    MODIFY_REG(mx25uw.xspi->CR,
+               XSPI_CR_FMODE_Msk,
+               0x01 << XSPI_CR_FMODE_Pos);
+
+    /* Настроить DLR */
+    WRITE_REG(mx25uw.xspi->DLR, data_size - 1);
+
+    /* Настроить TCR */
+    WRITE_REG(mx25uw.xspi->TCR,
+              0x04 << XSPI_TCR_DCYC_Pos
+            | XSPI_TCR_DHQC_Msk);
+
+    /* Настроить CCR */
+    WRITE_REG(mx25uw.xspi->CCR,
+              0x04 << XSPI_CCR_IMODE_Pos
+            | XSPI_CCR_IDTR_Msk
+            | 0x01 << XSPI_CCR_ISIZE_Pos
+            | 0x04 << XSPI_CCR_ADMODE_Pos
+            | XSPI_CCR_ADDTR_Msk
+            | 0x03 << XSPI_CCR_ADSIZE_Pos
+            | 0x04 << XSPI_CCR_DMODE_Pos
+            | XSPI_CCR_DDTR_Msk
+            | XSPI_CCR_DQSE_Msk);
+
+    /* Настроить IR */
+    WRITE_REG(mx25uw.xspi->IR, MX25UW_OPI_READ_STATUS_REG_CMD);
+
+    /* Настроить AR */
+    WRITE_REG(mx25uw.xspi->AR, 0x00000000);
+
+    /* Принять данные */
+    while (data_size > 0) {
+        /* Ожидание возможности приема данных */
+        while (!READ_BIT(mx25uw.xspi->SR,
+                         XSPI_SR_FTF_Msk
+                       | XSPI_SR_TCF_Msk)) {
+            if (dwt_deadline_expired(&deadline))
+                return MX25UW_ERROR;
+        }
+
+        /* Записать принятые данные */
+        *pdata = *DR;
+
+        pdata++;
+        data_size--;
+    }
+
+    /* Ожидание завершения операции */
+    while (!READ_BIT(mx25uw.xspi->SR, XSPI_SR_TCF_Msk)) {
+        if (dwt_deadline_expired(&deadline))
+            return MX25UW_ERROR;
+    }
+
+    /* Очистить статус завершения операции */
+    SET_BIT(mx25uw.xspi->FCR, XSPI_FCR_CTCF_Msk);
+
+    return status[0] & MX25UW_SR_WIP_Msk ? MX25UW_BUSY : MX25UW_OK;
 }
 /* ------------------------------------------------------------------------- */
@@ -0,0 +1,155 @@
+/**
+ * Copyright (C) 2025 zhmaksim <zhiharev.maxim.alexandrovich@yandex.ru>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef UPDATE_H_
+#define UPDATE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/* Includes ---------------------------------------------------------------- */
+
+#include "main.h"
+#include "image.h"
+#include "mx25uw.h"
+
+/* Exported macros --------------------------------------------------------- */
+
+/* Exported constants ------------------------------------------------------ */
+
+#define UPDATE_CHUNK_SIZE               MX25UW_SECTOR_SIZE      /* Данные кадра = сектор FLASH */
+
+#define UPDATE_FRAME_MAGIC              0x46445055              /* "UPDF" */
+#define UPDATE_RESPONSE_MAGIC           0x52445055              /* "UPDR" */
+
+#define UPDATE_STATE_ADDRESS            (BKPSRAM_BASE + 0x140)
+#define UPDATE_STATE_MAGIC              0x54535055              /* "UPST" */
+
+#define UPDATE_OK                        0
+#define UPDATE_ERROR                    -1
+#define UPDATE_BUSY                      1
+
+/* Exported types ---------------------------------------------------------- */
+
+/**
+ * @brief           Определение перечисления типов кадров обновления
+ */
+enum update_frame_type {
+    UPDATE_FRAME_START = 1,
+    UPDATE_FRAME_DATA,
+    UPDATE_FRAME_END,
+};
+
+
+/**
+ * @brief           Определение перечисления статусов ответа
+ */
+enum update_response_status {
+    UPDATE_ACK,
+    UPDATE_NAK_CRC,
+    UPDATE_NAK_OFFSET,
+    UPDATE_NAK_PARAM,
+    UPDATE_NAK_FLASH,
+    UPDATE_NAK_VERIFY,
+};
+
+
+/**
+ * @brief           Определение структуры данных кадра обновления (Host -> Boot)
+ *
+ * @note            Все кадры имеют одинаковый размер и принимаются DMA целиком.
+ *                  Формат должен совпадать с Tools/update_tool.py
+ */
+struct update_frame {
+    uint32_t magic;                             /*!< Признак кадра UPDATE_FRAME_MAGIC */
+
+    uint16_t type;                              /*!< Тип кадра @ref enum update_frame_type */
+
+    uint16_t length;                            /*!< Размер данных (байт) */
+
+    uint32_t offset;                            /*!< Смещение данных в слоте (байт) */
+
+    uint32_t crc;                               /*!< CRC-32 полей magic...offset и данных */
+
+    uint8_t data[UPDATE_CHUNK_SIZE];            /*!< Данные */
+};
+
+
+/**
+ * @brief           Определение структуры данных кадра начала обновления
+ */
+struct update_start {
+    uint32_t slot;                              /*!< Номер слота */
+
+    uint32_t size;                              /*!< Размер образа (байт, кратно 4) */
+
+    uint32_t image_id;                          /*!< CRC-32 образа (продолжение передачи, проверка слота) */
+};
+
+
+/**
+ * @brief           Определение структуры данных ответа (Boot -> Host)
+ */
+struct update_response {
+    uint32_t magic;                             /*!< Признак ответа UPDATE_RESPONSE_MAGIC */
+
+    uint16_t type;                              /*!< Тип кадра, на который дан ответ */
+
+    uint16_t status;                            /*!< Статус @ref enum update_response_status */
+
+    uint32_t offset;                            /*!< Смещение, с которого ожидаются данные */
+
+    uint32_t crc;                               /*!< CRC-32 полей magic...offset */
+};
+
+
+/**
+ * @brief           Определение структуры данных состояния обновления
+ *
+ * @note            Размещается в SRAM_BKP и позволяет продолжить прерванную
+ *                  передачу того же образа после сброса
+ */
+struct update_state {
+    uint32_t magic;                             /*!< Признак состояния UPDATE_STATE_MAGIC */
+
+    uint32_t slot;                              /*!< Номер слота */
+
+    uint32_t size;                              /*!< Размер образа (байт) */
+
+    uint32_t image_id;                          /*!< CRC-32 образа */
+
+    uint32_t written;                           /*!< Записано и проверено (байт) */
+};
+
+/* Exported variables ------------------------------------------------------ */
+
+/* Exported function prototypes -------------------------------------------- */
+
+bool update_is_requested(void);
+
+int32_t update_init(void);
+
+int32_t update_process(void);
+
+/* Exported callback function prototypes ----------------------------------- */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* UPDATE_H_ */
@@ -0,0 +1,379 @@
+/**
+ * Copyright (C) 2025 zhmaksim <zhiharev.maxim.alexandrovich@yandex.ru>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/* Includes ---------------------------------------------------------------- */
+
+#include "update.h"
+#include "usart.h"
+#include "crc.h"
+#include "systick.h"
+#include "led.h"
+
+/* Private macros ---------------------------------------------------------- */
+
+/* Private constants ------------------------------------------------------- */
+
+#define UPDATE_FLASH_TIMEOUT    1000            /* Максимальное время стирания сектора (мс) */
+
+/* Private types ----------------------------------------------------------- */
+
+/* Private variables ------------------------------------------------------- */
+
+/* Двойной буфер приема кадров */
+static struct update_frame frame[2] __DMA_BUFFER;
+
+static struct update_state *const state = (struct update_state *) UPDATE_STATE_ADDRESS;
+
+static uint32_t erase_address;
+
+static bool erase_pending;
+
+/* Private function prototypes --------------------------------------------- */
+
+static int32_t update_start(const struct update_frame *rx);
+
+static int32_t update_data(const struct update_frame *rx);
+
+static int32_t update_end(const struct update_frame *rx);
+
+static int32_t update_erase_ahead(void);
+
+static int32_t update_wait_flash(void);
+
+static uint32_t update_get_flash_address(uint32_t offset);
+
+static void update_respond(uint32_t type, uint32_t status);
+
+/* Private user code ------------------------------------------------------- */
+
+/**
+ * @brief           Проверить запрос обновления (кнопка USER нажата при сбросе)
+ *
+ * @return          Признак запроса обновления
+ */
+bool update_is_requested(void)
+{
+    return READ_BIT(GPIOC->IDR, GPIO_IDR_ID13_Msk) != 0;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Инициализировать обновление по USART
+ *
+ * @return          Статус:
+ *                      - UPDATE_ERROR
+ *                      - UPDATE_OK
+ */
+int32_t update_init(void)
+{
+    /* Запись/стирание выполняются командами, Memory Mapped Mode не нужен */
+    if (mx25uw_exit_memory_mapped_mode() != MX25UW_OK)
+        return UPDATE_ERROR;
+
+    erase_pending = false;
+
+    usart_init();
+    usart_start_receive(&frame[0], &frame[1], sizeof(struct update_frame));
+
+    /* Включить желтый светодиод - Обновление */
+    led_on(LED_YELLOW);
+
+    return UPDATE_OK;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Обработать принятые кадры
+ *
+ * @return          Статус:
+ *                      - UPDATE_ERROR
+ *                      - UPDATE_BUSY
+ *                      - UPDATE_OK (образ записан, требуется сброс)
+ *
+ * @note            DMA принимает следующий кадр во второй буфер, пока
+ *                  текущий программируется во FLASH. Сектор следующего кадра
+ *                  стирается заранее, во время его приема
+ */
+int32_t update_process(void)
+{
+    void *buffer;
+
+    if (usart_receive(&buffer) != USART_OK)
+        return UPDATE_BUSY;
+
+    const struct update_frame *rx = buffer;
+
+    if (rx->magic != UPDATE_FRAME_MAGIC || rx->length > UPDATE_CHUNK_SIZE) {
+        update_respond(rx->type, UPDATE_NAK_CRC);
+        return UPDATE_BUSY;
+    }
+
+    /* Кадр в ОЗУ короткий, CRC дешевле вычислить программно, чем настраивать DMA */
+    uint32_t crc = crc_calculate_software(CRC_INITIAL, rx, offsetof(struct update_frame, crc));
+
+    if (rx->crc != crc_calculate_software(crc, rx->data, rx->length)) {
+        update_respond(rx->type, UPDATE_NAK_CRC);
+        return UPDATE_BUSY;
+    }
+
+    switch (rx->type) {
+    case UPDATE_FRAME_START:
+        return update_start(rx);
+    case UPDATE_FRAME_DATA:
+        return update_data(rx);
+    case UPDATE_FRAME_END:
+        return update_end(rx);
+    default:
+        update_respond(rx->type, UPDATE_NAK_PARAM);
+        return UPDATE_BUSY;
+    }
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Обработать кадр начала обновления
+ *
+ * @param[in]       rx: Указатель на кадр
+ * @return          Статус:
+ *                      - UPDATE_ERROR
+ *                      - UPDATE_BUSY
+ */
+static int32_t update_start(const struct update_frame *rx)
+{
+    const struct update_start *start = (const struct update_start *) rx->data;
+
+    if (rx->length != sizeof(struct update_start)
+            || start->slot >= IMAGE_SLOT_COUNT
+            || start->size == 0
+            || start->size > IMAGE_SLOT_SIZE
+            || start->size % 4 != 0) {
+        update_respond(rx->type, UPDATE_NAK_PARAM);
+        return UPDATE_BUSY;
+    }
+
+    /* Продолжить передачу того же образа с последнего записанного сектора */
+    if (state->magic != UPDATE_STATE_MAGIC
+            || state->slot != start->slot
+            || state->size != start->size
+            || state->image_id != start->image_id) {
+        state->magic = 0;
+        state->slot = start->slot;
+        state->size = start->size;
+        state->image_id = start->image_id;
+        state->written = 0;
+        state->magic = UPDATE_STATE_MAGIC;
+    }
+
+    /* Повторный START при ожидающем стирании - дождаться его */
+    if (update_wait_flash() != UPDATE_OK || update_erase_ahead() != UPDATE_OK) {
+        update_respond(rx->type, UPDATE_NAK_FLASH);
+        return UPDATE_ERROR;
+    }
+
+    update_respond(rx->type, UPDATE_ACK);
+    return UPDATE_BUSY;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Обработать кадр данных
+ *
+ * @param[in]       rx: Указатель на кадр
+ * @return          Статус:
+ *                      - UPDATE_ERROR
+ *                      - UPDATE_BUSY
+ */
+static int32_t update_data(const struct update_frame *rx)
+{
+    if (state->magic != UPDATE_STATE_MAGIC) {
+        update_respond(rx->type, UPDATE_NAK_PARAM);
+        return UPDATE_BUSY;
+    } else if (rx->offset != state->written) {
+        /* Кадр вне очереди (после NAK предыдущего) - запросить с ожидаемого смещения */
+        update_respond(rx->type, UPDATE_NAK_OFFSET);
+        return UPDATE_BUSY;
+    }
+
+    uint32_t remaining = state->size - state->written;
+    uint32_t length = remaining < UPDATE_CHUNK_SIZE ? remaining : UPDATE_CHUNK_SIZE;
+
+    if (rx->length != length) {
+        update_respond(rx->type, UPDATE_NAK_PARAM);
+        return UPDATE_BUSY;
+    }
+
+    uint32_t addr = update_get_flash_address(state->written);
+
+    /* Сектор стирается заранее, иначе стереть сейчас */
+    if (!erase_pending || erase_address != addr) {
+        if (update_wait_flash() != UPDATE_OK || mx25uw_erase_sector(addr) != MX25UW_OK) {
+            update_respond(rx->type, UPDATE_NAK_FLASH);
+            return UPDATE_ERROR;
+        }
+    }
+
+    erase_pending = false;
+
+    if (update_wait_flash() != UPDATE_OK) {
+        update_respond(rx->type, UPDATE_NAK_FLASH);
+        return UPDATE_ERROR;
+    }
+
+    /* Запрограммировать сектор постранично */
+    for (uint32_t i = 0; i < length; i += MX25UW_PAGE_SIZE) {
+        uint32_t size = length - i < MX25UW_PAGE_SIZE ? length - i : MX25UW_PAGE_SIZE;
+
+        if (mx25uw_program_page(addr + i, &rx->data[i], size) != MX25UW_OK
+                || update_wait_flash() != UPDATE_OK) {
+            update_respond(rx->type, UPDATE_NAK_FLASH);
+            return UPDATE_ERROR;
+        }
+    }
+
+    state->written += length;
+
+    if (update_erase_ahead() != UPDATE_OK) {
+        update_respond(rx->type, UPDATE_NAK_FLASH);
+        return UPDATE_ERROR;
+    }
+
+    update_respond(rx->type, UPDATE_ACK);
+    return UPDATE_BUSY;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Обработать кадр завершения обновления
+ *
+ * @param[in]       rx: Указатель на кадр
+ * @return          Статус:
+ *                      - UPDATE_ERROR
+ *                      - UPDATE_BUSY
+ *                      - UPDATE_OK
+ */
+static int32_t update_end(const struct update_frame *rx)
+{
+    if (state->magic != UPDATE_STATE_MAGIC || state->written != state->size) {
+        update_respond(rx->type, UPDATE_NAK_OFFSET);
+        return UPDATE_BUSY;
+    }
+
+    /* Проверить записанный образ: CRC слота через окно Memory Mapped XSPI
+     * должен совпасть с идентификатором образа (zlib.crc32 образа) */
+    const void *image = (const void *) (IMAGE_SLOT_A_ADDRESS + state->slot * IMAGE_SLOT_SIZE);
+    uint32_t value;
+
+    if (update_wait_flash() != UPDATE_OK
+            || mx25uw_setup_memory_mapped_mode() != MX25UW_OK
+            || crc_calculate(image, state->size, &value) != CRC_OK
+            || mx25uw_exit_memory_mapped_mode() != MX25UW_OK) {
+        update_respond(rx->type, UPDATE_NAK_FLASH);
+        return UPDATE_ERROR;
+    } else if (value != state->image_id) {
+        /* Образ поврежден - передать заново */
+        state->magic = 0;
+        update_respond(rx->type, UPDATE_NAK_VERIFY);
+        return UPDATE_BUSY;
+    }
+
+    state->magic = 0;
+
+    update_respond(rx->type, UPDATE_ACK);
+    led_off(LED_YELLOW);
+
+    return UPDATE_OK;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Запустить стирание сектора следующего кадра
+ *
+ * @return          Статус:
+ *                      - UPDATE_ERROR
+ *                      - UPDATE_OK
+ *
+ * @note            Стирание выполняется MX25UW, пока DMA принимает кадр
+ */
+static int32_t update_erase_ahead(void)
+{
+    if (state->written >= state->size)
+        return UPDATE_OK;
+
+    erase_address = update_get_flash_address(state->written);
+
+    if (mx25uw_erase_sector(erase_address) != MX25UW_OK)
+        return UPDATE_ERROR;
+
+    erase_pending = true;
+
+    return UPDATE_OK;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Ожидание завершения записи/стирания FLASH
+ *
+ * @return          Статус:
+ *                      - UPDATE_ERROR
+ *                      - UPDATE_OK
+ */
+static int32_t update_wait_flash(void)
+{
+    uint32_t tickstart = systick_get_tick();
+    int32_t status;
+
+    while ((status = mx25uw_get_status()) == MX25UW_BUSY) {
+        if (systick_get_tick() - tickstart >= UPDATE_FLASH_TIMEOUT)
+            return UPDATE_ERROR;
+    }
+
+    return status == MX25UW_OK ? UPDATE_OK : UPDATE_ERROR;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Получить адрес FLASH по смещению в слоте
+ *
+ * @param[in]       offset: Смещение в слоте (байт)
+ * @return          Адрес FLASH
+ */
+static uint32_t update_get_flash_address(uint32_t offset)
+{
+    return (IMAGE_SLOT_A_ADDRESS + state->slot * IMAGE_SLOT_SIZE + offset) & (MX25UW_FLASH_SIZE - 1);
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Передать ответ
+ *
+ * @param[in]       type: Тип кадра, на который дан ответ
+ * @param[in]       status: Статус @ref enum update_response_status
+ */
+static void update_respond(uint32_t type, uint32_t status)
+{
+    struct update_response response = {
+        .magic = UPDATE_RESPONSE_MAGIC,
+        .type = type,
+        .status = status,
+        .offset = state->magic == UPDATE_STATE_MAGIC ? state->written : 0,
+    };
+
+    response.crc = crc_calculate_software(CRC_INITIAL, &response, offsetof(struct update_response, crc));
+
+    usart_transmit(&response, sizeof(response));
+}
+/* ------------------------------------------------------------------------- */
@@ -16,7 +16,7 @@
 .syntax unified
 .thumb
 .cpu cortex-m7
-.fpu softvfp
+.fpu fpv5-d16
 
 .global Vectors
 .global Default_Handler
@@ -26,12 +26,71 @@
 .word _edata
 .word _sbss
 .word _ebss
+.word _siitcm_text
+.word _sitcm_text
+.word _eitcm_text
+.word _sbss_dma
+.word _ebss_dma
+
+/* FPU (CMSIS core_cm7.h) */
+.equ CPACR,                 0xE000ED88
+.equ CPACR_CP10_CP11,       0x00F00000  /* CP10, CP11 full access */
+.equ FPCCR,                 0xE000EF34
+.equ FPCCR_ASPEN_LSPEN,     0xC0000000  /* Automatic and lazy state preservation */
+
+/* DWT cycle counter (CMSIS core_cm7.h) */
+.equ DEMCR,                 0xE000EDFC
+.equ DEMCR_TRCENA,          0x01000000
+.equ DWT_CTRL,              0xE0001000
+.equ DWT_CTRL_CYCCNTENA,    0x00000001
+.equ DWT_CYCCNT,            0xE0001004
+.equ DWT_LAR,               0xE0001FB0
+.equ DWT_LAR_KEY,           0xC5ACCE55
+
+/* GPDMA1 Channel 7 (stm32h7s3xx.h), zero fill of the DMA BSS segment */
+.equ RCC_AHB1ENR,           0x58024538
+.equ RCC_AHB1ENR_GPDMA1EN,  0x00000010
+.equ DMA_CHANNEL,           0x400213D0
+.equ DMA_CFCR,              0x0C
+.equ DMA_CSR,               0x10
+.equ DMA_CCR,               0x14
+.equ DMA_CTR1,              0x40
+.equ DMA_CTR2,              0x44
+.equ DMA_CBR1,              0x48
+.equ DMA_CSAR,              0x4C
+.equ DMA_CDAR,              0x50
+.equ DMA_CLLR,              0x7C
+.equ DMA_CTR1_VALUE,        0x000A0002  /* SDW = DDW = 32 bit, DINC */
+.equ DMA_CTR2_SWREQ,        0x00000200
+.equ DMA_CFCR_ALL,          0x00007F00
+.equ DMA_CSR_TCF,           0x00000100
+.equ DMA_CSR_ERRORS,        0x00001C00  /* DTEF, ULEF, USEF */
+.equ DMA_BLOCK_SIZE,        0x0000FFFC  /* BNDT 16 bit, multiple of 4 */
+
+/**
+ * @brief           Startup duration in CPU cycles (DWT CYCCNT from Reset_Handler
+ *                  to __libc_init_array), written before main() is called.
+ */
+
+.global startup_cycles
+
+.section .noinit.startup_cycles, "aw", %nobits
+.align 2
+.type startup_cycles, %object
+
+startup_cycles:
+    .space 4
+
+.size startup_cycles, .-startup_cycles
 
 /**
  * @brief           This is the code that gets called when the processor first
  *                  starts execution following a reset event. Only the absolutely
  *                  necessary set is performed, after which the application
  *                  supplied main() routine is called.
+ *
+ * @note            Registers r7-r11 hold the state across the init routines:
+ *                  r7-r10 - DMA zero fill, r11 - cycle counter at reset.
  */
 
 .section .text.Reset_Handler
@@ -43,36 +102,71 @@ Reset_Handler:
     ldr r0, = _estack
     mov sp, r0
 
+    /* Enable the FPU before any C code (the hard-float profile may use FPU
+     * registers anywhere) and keep lazy stacking of the FPU context: an
+     * exception frame reserves S0-S15/FPSCR, they are saved only if the
+     * handler executes an FPU instruction */
+    ldr r0, = CPACR
+    ldr r1, [r0]
+    orr r1, r1, #CPACR_CP10_CP11
+    str r1, [r0]
+    ldr r0, = FPCCR
+    ldr r1, [r0]
+    orr r1, r1, #FPCCR_ASPEN_LSPEN
+    str r1, [r0]
+    dsb
+    isb
+
+    /* Start the DWT cycle counter (not reset, Boot keeps counting into the App) */
+    ldr r0, = DEMCR
+    ldr r1, [r0]
+    orr r1, r1, #DEMCR_TRCENA
+    str r1, [r0]
+    ldr r0, = DWT_LAR
+    ldr r1, = DWT_LAR_KEY
+    str r1, [r0]
+    ldr r0, = DWT_CTRL
+    ldr r1, [r0]
+    orr r1, r1, #DWT_CTRL_CYCCNTENA
+    str r1, [r0]
+    ldr r0, = DWT_CYCCNT
+    ldr r11, [r0]
+
+    /* Zero fill the DMA BSS segment in the background */
+    ldr r0, = _sbss_dma
+    ldr r1, = _ebss_dma
+    bl ZeroDmaStart
+
     /* Copy the data segment initializers from FLASH to SRAM */
     ldr r0, = _sdata
     ldr r1, = _edata
     ldr r2, = _sidata
-    movs r3, #0
-    b LoopCopyDataInit
+    bl CopyInit
 
-CopyDataInit:
-    ldr r4, [r2, r3]
-    str r4, [r0, r3]
-    adds r3, r3, #4
+    /* Copy the hot code from FLASH to ITCM */
+    ldr r0, = _sitcm_text
+    ldr r1, = _eitcm_text
+    ldr r2, = _siitcm_text
+    bl CopyInit
 
-LoopCopyDataInit:
-    adds r4, r0, r3
-    cmp r4, r1
-    bcc CopyDataInit
+    /* Make the copied code visible to instruction fetch */
+    dsb
+    isb
 
     /* Zero fill the BSS segment */
-    ldr r2, = _sbss
-    ldr r4, = _ebss
-    movs r3, #0
-    b LoopFillZeroBss
+    ldr r0, = _sbss
+    ldr r1, = _ebss
+    bl ZeroInit
 
-FillZeroBss:
-    str r3, [r2]
-    adds r2, r2, #4
+    /* Wait for the DMA BSS segment */
+    bl ZeroDmaWait
 
-LoopFillZeroBss:
-    cmp r2, r4
-    bcc FillZeroBss
+    /* Save the startup duration */
+    ldr r0, = DWT_CYCCNT
+    ldr r1, [r0]
+    sub r1, r1, r11
+    ldr r0, = startup_cycles
+    str r1, [r0]
 
     /* Call static constructors */
     bl __libc_init_array
@@ -84,6 +178,194 @@ LoopForever:
 
 .size Reset_Handler, .-Reset_Handler
 
+/**
+ * @brief           Copy words from r2 to [r0, r1), 16 bytes per LDM/STM pair.
+ *                  Nothing is copied if the section is already in place
+ *                  (image loaded into RAM). Uses r0-r6.
+ */
+
+.section .text.CopyInit
+.type CopyInit, %function
+
+CopyInit:
+    cmp r0, r2
+    beq CopyInitDone
+    b LoopCopyInitBlock
+
+CopyInitBlock:
+    ldmia r2!, {r3-r6}
+    stmia r0!, {r3-r6}
+
+LoopCopyInitBlock:
+    subs r3, r1, r0
+    cmp r3, #16
+    bhs CopyInitBlock
+    b LoopCopyInitWord
+
+CopyInitWord:
+    ldr r3, [r2], #4
+    str r3, [r0], #4
+
+LoopCopyInitWord:
+    cmp r0, r1
+    bcc CopyInitWord
+
+CopyInitDone:
+    bx lr
+
+.size CopyInit, .-CopyInit
+
+/**
+ * @brief           Zero fill [r0, r1), 16 bytes per STM. Uses r0-r6.
+ */
+
+.section .text.ZeroInit
+.type ZeroInit, %function
+
+ZeroInit:
+    movs r3, #0
+    movs r4, #0
+    movs r5, #0
+    movs r6, #0
+    b LoopZeroInitBlock
+
+ZeroInitBlock:
+    stmia r0!, {r3-r6}
+
+LoopZeroInitBlock:
+    subs r2, r1, r0
+    cmp r2, #16
+    bhs ZeroInitBlock
+    b LoopZeroInitWord
+
+ZeroInitWord:
+    str r3, [r0], #4
+
+LoopZeroInitWord:
+    cmp r0, r1
+    bcc ZeroInitWord
+    bx lr
+
+.size ZeroInit, .-ZeroInit
+
+/**
+ * @brief           Start zero fill of [r0, r1) by GPDMA1 (memory-to-memory,
+ *                  fixed source = the first word of the section, zeroed by the
+ *                  CPU). The CPU continues with the other sections meanwhile.
+ *                  State: r7 - current block, r8 - next block, r9 - bytes left
+ *                  to start, r10 - channel (0 - no transfer). Uses r0-r4.
+ */
+
+.section .text.ZeroDmaStart
+.type ZeroDmaStart, %function
+
+ZeroDmaStart:
+    mov r10, #0
+    subs r9, r1, r0
+    beq ZeroDmaStartDone
+
+    /* The source word */
+    movs r3, #0
+    str r3, [r0], #4
+    subs r9, r9, #4
+    beq ZeroDmaStartDone
+
+    /* Enable GPDMA1 clock */
+    ldr r3, = RCC_AHB1ENR
+    ldr r4, [r3]
+    orr r4, r4, #RCC_AHB1ENR_GPDMA1EN
+    str r4, [r3]
+    ldr r4, [r3]
+
+    /* Configure the channel: 32 bit, destination increment, software request */
+    ldr r10, = DMA_CHANNEL
+    ldr r3, = DMA_CTR1_VALUE
+    str r3, [r10, #DMA_CTR1]
+    mov r3, #DMA_CTR2_SWREQ
+    str r3, [r10, #DMA_CTR2]
+    movs r3, #0
+    str r3, [r10, #DMA_CLLR]
+    sub r3, r0, #4
+    str r3, [r10, #DMA_CSAR]
+
+    mov r8, r0
+    b ZeroDmaBlock
+
+ZeroDmaStartDone:
+    bx lr
+
+.size ZeroDmaStart, .-ZeroDmaStart
+
+/**
+ * @brief           Start the next block (up to DMA_BLOCK_SIZE) of the zero fill.
+ *                  Uses r3-r4.
+ */
+
+.section .text.ZeroDmaBlock
+.type ZeroDmaBlock, %function
+
+ZeroDmaBlock:
+    ldr r3, = DMA_BLOCK_SIZE
+    cmp r9, r3
+    it lo
+    movlo r3, r9
+
+    mov r4, #DMA_CFCR_ALL
+    str r4, [r10, #DMA_CFCR]
+    str r3, [r10, #DMA_CBR1]
+    str r8, [r10, #DMA_CDAR]
+
+    mov r7, r8
+    add r8, r8, r3
+    sub r9, r9, r3
+
+    movs r4, #1
+    str r4, [r10, #DMA_CCR]
+    bx lr
+
+.size ZeroDmaBlock, .-ZeroDmaBlock
+
+/**
+ * @brief           Wait for the zero fill, starting the remaining blocks.
+ *                  On a transfer error the rest is zeroed by the CPU.
+ *                  Uses r0-r6.
+ */
+
+.section .text.ZeroDmaWait
+.type ZeroDmaWait, %function
+
+ZeroDmaWait:
+    cmp r10, #0
+    beq ZeroDmaWaitDone
+    push {lr}
+
+LoopZeroDmaWait:
+    ldr r3, [r10, #DMA_CSR]
+    tst r3, #DMA_CSR_ERRORS
+    bne ZeroDmaError
+    tst r3, #DMA_CSR_TCF
+    beq LoopZeroDmaWait
+
+    cmp r9, #0
+    beq ZeroDmaWaitEnd
+    bl ZeroDmaBlock
+    b LoopZeroDmaWait
+
+ZeroDmaError:
+    movs r3, #0
+    str r3, [r10, #DMA_CCR]
+    mov r0, r7
+    add r1, r8, r9
+    bl ZeroInit
+
+ZeroDmaWaitEnd:
+    pop {lr}
+
+ZeroDmaWaitDone:
+    bx lr
+
+.size ZeroDmaWait, .-ZeroDmaWait
+
 /**
  * @brief           This is the code that gets called when the processor receives an
  *                  unexpected interrupt. This simply enters an infinite loop, preserving
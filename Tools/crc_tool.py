@@ -0,0 +1,134 @@
+#!/usr/bin/env python3
+#
+# Copyright (C) 2025 zhmaksim <zhiharev.maxim.alexandrovich@yandex.ru>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+"""
+Эталонный расчет CRC-32 для проверки crc.c (Boot и App).
+
+Повторяет расчет по таблице crc_calculate_software() и сверяет его с
+zlib.crc32 - тот же результат дает периферия CRC в настройке crc_start().
+Для образа (результат Tools/image_tool.py или Tools/update_tool.py)
+выводит значения, которые вычисляет устройство:
+    image    - весь файл, дополненный 0xFF до кратного 4 (как в
+               update_tool.py): идентификатор образа и проверка слота Boot
+               после записи;
+    payload  - образ после заголовка, scrub_crc в App;
+    range    - диапазон --offset/--size (например, окно сравнения
+               SCRUB_BENCHMARK_SIZE).
+
+С ключом --table выводит таблицу crc_table[] для crc.c.
+
+Пример:
+    Tools/crc_tool.py App_a.img
+    Tools/crc_tool.py App_a.img --offset 0x400 --size 0x10000
+"""
+
+import argparse
+import struct
+import sys
+import zlib
+
+CRC_POLYNOMIAL_REFLECTED = 0xEDB88320
+
+IMAGE_HEADER_MAGIC = 0x474D4941
+IMAGE_HEADER_SIZE = 0x400
+
+CHECK_DATA = b"123456789"
+CHECK_VALUE = 0xCBF43926        # CRC-32/ISO-HDLC
+
+
+def crc_table():
+    table = []
+    for n in range(256):
+        crc = n
+        for _ in range(8):
+            crc = (crc >> 1) ^ (CRC_POLYNOMIAL_REFLECTED if crc & 1 else 0)
+        table.append(crc)
+    return table
+
+
+CRC_TABLE = crc_table()
+
+
+def crc_calculate_software(crc, data):
+    """Повторение crc_calculate_software() из crc.c."""
+    crc ^= 0xFFFFFFFF
+    for byte in data:
+        crc = (crc >> 8) ^ CRC_TABLE[(crc ^ byte) & 0xFF]
+    return crc ^ 0xFFFFFFFF
+
+
+def crc32(data):
+    crc = crc_calculate_software(0, data)
+    if crc != zlib.crc32(data):
+        raise ValueError("table CRC does not match zlib.crc32")
+    return crc
+
+
+def print_table():
+    for i in range(0, len(CRC_TABLE), 6):
+        print("    " + ", ".join(f"0x{value:08X}" for value in CRC_TABLE[i:i + 6]) + ",")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("input", nargs="?", help="файл образа")
+    parser.add_argument("--offset", type=lambda x: int(x, 0), help="начало диапазона (байт)")
+    parser.add_argument("--size", type=lambda x: int(x, 0), help="размер диапазона (байт)")
+    parser.add_argument("--table", action="store_true", help="вывести таблицу crc_table[]")
+    args = parser.parse_args()
+
+    if crc32(CHECK_DATA) != CHECK_VALUE:
+        print("CRC-32 check value mismatch", file=sys.stderr)
+        return 1
+
+    if args.table:
+        print_table()
+        return 0
+
+    if args.input is None:
+        parser.error("input is required")
+
+    with open(args.input, "rb") as file:
+        data = file.read()
+
+    try:
+        image = data + b"\xff" * (-len(data) % 4)
+        print(f"image    0x{crc32(image):08x}  {len(image)} bytes")
+
+        if len(data) >= 8 and struct.unpack_from("<I", data)[0] == IMAGE_HEADER_MAGIC:
+            header_size, = struct.unpack_from("<H", data, 6)
+            image_size, = struct.unpack_from("<I", data, 12)
+            payload = data[header_size:header_size + image_size]
+            print(f"payload  0x{crc32(payload):08x}  {len(payload)} bytes")
+
+        if args.offset is not None or args.size is not None:
+            offset = args.offset or 0
+            size = args.size if args.size is not None else len(data) - offset
+            if offset + size > len(data):
+                raise ValueError(f"range 0x{offset:x}+0x{size:x} is outside the file")
+            print(f"range    0x{crc32(data[offset:offset + size]):08x}  "
+                  f"0x{offset:x}+0x{size:x}")
+    except ValueError as error:
+        print(f"{args.input}: {error}", file=sys.stderr)
+        return 1
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
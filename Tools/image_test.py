@@ -0,0 +1,441 @@
+#!/usr/bin/env python3
+#
+# Copyright (C) 2025 zhmaksim <zhiharev.maxim.alexandrovich@yandex.ru>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+"""
+Проверка Boot/Application/image/image.c и lz4.c на хосте.
+
+Собирает image.c и lz4.c Boot компилятором хоста в разделяемую библиотеку
+с окружением Tools/image_test (слоты XSPI, SRAM и SRAM_BKP отображаются по
+адресам МК, HASH и PKA заменяются hashlib и Tools/ecdsa_tool.py) и
+проверяет образы XIP и LZ4 Tools/image_tool.py функциями Boot:
+image_select(), image_load(), image_resume().
+
+Случаи: запуск из обоих слотов, измененные образ и заголовок, чужой ключ,
+выбор более новой версии и возврат к другому слоту (поврежденный образ,
+IMAGE_BOOT_ATTEMPTS запусков без подтверждения), пробуждение из Standby без
+проверки подписи и с измененными заголовком и образом, загрузка в ITCM на
+место кода Boot, поврежденные блоки LZ4 (без записи за пределы буфера).
+
+Пример:
+    Tools/image_test.py
+"""
+
+import argparse
+import ctypes
+import hashlib
+import os
+import random
+import re
+import struct
+import subprocess
+import sys
+import tempfile
+
+import ecdsa_tool
+import image_tool
+from test_check import Check
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+SOURCES = [
+    "Tools/image_test/image_test.c",
+    "Boot/Application/image/image.c",
+    "Boot/Application/image/lz4.c",
+]
+
+# Каталог заглушек - первым: заменяет main.h, hash.h, pka.h и другие модули Boot
+INCLUDES = [
+    "Tools/image_test",
+    "Boot/Application/image/include",
+]
+
+IMAGE_H = os.path.join(ROOT, "Boot/Application/image/include/image.h")
+IMAGE_KEY_HEADER = os.path.join(ROOT, "Boot/Application/image/include/image_key.h")
+
+# Конец кода Boot в ITCM (_eitcm_text): задается при компоновке, ITCM на хосте не отображается
+TEST_EITCM_TEXT = 0x1000
+
+TEST_LOAD_ADDRESS = [0x24000000, 0x24040000]
+
+TEST_SRAM_ADDRESS = 0x24000000
+TEST_SRAM_SIZE = 0x00072000
+TEST_BKPSRAM_ADDRESS = 0x38800000
+TEST_BKPSRAM_SIZE = 0x1000
+
+TEST_LZ4_ROUNDS = 200
+TEST_LZ4_GUARD = 64
+
+# Размер подписываемой части заголовка (offsetof(struct image_header, signature))
+IMAGE_SIGNED_SIZE = struct.calcsize(image_tool.IMAGE_HEADER_FORMAT)
+IMAGE_DIGEST_SIZE = 32
+IMAGE_STATE_FORMAT = "<IIII"
+
+HASH_CALLBACK = ctypes.CFUNCTYPE(ctypes.c_int32, ctypes.c_void_p, ctypes.c_uint32, ctypes.c_void_p)
+VERIFY_CALLBACK = ctypes.CFUNCTYPE(ctypes.c_int32, ctypes.c_void_p, ctypes.c_void_p, ctypes.c_void_p)
+
+
+def image_constant(name):
+    """Константа image.h."""
+    with open(IMAGE_H) as file:
+        match = re.search(rf"#define\s+{name}\s+(0x[0-9A-Fa-f]+|-?\d+)", file.read())
+    if match is None:
+        raise ValueError(f"{IMAGE_H}: {name} not found")
+    return int(match.group(1), 0)
+
+
+def load_public_key():
+    """Открытый ключ Boot из image_key.h (x || y)."""
+    with open(IMAGE_KEY_HEADER) as file:
+        text = file.read()
+    key = bytes(int(value, 16) for value in re.findall(r"0x([0-9A-Fa-f]{2})", text))
+    if len(key) != 2 * ecdsa_tool.P256_SIZE:
+        raise ValueError(f"{IMAGE_KEY_HEADER}: public key size {len(key)}")
+    return (int.from_bytes(key[:ecdsa_tool.P256_SIZE], "big"),
+            int.from_bytes(key[ecdsa_tool.P256_SIZE:], "big"))
+
+
+class Boot:
+    """image.c и lz4.c Boot, собранные компилятором хоста."""
+
+    def __init__(self, cc, directory):
+        output = os.path.join(directory, "image_test.so")
+        # Адреса МК 32 бит: приведения адрес <-> указатель на хосте 64 бит корректны
+        command = [cc, "-shared", "-fPIC", "-O2", "-std=gnu11", "-o", output,
+                   "-Wno-int-to-pointer-cast", "-Wno-pointer-to-int-cast",
+                   f"-Wl,--defsym,_eitcm_text=0x{TEST_EITCM_TEXT:x}"]
+        command += ["-I" + os.path.join(ROOT, path) for path in INCLUDES]
+        command += [os.path.join(ROOT, path) for path in SOURCES]
+        subprocess.run(command, check=True)
+
+        self.lib = ctypes.CDLL(output)
+        self.lib.image_test_get_verify_count.restype = ctypes.c_uint32
+        self.lib.image_get_header_digest.restype = ctypes.c_void_p
+        self.lib.image_select.argtypes = [ctypes.POINTER(ctypes.c_void_p)]
+        self.lib.image_resume.argtypes = [ctypes.c_uint32, ctypes.c_uint32, ctypes.c_char_p,
+                                          ctypes.POINTER(ctypes.c_void_p)]
+        self.lib.image_load.argtypes = [ctypes.c_void_p]
+        self.lib.lz4_decompress.argtypes = [ctypes.c_char_p, ctypes.c_uint32, ctypes.c_void_p, ctypes.c_uint32]
+
+        if self.lib.image_test_map() != 0:
+            raise OSError("image_test_map: MCU address range is busy in the host process")
+
+        # Ссылки на обратные вызовы хранятся, пока библиотека их использует
+        self.hash = HASH_CALLBACK(self.hash_sha256)
+        self.verify = VERIFY_CALLBACK(self.pka_ecdsa_verify_p256)
+        self.lib.image_test_set_callbacks(self.hash, self.verify)
+
+    @staticmethod
+    def hash_sha256(data, size, digest):
+        ctypes.memmove(digest, hashlib.sha256(ctypes.string_at(data, size)).digest(), IMAGE_DIGEST_SIZE)
+        return 0
+
+    @staticmethod
+    def pka_ecdsa_verify_p256(public_key, digest, signature):
+        key = ctypes.string_at(public_key, 2 * ecdsa_tool.P256_SIZE)
+        public = (int.from_bytes(key[:ecdsa_tool.P256_SIZE], "big"),
+                  int.from_bytes(key[ecdsa_tool.P256_SIZE:], "big"))
+        valid = ecdsa_tool.verify(public, ctypes.string_at(digest, IMAGE_DIGEST_SIZE),
+                                  ctypes.string_at(signature, 2 * ecdsa_tool.P256_SIZE))
+        return 0 if valid else -1
+
+    @staticmethod
+    def read(address, size):
+        return ctypes.string_at(address, size)
+
+    @staticmethod
+    def write(address, data):
+        ctypes.memmove(address, data, len(data))
+
+    def reset(self, slots=None, state=True):
+        """Стереть слоты и SRAM, сбросить состояние запуска (холодный запуск)."""
+        for address in image_tool.IMAGE_SLOT_ADDRESS.values():
+            ctypes.memset(address, 0xFF, image_tool.IMAGE_SLOT_SIZE)
+        ctypes.memset(TEST_SRAM_ADDRESS, 0xFF, TEST_SRAM_SIZE)
+        if state:
+            ctypes.memset(TEST_BKPSRAM_ADDRESS, 0xFF, TEST_BKPSRAM_SIZE)
+        for slot, image in (slots or {}).items():
+            self.write(image_tool.IMAGE_SLOT_ADDRESS[slot], image)
+
+    def select(self):
+        """image_select(): адрес заголовка выбранного образа или None."""
+        header = ctypes.c_void_p()
+        return header.value if self.lib.image_select(ctypes.byref(header)) == 0 else None
+
+    def resume(self, address, image_version, header_digest):
+        """image_resume(): адрес заголовка или None."""
+        header = ctypes.c_void_p()
+        status = self.lib.image_resume(address, image_version, header_digest, ctypes.byref(header))
+        return header.value if status == 0 else None
+
+    def load(self, header):
+        return self.lib.image_load(header) == 0
+
+    def header_digest(self):
+        return ctypes.string_at(self.lib.image_get_header_digest(), IMAGE_DIGEST_SIZE)
+
+    def verify_count(self):
+        return self.lib.image_test_get_verify_count()
+
+    def state(self):
+        """struct image_state в SRAM_BKP: magic, slot, image_version, attempts."""
+        address = TEST_BKPSRAM_ADDRESS + 0x100
+        return struct.unpack(IMAGE_STATE_FORMAT, self.read(address, struct.calcsize(IMAGE_STATE_FORMAT)))
+
+    def lz4_decompress(self, block, size, guard=TEST_LZ4_GUARD):
+        """lz4_decompress() в буфер с защитными байтами: статус, данные, защита цела."""
+        buffer = ctypes.create_string_buffer(b"\xa5" * (size + 2 * guard), size + 2 * guard)
+        status = self.lib.lz4_decompress(block, len(block), ctypes.addressof(buffer) + guard, size)
+        raw = buffer.raw
+        intact = raw[:guard] == b"\xa5" * guard and raw[guard + size:] == b"\xa5" * guard
+        return status, raw[guard:guard + size], intact
+
+
+def make_app(vector_address, size):
+    """Тестовый App: таблица векторов, код (повторы) и данные (без повторов)."""
+    stack = 0x20020000
+    reset = vector_address + 0x400 | 1
+    app = bytearray(struct.pack("<II", stack, reset))
+    app += struct.pack("<I", vector_address + 0x401) * 254
+    while len(app) < size // 2:
+        app += bytes(range(len(app) % 7, 256, 3))
+    app += hashlib.sha256(app).digest() * ((size - len(app)) // 32 + 1)
+    return bytes(app[:size])
+
+
+def build_image(directory, app, slot, lz4, load_address, key=image_tool.IMAGE_KEY, image_version=7):
+    """Сформировать образ Tools/image_tool.py."""
+    app_path = os.path.join(directory, "App.bin")
+    image_path = os.path.join(directory, "App.img")
+
+    with open(app_path, "wb") as file:
+        file.write(app)
+
+    command = [sys.executable, os.path.join(ROOT, "Tools/image_tool.py"), app_path,
+               "--slot", slot, "--image-version", str(image_version), "--output", image_path, "--key", key]
+    if lz4:
+        command += ["--lz4", "--load-address", hex(load_address)]
+    subprocess.run(command, check=True, stdout=subprocess.DEVNULL)
+
+    with open(image_path, "rb") as file:
+        return file.read()
+
+
+def modify(image, offset):
+    broken = bytearray(image)
+    broken[offset] ^= 0x01
+    return bytes(broken)
+
+
+def resign(image, offset, value):
+    """Изменить поле заголовка и подписать заголовок заново ключом Boot."""
+    header = bytearray(image[:IMAGE_SIGNED_SIZE])
+    struct.pack_into("<I", header, offset, value)
+    private = ecdsa_tool.load_key(image_tool.IMAGE_KEY)
+    signature = ecdsa_tool.sign(private, hashlib.sha256(header).digest())
+    return bytes(header) + signature + image[IMAGE_SIGNED_SIZE + len(signature):]
+
+
+def test_slots(check, boot, directory, app_size, other_key):
+    """Запуск XIP и LZ4 из обоих слотов, отрицательные случаи."""
+    cases = [(slot, False, image_tool.IMAGE_SLOT_ADDRESS[slot] + image_tool.IMAGE_HEADER_SIZE)
+             for slot in image_tool.IMAGE_SLOT_ADDRESS]
+    cases += [(slot, True, address)
+              for slot in image_tool.IMAGE_SLOT_ADDRESS for address in TEST_LOAD_ADDRESS]
+
+    for slot, lz4, vector_address in cases:
+        name = f"slot {slot} " + (f"lz4 -> 0x{vector_address:08x}" if lz4 else "xip")
+        slot_address = image_tool.IMAGE_SLOT_ADDRESS[slot]
+        app = make_app(vector_address, app_size)
+        image = build_image(directory, app, slot, lz4, vector_address)
+
+        boot.reset({slot: image})
+        if lz4:
+            # Область загрузки до распаковки не содержит образа
+            check(f"{name}: load region empty before verify", boot.read(vector_address, len(app)) != app)
+        header = boot.select()
+        check(f"{name}: accept", header == slot_address)
+        check(f"{name}: load", header is not None and boot.load(header))
+        check(f"{name}: loaded image", boot.read(vector_address, len(app)) == app)
+        check(f"{name}: header digest",
+              boot.header_digest() == hashlib.sha256(image[:IMAGE_SIGNED_SIZE]).digest())
+        check(f"{name}: state", boot.state()[1:] == (list(image_tool.IMAGE_SLOT_ADDRESS).index(slot), 7, 1))
+
+        boot.reset({slot: modify(image, (image_tool.IMAGE_HEADER_SIZE + len(image)) // 2)})
+        check(f"{name}: reject modified image", boot.select() is None)
+
+        boot.reset({slot: modify(image, 8)})    # image_version
+        check(f"{name}: reject modified header", boot.select() is None)
+
+        boot.reset({slot: build_image(directory, app, slot, lz4, vector_address, other_key)})
+        check(f"{name}: reject other key", boot.select() is None)
+
+
+def test_fallback(check, boot, directory, app_size):
+    """Выбор более новой версии и возврат к другому слоту."""
+    attempts = image_constant("IMAGE_BOOT_ATTEMPTS")
+    slot_a = image_tool.IMAGE_SLOT_ADDRESS["a"]
+    slot_b = image_tool.IMAGE_SLOT_ADDRESS["b"]
+    image_a = build_image(directory, make_app(slot_a + image_tool.IMAGE_HEADER_SIZE, app_size),
+                          "a", False, 0, image_version=7)
+    image_b = build_image(directory, make_app(TEST_LOAD_ADDRESS[0], app_size),
+                          "b", True, TEST_LOAD_ADDRESS[0], image_version=8)
+
+    boot.reset({"a": image_a, "b": image_b})
+    check("a/b: newer version first", boot.select() == slot_b)
+
+    boot.reset({"a": image_a, "b": modify(image_b, len(image_b) - 1)})
+    check("a/b: fall back from corrupted image", boot.select() == slot_a)
+
+    boot.reset({"a": image_a, "b": image_b})
+    selected = [boot.select() for _ in range(attempts)]
+    check(f"a/b: {attempts} unconfirmed boots", selected == [slot_b] * attempts
+          and boot.state()[3] == attempts)
+    check("a/b: fall back from unconfirmed image", boot.select() == slot_a)
+
+    boot.reset({"b": image_b})
+    selected = [boot.select() for _ in range(attempts + 1)]
+    check("a/b: unconfirmed image without alternative", selected == [slot_b] * (attempts + 1))
+
+
+def test_resume(check, boot, directory, app_size):
+    """Пробуждение из Standby: image_resume()."""
+    slot_address = image_tool.IMAGE_SLOT_ADDRESS["a"]
+    vector_address = TEST_LOAD_ADDRESS[0]
+    app = make_app(vector_address, app_size)
+    image = build_image(directory, app, "a", True, vector_address)
+
+    def cold_boot(slot_image):
+        boot.reset({"a": slot_image})
+        header = boot.select()
+        return header is not None and boot.load(header), boot.header_digest()
+
+    # Содержимое SRAM при пробуждении из Standby теряется, SRAM_BKP сохраняется
+    def wake(slot_image, image_version, header_digest):
+        boot.reset({"a": slot_image}, state=False)
+        return boot.resume(slot_address, image_version, header_digest)
+
+    loaded, digest = cold_boot(image)
+    count = boot.verify_count()
+    header = wake(image, 7, digest)
+    check("resume: accept", loaded and header == slot_address)
+    check("resume: signature not verified", boot.verify_count() == count)
+    check("resume: load", header is not None and boot.load(header)
+          and boot.read(vector_address, len(app)) == app)
+    check("resume: attempts not counted", boot.state()[3] == 1)
+
+    cold_boot(image)
+    check("resume: reject other version", wake(image, 8, digest) is None)
+
+    cold_boot(image)
+    check("resume: reject other address", boot.resume(slot_address + 0x400, 7, digest) is None)
+
+    cold_boot(image)
+    check("resume: reject other header digest", wake(image, 7, bytes(IMAGE_DIGEST_SIZE)) is None)
+
+    cold_boot(image)
+    check("resume: reject modified image", wake(modify(image, len(image) - 1), 7, digest) is None)
+
+    # Заголовок с другим адресом загрузки подписан тем же ключом и корректен:
+    # отклоняется только по SHA-256 подписанных полей
+    moved = resign(image, 16, TEST_LOAD_ADDRESS[1])     # vector_address
+    boot.reset({"a": moved})
+    check("resume: moved header is valid", boot.select() == slot_address)
+    cold_boot(image)
+    check("resume: reject moved load address", wake(moved, 7, digest) is None)
+
+    cold_boot(image)
+    ctypes.memset(TEST_BKPSRAM_ADDRESS + 0x100, 0, 4)
+    check("resume: reject without state", wake(image, 7, digest) is None)
+
+
+def test_itcm(check, boot, directory):
+    """Загрузка в ITCM на место кода Boot (.itcm_text)."""
+    for address in (0x0000, TEST_EITCM_TEXT - 0x400):
+        app = make_app(address, 0x800)
+        boot.reset({"a": build_image(directory, app, "a", True, address)})
+        check(f"itcm: reject load to 0x{address:04x} (_eitcm_text 0x{TEST_EITCM_TEXT:04x})",
+              boot.select() is None)
+
+
+def test_lz4(check, boot, app_size, seed):
+    """lz4_decompress(): корректный и поврежденные блоки."""
+    app = make_app(TEST_LOAD_ADDRESS[0], app_size)
+    block = image_tool.lz4_compress(app)
+
+    status, data, intact = boot.lz4_decompress(block, len(app))
+    check("lz4: decompress", status == 0 and data == app and intact)
+
+    status, _, intact = boot.lz4_decompress(block[:len(block) // 2], len(app))
+    check("lz4: reject truncated block", status != 0 and intact)
+
+    status, _, intact = boot.lz4_decompress(block, len(app) - 1)
+    check("lz4: reject small buffer", status != 0 and intact)
+
+    status, _, intact = boot.lz4_decompress(block, len(app) + 1)
+    check("lz4: reject short data", status != 0 and intact)
+
+    generator = random.Random(seed)
+    overrun = 0
+    for _ in range(TEST_LZ4_ROUNDS):
+        broken = bytearray(block)
+        for _ in range(generator.randint(1, 8)):
+            broken[generator.randrange(len(broken))] = generator.randrange(256)
+        _, _, intact = boot.lz4_decompress(bytes(broken), len(app))
+        overrun += not intact
+    check(f"lz4: {TEST_LZ4_ROUNDS} corrupted blocks within buffer", overrun == 0)
+
+
+def run_tests(cc, app_size, seed):
+    check = Check()
+
+    public = load_public_key()
+    check("image_key.h matches image_key.pem",
+          public == ecdsa_tool.public_key(ecdsa_tool.load_key(image_tool.IMAGE_KEY)))
+
+    with tempfile.TemporaryDirectory() as directory:
+        boot = Boot(cc, directory)
+
+        other_key = os.path.join(directory, "other.pem")
+        with open(other_key, "w") as file:
+            file.write(ecdsa_tool.key_to_pem(ecdsa_tool.RFC6979_KEY))
+
+        test_slots(check, boot, directory, app_size, other_key)
+        test_fallback(check, boot, directory, app_size)
+        test_resume(check, boot, directory, app_size)
+        test_itcm(check, boot, directory)
+        test_lz4(check, boot, app_size, seed)
+
+    return check.summary()
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--cc", default="cc", help="компилятор хоста")
+    parser.add_argument("--size", type=int, default=96 * 1024, help="размер тестового App (байт)")
+    parser.add_argument("--seed", type=int, default=1, help="начальное значение генератора повреждений LZ4")
+    args = parser.parse_args()
+
+    try:
+        return run_tests(args.cc, args.size, args.seed)
+    except (OSError, ValueError, subprocess.CalledProcessError) as error:
+        print(error, file=sys.stderr)
+        return 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
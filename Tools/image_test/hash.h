@@ -0,0 +1,32 @@
+/**
+ * Copyright (C) 2025 zhmaksim <zhiharev.maxim.alexandrovich@yandex.ru>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef HASH_H_
+#define HASH_H_
+
+/* HASH Boot для сборки на хосте: SHA-256 рассчитывает Tools/image_test.py */
+
+#include "main.h"
+
+#define HASH_OK                  0
+#define HASH_ERROR              -1
+
+#define HASH_SHA256_SIZE         32
+
+int32_t hash_sha256(const void *data, uint32_t size, uint8_t *digest);
+
+#endif /* HASH_H_ */
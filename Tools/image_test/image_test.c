@@ -0,0 +1,150 @@
+/**
+ * Copyright (C) 2025 zhmaksim <zhiharev.maxim.alexandrovich@yandex.ru>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * Окружение Boot/Application/image/image.c и lz4.c на хосте.
+ *
+ * Отображает по адресам МК слоты XSPI, AXI SRAM и SRAM_BKP (image.c
+ * обращается к ним по абсолютным адресам), HASH и PKA заменяются
+ * обратными вызовами Tools/image_test.py. _eitcm_text задается при
+ * компоновке (--defsym): ITCM по адресу 0 на хосте не отображается.
+ *
+ * Сборка и запуск: Tools/image_test.py
+ */
+
+/* Includes ---------------------------------------------------------------- */
+
+#include <sys/mman.h>
+#include "image.h"
+#include "hash.h"
+#include "pka.h"
+#include "telemetry.h"
+#include "cache.h"
+
+/* Private macros ---------------------------------------------------------- */
+
+/* Private constants ------------------------------------------------------- */
+
+#define IMAGE_TEST_REGION_COUNT         3
+
+/* Private types ----------------------------------------------------------- */
+
+typedef int32_t (*image_test_hash_t)(const void *data, uint32_t size, uint8_t *digest);
+
+typedef int32_t (*image_test_verify_t)(const uint8_t *public_key, const uint8_t *digest, const uint8_t *signature);
+
+
+/**
+ * @brief           Определение структуры данных отображаемой области
+ */
+struct image_test_region {
+    uint32_t address;                           /*!< Адрес области МК */
+
+    uint32_t size;                              /*!< Размер области (байт) */
+};
+
+/* Private variables ------------------------------------------------------- */
+
+static const struct image_test_region region[IMAGE_TEST_REGION_COUNT] = {
+    { IMAGE_SLOT_A_ADDRESS, IMAGE_SLOT_COUNT * IMAGE_SLOT_SIZE },
+    { IMAGE_SRAM_ADDRESS, IMAGE_SRAM_SIZE },
+    { BKPSRAM_BASE, 0x1000 },
+};
+
+static image_test_hash_t hash_callback;
+
+static image_test_verify_t verify_callback;
+
+static uint32_t verify_count;
+
+/* Private function prototypes --------------------------------------------- */
+
+/* Private user code ------------------------------------------------------- */
+
+/**
+ * @brief           Отобразить области памяти МК и заполнить их 0xFF
+ *
+ * @return          0 - успешно, -1 - адрес занят в процессе хоста
+ */
+int32_t image_test_map(void)
+{
+    for (uint32_t i = 0; i < IMAGE_TEST_REGION_COUNT; i++) {
+        void *address = (void *) (uintptr_t) region[i].address;
+        void *result = mmap(address, region[i].size, PROT_READ | PROT_WRITE,
+                            MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+
+        if (result != address)
+            return -1;
+
+        memset(address, 0xFF, region[i].size);
+    }
+
+    return 0;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Задать обратные вызовы HASH и PKA
+ *
+ * @param[in]       hash: SHA-256
+ * @param[in]       verify: Проверка подписи ECDSA P-256
+ */
+void image_test_set_callbacks(image_test_hash_t hash, image_test_verify_t verify)
+{
+    hash_callback = hash;
+    verify_callback = verify;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Получить количество проверок подписи (PKA)
+ *
+ * @return          Количество вызовов pka_ecdsa_verify_p256()
+ */
+uint32_t image_test_get_verify_count(void)
+{
+    return verify_count;
+}
+/* ------------------------------------------------------------------------- */
+
+int32_t hash_sha256(const void *data, uint32_t size, uint8_t *digest)
+{
+    return hash_callback(data, size, digest);
+}
+/* ------------------------------------------------------------------------- */
+
+int32_t pka_ecdsa_verify_p256(const uint8_t *public_key, const uint8_t *digest, const uint8_t *signature)
+{
+    verify_count++;
+
+    return verify_callback(public_key, digest, signature);
+}
+/* ------------------------------------------------------------------------- */
+
+void telemetry_stamp(uint32_t stage, uint32_t frequency)
+{
+    (void) stage;
+    (void) frequency;
+}
+/* ------------------------------------------------------------------------- */
+
+void cache_clean(const volatile void *addr, size_t size)
+{
+    (void) addr;
+    (void) size;
+}
+/* ------------------------------------------------------------------------- */
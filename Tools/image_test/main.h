@@ -0,0 +1,58 @@
+/**
+ * Copyright (C) 2025 zhmaksim <zhiharev.maxim.alexandrovich@yandex.ru>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MAIN_H_
+#define MAIN_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/* Includes ---------------------------------------------------------------- */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+/* Exported macros --------------------------------------------------------- */
+
+/* Замена cmsis_gcc.h для lz4.c */
+#define __UNALIGNED_UINT32_READ(addr)           \
+    ({ uint32_t value; memcpy(&value, (const void *) (addr), sizeof(value)); value; })
+#define __UNALIGNED_UINT32_WRITE(addr, value)   \
+    do { uint32_t tmp = (value); memcpy((void *) (addr), &tmp, sizeof(tmp)); } while (0)
+
+/* Exported constants ------------------------------------------------------ */
+
+/* Замена CMSIS для сборки модулей Boot на хосте: адрес отображается
+   Tools/image_test/image_test.c (image_test_map) */
+#define BKPSRAM_BASE            0x38800000UL
+
+/* Exported types ---------------------------------------------------------- */
+
+/* Exported variables ------------------------------------------------------ */
+
+/* Exported function prototypes -------------------------------------------- */
+
+/* Exported callback function prototypes ----------------------------------- */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* MAIN_H_ */
@@ -0,0 +1,32 @@
+/**
+ * Copyright (C) 2025 zhmaksim <zhiharev.maxim.alexandrovich@yandex.ru>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PKA_H_
+#define PKA_H_
+
+/* PKA Boot для сборки на хосте: подпись проверяет Tools/image_test.py (ecdsa_tool.verify) */
+
+#include "main.h"
+
+#define PKA_OK                   0
+#define PKA_ERROR               -1
+
+#define PKA_P256_SIZE           32
+
+int32_t pka_ecdsa_verify_p256(const uint8_t *public_key, const uint8_t *digest, const uint8_t *signature);
+
+#endif /* PKA_H_ */
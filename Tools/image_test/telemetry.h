@@ -0,0 +1,32 @@
+/**
+ * Copyright (C) 2025 zhmaksim <zhiharev.maxim.alexandrovich@yandex.ru>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef TELEMETRY_H_
+#define TELEMETRY_H_
+
+/* Телеметрия Boot для сборки на хосте: этапы image.c, отметки не записываются */
+
+#include "main.h"
+
+enum telemetry_stage {
+    TELEMETRY_STAGE_IMAGE_SIGNATURE,
+    TELEMETRY_STAGE_IMAGE_DIGEST,
+};
+
+void telemetry_stamp(uint32_t stage, uint32_t frequency);
+
+#endif /* TELEMETRY_H_ */
@@ -0,0 +1,244 @@
+#!/usr/bin/env python3
+#
+# Copyright (C) 2025 zhmaksim <zhiharev.maxim.alexandrovich@yandex.ru>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+"""
+Формирование образа App для слота внешней FLASH.
+
+Добавляет к двоичному файлу App (arm-none-eabi-objcopy -O binary, начинается
+с таблицы векторов) заголовок struct image_header из
+Boot/Application/image/include/image.h. Результат записывается в начало слота.
+
+С ключом --lz4 образ сжимается (блочный формат LZ4), Boot распаковывает его
+по адресу --load-address. App для этого режима компонуется со скриптом
+App/linker_stm32h7s3xx_ram.ld.
+
+Заголовок подписывается ECDSA P-256 ключом --key (Tools/ecdsa_tool.py),
+Boot проверяет подпись открытым ключом Boot/Application/image/include/image_key.h.
+Tools/image_key.pem - ключ разработки, для выпуска нужен собственный ключ.
+
+Пример:
+    Tools/image_tool.py App.bin --slot a --image-version 7 --output App_a.img
+    Tools/image_tool.py App.bin --slot b --image-version 8 --lz4 --output App_b.img
+"""
+
+import argparse
+import hashlib
+import os
+import struct
+import sys
+
+import ecdsa_tool
+
+IMAGE_SLOT_SIZE = 0x00800000
+IMAGE_SLOT_ADDRESS = {"a": 0x70000000, "b": 0x70000000 + IMAGE_SLOT_SIZE}
+
+IMAGE_HEADER_SIZE = 0x400
+IMAGE_HEADER_MAGIC = 0x474D4941
+IMAGE_HEADER_VERSION = 3
+
+IMAGE_FLAG_LZ4 = 0x01
+
+# Области загрузки сжатого образа: адрес, размер
+IMAGE_LOAD_REGIONS = [(0x00000000, 0x00010000), (0x24000000, 0x00072000)]
+
+# magic, version, header_size, image_version, image_size, vector_address, flags, load_size, digest
+# (подписываемая часть заголовка, за ней - подпись r || s)
+IMAGE_HEADER_FORMAT = "<IHHIIIII32s"
+
+IMAGE_KEY = os.path.join(os.path.dirname(os.path.abspath(__file__)), "image_key.pem")
+
+LZ4_MIN_MATCH = 4
+LZ4_LAST_LITERALS = 5           # последние байты блока - всегда литералы
+LZ4_MATCH_LIMIT = 12            # совпадение не начинается ближе к концу блока
+LZ4_MAX_OFFSET = 0xFFFF
+
+
+def lz4_write_length(out, length):
+    while length >= 255:
+        out.append(255)
+        length -= 255
+    out.append(length)
+
+
+def lz4_write_sequence(out, literals, offset, match_length):
+    literal_length = len(literals)
+    token = min(literal_length, 15) << 4
+    if offset:
+        token |= min(match_length - LZ4_MIN_MATCH, 15)
+    out.append(token)
+    if literal_length >= 15:
+        lz4_write_length(out, literal_length - 15)
+    out += literals
+    if offset:
+        out += struct.pack("<H", offset)
+        if match_length - LZ4_MIN_MATCH >= 15:
+            lz4_write_length(out, match_length - LZ4_MIN_MATCH - 15)
+
+
+def lz4_compress(data):
+    """Сжать данные в блок LZ4 (жадный поиск по хэшу 4 байт)."""
+    out = bytearray()
+    table = {}
+    anchor = 0
+    pos = 0
+    match_end = len(data) - LZ4_LAST_LITERALS
+    match_limit = len(data) - LZ4_MATCH_LIMIT
+
+    while pos < match_limit:
+        key = data[pos:pos + LZ4_MIN_MATCH]
+        candidate = table.get(key)
+        table[key] = pos
+        if candidate is None or pos - candidate > LZ4_MAX_OFFSET:
+            pos += 1
+            continue
+
+        length = LZ4_MIN_MATCH
+        while pos + length < match_end and data[candidate + length] == data[pos + length]:
+            length += 1
+
+        lz4_write_sequence(out, data[anchor:pos], pos - candidate, length)
+        pos += length
+        anchor = pos
+
+    lz4_write_sequence(out, data[anchor:], 0, 0)
+    return bytes(out)
+
+
+def lz4_decompress(block, size):
+    """Распаковать блок LZ4 (проверка результата сжатия)."""
+    out = bytearray()
+    pos = 0
+
+    def read_length(length):
+        nonlocal pos
+        if length == 15:
+            while True:
+                value = block[pos]
+                pos += 1
+                length += value
+                if value != 255:
+                    break
+        return length
+
+    while pos < len(block):
+        token = block[pos]
+        pos += 1
+        length = read_length(token >> 4)
+        out += block[pos:pos + length]
+        pos += length
+        if pos == len(block):
+            break
+        offset = block[pos] | block[pos + 1] << 8
+        pos += 2
+        length = read_length(token & 0x0F) + LZ4_MIN_MATCH
+        for _ in range(length):
+            out.append(out[-offset])
+
+    if len(out) != size:
+        raise ValueError("LZ4 round trip failed")
+    return bytes(out)
+
+
+def build_header(payload, image, vector_address, flags, image_version, key):
+    header = struct.pack(IMAGE_HEADER_FORMAT,
+                         IMAGE_HEADER_MAGIC,
+                         IMAGE_HEADER_VERSION,
+                         IMAGE_HEADER_SIZE,
+                         image_version,
+                         len(payload),
+                         vector_address,
+                         flags,
+                         len(image),
+                         hashlib.sha256(payload).digest())
+
+    digest = hashlib.sha256(header).digest()
+    signature = ecdsa_tool.sign(key, digest)
+    if not ecdsa_tool.verify(ecdsa_tool.public_key(key), digest, signature):
+        raise ValueError("signature self-check failed")
+
+    return (header + signature).ljust(IMAGE_HEADER_SIZE, b"\xff")
+
+
+def check_image(image, vector_address, lz4):
+    if len(image) == 0 or len(image) > IMAGE_SLOT_SIZE - IMAGE_HEADER_SIZE:
+        raise ValueError(f"image size {len(image)} does not fit the slot")
+
+    if lz4:
+        if vector_address & 0x3FF:
+            raise ValueError(f"load address 0x{vector_address:08x} is not 1KB aligned")
+        if not any(address <= vector_address and vector_address + len(image) <= address + size
+                   for address, size in IMAGE_LOAD_REGIONS):
+            raise ValueError(f"image does not fit ITCM or SRAM at 0x{vector_address:08x}")
+
+    reset = struct.unpack_from("<I", image, 4)[0] & ~1
+    if not vector_address <= reset < vector_address + len(image):
+        raise ValueError(f"reset vector 0x{reset:08x} is outside the image, "
+                         f"link the App at 0x{vector_address:08x}")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("input", help="двоичный файл App")
+    parser.add_argument("--slot", choices=IMAGE_SLOT_ADDRESS, default="a", help="слот образа")
+    parser.add_argument("--image-version", type=lambda x: int(x, 0), required=True,
+                        help="версия образа (Boot выбирает наибольшую)")
+    parser.add_argument("--output", required=True, help="файл образа со заголовком")
+    parser.add_argument("--lz4", action="store_true",
+                        help="сжать образ, Boot распакует его в ITCM/SRAM")
+    parser.add_argument("--load-address", type=lambda x: int(x, 0), default=0x24000000,
+                        help="адрес распаковки (адрес компоновки таблицы векторов)")
+    parser.add_argument("--key", default=IMAGE_KEY,
+                        help="закрытый ключ ECDSA P-256 (PEM) для подписи заголовка")
+    args = parser.parse_args()
+
+    with open(args.input, "rb") as file:
+        image = file.read()
+
+    if args.lz4:
+        vector_address = args.load_address
+        flags = IMAGE_FLAG_LZ4
+    else:
+        vector_address = IMAGE_SLOT_ADDRESS[args.slot] + IMAGE_HEADER_SIZE
+        flags = 0
+
+    try:
+        key = ecdsa_tool.load_key(args.key)
+        check_image(image, vector_address, args.lz4)
+        payload = lz4_compress(image) if args.lz4 else image
+        if args.lz4 and lz4_decompress(payload, len(image)) != image:
+            raise ValueError("LZ4 round trip mismatch")
+        if len(payload) > IMAGE_SLOT_SIZE - IMAGE_HEADER_SIZE:
+            raise ValueError(f"payload size {len(payload)} does not fit the slot")
+        header = build_header(payload, image, vector_address, flags, args.image_version, key)
+    except (OSError, ValueError) as error:
+        print(f"{args.input}: {error}", file=sys.stderr)
+        return 1
+
+    with open(args.output, "wb") as file:
+        file.write(header)
+        file.write(payload)
+
+    print(f"{args.output}: slot {args.slot} at 0x{IMAGE_SLOT_ADDRESS[args.slot]:08x}, "
+          f"version {args.image_version}, {len(image)} bytes"
+          + (f", lz4 {len(payload)} bytes ({100.0 * len(payload) / len(image):.1f}%)"
+             f" -> 0x{vector_address:08x}" if args.lz4 else ""))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,186 @@
+#!/usr/bin/env python3
+#
+# Copyright (C) 2025 zhmaksim <zhiharev.maxim.alexandrovich@yandex.ru>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+"""
+Выбор горячих функций App для размещения в ITCM.
+
+По профилю выполнения (число попаданий PC на функцию или сырые адреса PC)
+и таблице символов ELF формирует фрагмент скрипта компоновщика
+App/itcm_functions.ld, который подключается в секцию .itcm_text.
+
+Форматы профиля (по одной записи в строке, '#' - комментарий):
+    vTaskSwitchContext 1520         имя функции и число попаданий
+    0x70001a3c                      адрес PC (одно попадание)
+    0x70001a3c 17                   адрес PC и число попаданий
+
+Требования к сборке App:
+    -ffunction-sections             каждая функция в секции .text.<имя>
+    -L <каталог App>                поиск itcm_functions.ld компоновщиком
+
+Для каждой функции фрагмент содержит ASSERT: без -ffunction-sections (или
+при неверном имени) компоновка завершается ошибкой, а не размещает функцию
+во внешней FLASH без предупреждения.
+
+Пример:
+    Tools/itcm_place.py --elf App.elf --profile pc_samples.txt \\
+                        --output App/itcm_functions.ld
+"""
+
+import argparse
+import subprocess
+import sys
+
+ITCM_SIZE = 0x10000
+
+# Функции, которые размещаются в ITCM независимо от профиля
+DEFAULT_FUNCTIONS = [
+    "PendSV_Handler",           # xPortPendSVHandler (FreeRTOSConfig.h)
+    "vTaskSwitchContext",
+    "xTaskIncrementTick",
+    "SysTick_Handler",
+    "runtime_get_counter",
+    "systick_get_cycles",
+    # Функции FreeRTOS обработчика сбоя (crash_fault): без выборки из XSPI
+    "xTaskGetTickCountFromISR",
+    "xTaskGetCurrentTaskHandle",
+    "xTaskGetSchedulerState",
+    "pcTaskGetName",
+]
+
+
+def read_symbols(nm, elf):
+    """Прочитать функции ELF: имя -> (адрес, размер)."""
+    output = subprocess.run([nm, "--print-size", "--defined-only", elf],
+                            check=True, capture_output=True, text=True).stdout
+    symbols = {}
+    for line in output.splitlines():
+        fields = line.split()
+        if len(fields) != 4 or fields[2] not in "tTwW":
+            continue
+        address = int(fields[0], 16) & ~1
+        size = int(fields[1], 16)
+        symbols[fields[3]] = (address, size)
+    return symbols
+
+
+def read_profile(path, symbols):
+    """Прочитать профиль: имя функции -> число попаданий."""
+    ranges = sorted((address, address + size, name)
+                    for name, (address, size) in symbols.items() if size)
+    samples = {}
+
+    def lookup(pc):
+        lo, hi = 0, len(ranges)
+        while lo < hi:
+            mid = (lo + hi) // 2
+            if ranges[mid][1] <= pc:
+                lo = mid + 1
+            else:
+                hi = mid
+        if lo < len(ranges) and ranges[lo][0] <= pc < ranges[lo][1]:
+            return ranges[lo][2]
+        return None
+
+    with open(path) as file:
+        for line in file:
+            fields = line.split("#", 1)[0].replace(",", " ").split()
+            if not fields:
+                continue
+            count = int(fields[1], 0) if len(fields) > 1 else 1
+            if fields[0].lower().startswith("0x"):
+                name = lookup(int(fields[0], 16) & ~1)
+            else:
+                name = fields[0]
+            if name is not None:
+                samples[name] = samples.get(name, 0) + count
+    return samples
+
+
+def place(symbols, samples, forced, budget):
+    """Выбрать функции: сначала обязательные, затем по плотности попаданий на байт."""
+    selected = []
+    used = 0
+
+    def take(name):
+        nonlocal used
+        size = (symbols[name][1] + 3) & ~3
+        if name in selected or used + size > budget:
+            return
+        selected.append(name)
+        used += size
+
+    for name in forced:
+        if name in symbols:
+            take(name)
+        else:
+            print(f"warning: {name} not found in ELF", file=sys.stderr)
+
+    candidates = [name for name in samples if name in symbols and symbols[name][1]]
+    candidates.sort(key=lambda name: samples[name] / symbols[name][1], reverse=True)
+    for name in candidates:
+        take(name)
+
+    return selected, used
+
+
+def write_script(path, selected):
+    with open(path, "w") as file:
+        file.write("/* Generated by Tools/itcm_place.py, do not edit */\n")
+        for name in selected:
+            file.write(f"*(.text.{name})\n")
+            file.write(f"ASSERT({name} >= _sitcm_text && {name} < ., "
+                       f"\"{name} is not in .itcm_text (-ffunction-sections)\");\n")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--elf", help="ELF файл App (для размеров и адресов функций)")
+    parser.add_argument("--profile", help="файл профиля выполнения")
+    parser.add_argument("--output", default="App/itcm_functions.ld",
+                        help="формируемый фрагмент скрипта компоновщика")
+    parser.add_argument("--nm", default="arm-none-eabi-nm", help="утилита nm")
+    parser.add_argument("--budget", type=lambda x: int(x, 0), default=ITCM_SIZE - 0x1000,
+                        help="доступный объем ITCM (байт), остаток - под __ITCM и вставки")
+    parser.add_argument("--no-defaults", action="store_true",
+                        help="не добавлять обязательный список функций ядра FreeRTOS")
+    args = parser.parse_args()
+
+    forced = [] if args.no_defaults else DEFAULT_FUNCTIONS
+
+    if args.elf is None:
+        # Без ELF размеры неизвестны: записать только обязательный список
+        write_script(args.output, forced)
+        print(f"{args.output}: {len(forced)} functions (defaults only)")
+        return 0
+
+    symbols = read_symbols(args.nm, args.elf)
+    samples = read_profile(args.profile, symbols) if args.profile else {}
+    selected, used = place(symbols, samples, forced, args.budget)
+    write_script(args.output, selected)
+
+    total = sum(samples.values()) or 1
+    covered = sum(samples.get(name, 0) for name in selected)
+    for name in selected:
+        print(f"{symbols[name][1]:6d}  {samples.get(name, 0):8d}  {name}")
+    print(f"{args.output}: {len(selected)} functions, {used} of {args.budget} bytes, "
+          f"{100.0 * covered / total:.1f}% of samples")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
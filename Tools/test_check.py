@@ -0,0 +1,42 @@
+#!/usr/bin/env python3
+#
+# Copyright (C) 2025 zhmaksim <zhiharev.maxim.alexandrovich@yandex.ru>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+"""
+Учет проверок тестов Tools: image_test.py, update_test.py, ecdsa_tool.py test.
+
+Пример:
+    check = Check()
+    check("name", condition)
+    return check.summary()
+"""
+
+
+class Check:
+    """Проверки теста: вывод результата каждой и итог."""
+
+    def __init__(self):
+        self.failures = []
+
+    def __call__(self, name, condition):
+        print(f"{'ok  ' if condition else 'FAIL'} {name}")
+        if not condition:
+            self.failures.append(name)
+
+    def summary(self):
+        """Вывести итог, вернуть код завершения теста."""
+        print(f"{len(self.failures)} failed" if self.failures else "all passed")
+        return 1 if self.failures else 0
@@ -0,0 +1,79 @@
+#!/usr/bin/env python3
+#
+# Copyright (C) 2025 zhmaksim <zhiharev.maxim.alexandrovich@yandex.ru>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+"""
+Сравнение службы таймаутов App с программными таймерами FreeRTOS на хосте.
+
+Собирает компилятором хоста App/Application/timeout/timeout.c, list.c
+FreeRTOS и Tools/timeout_bench/timeout_bench.c (порт FreeRTOS без
+планировщика) и запускает тест: запуск, перезапуск и остановка count
+одновременных таймеров, срабатывание всех таймеров с проверкой тика
+срабатывания. Время выводится в нс на операцию.
+
+Пример:
+    Tools/timeout_bench.py --timers 10000 --span 60000 --restarts 100000
+"""
+
+import argparse
+import os
+import subprocess
+import sys
+import tempfile
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+SOURCES = [
+    "Tools/timeout_bench/timeout_bench.c",
+    "App/Application/timeout/timeout.c",
+    "Middlewares/Third_Party/FreeRTOS/list.c",
+]
+
+# Каталог заглушек - первым: заменяет main.h и FreeRTOSConfig.h App
+INCLUDES = [
+    "Tools/timeout_bench",
+    "App/Application/timeout/include",
+    "Middlewares/Third_Party/FreeRTOS/include",
+]
+
+
+def build(cc, output):
+    """Собрать тест компилятором хоста."""
+    command = [cc, "-O2", "-std=gnu11", "-o", output]
+    command += ["-I" + os.path.join(ROOT, path) for path in INCLUDES]
+    command += [os.path.join(ROOT, path) for path in SOURCES]
+    subprocess.run(command, check=True)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--cc", default="cc", help="компилятор хоста")
+    parser.add_argument("--timers", type=int, default=10000, help="количество одновременных таймеров")
+    parser.add_argument("--span", type=int, default=60000, help="максимальная задержка таймера (тиков)")
+    parser.add_argument("--restarts", type=int, default=100000, help="количество перезапусков")
+    parser.add_argument("--seed", type=int, default=1, help="начальное значение генератора задержек")
+    args = parser.parse_args()
+
+    with tempfile.TemporaryDirectory() as directory:
+        output = os.path.join(directory, "timeout_bench")
+        build(args.cc, output)
+        return subprocess.run([output, str(args.timers), str(args.span),
+                               str(args.restarts), str(args.seed)]).returncode
+
+
+if __name__ == "__main__":
+    sys.exit(main())
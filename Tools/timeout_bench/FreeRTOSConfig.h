@@ -0,0 +1,58 @@
+/**
+ * Copyright (C) 2025 zhmaksim <zhiharev.maxim.alexandrovich@yandex.ru>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef FREERTOS_CONFIG_H
+#define FREERTOS_CONFIG_H
+
+/* Настройки FreeRTOS для сборки на хосте: совпадают с App в части списков и тиков */
+
+#include <stdint.h>
+
+#define configUSE_PREEMPTION                                1
+#define configUSE_PORT_OPTIMISED_TASK_SELECTION             0
+#define configUSE_TICKLESS_IDLE                             0
+#define configCPU_CLOCK_HZ                                  600000000
+#define configTICK_RATE_HZ                                  1000
+#define configMAX_PRIORITIES                                7
+#define configMINIMAL_STACK_SIZE                            128
+#define configMAX_TASK_NAME_LEN                             16
+#define configTICK_TYPE_WIDTH_IN_BITS                       TICK_TYPE_WIDTH_32_BITS
+#define configIDLE_SHOULD_YIELD                             0
+#define configUSE_MUTEXES                                   1
+#define configUSE_RECURSIVE_MUTEXES                         1
+#define configUSE_COUNTING_SEMAPHORES                       1
+
+#define configSUPPORT_STATIC_ALLOCATION                     0
+#define configSUPPORT_DYNAMIC_ALLOCATION                    1
+#define configTOTAL_HEAP_SIZE                               65536
+
+#define configUSE_IDLE_HOOK                                 0
+#define configUSE_TICK_HOOK                                 0
+#define configCHECK_FOR_STACK_OVERFLOW                      0
+#define configUSE_MALLOC_FAILED_HOOK                        0
+
+#define configUSE_TIMERS                                    1
+#define configTIMER_TASK_PRIORITY                           3
+#define configTIMER_QUEUE_LENGTH                            10
+#define configTIMER_TASK_STACK_DEPTH                        configMINIMAL_STACK_SIZE
+
+#define configASSERT( x )
+
+#define INCLUDE_vTaskDelete                     1
+#define INCLUDE_vTaskDelay                      1
+
+#endif /* FREERTOS_CONFIG_H */
@@ -0,0 +1,61 @@
+/**
+ * Copyright (C) 2025 zhmaksim <zhiharev.maxim.alexandrovich@yandex.ru>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PORTMACRO_H
+#define PORTMACRO_H
+
+/* Порт FreeRTOS для сборки на хосте без планировщика (один поток) */
+
+#include <stdint.h>
+
+#define portCHAR                char
+#define portFLOAT               float
+#define portDOUBLE              double
+#define portLONG                long
+#define portSHORT               short
+#define portSTACK_TYPE          uint32_t
+#define portBASE_TYPE           long
+
+typedef portSTACK_TYPE StackType_t;
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+typedef uint32_t TickType_t;
+
+#define portMAX_DELAY                           ( TickType_t ) 0xffffffffUL
+#define portTICK_TYPE_IS_ATOMIC                 1
+
+#define portSTACK_GROWTH                        ( -1 )
+#define portTICK_PERIOD_MS                      ( ( TickType_t ) 1000 / configTICK_RATE_HZ )
+#define portBYTE_ALIGNMENT                      8
+
+#define portYIELD()
+#define portYIELD_FROM_ISR( x )                 ( void ) ( x )
+#define portEND_SWITCHING_ISR( x )              ( void ) ( x )
+
+#define portDISABLE_INTERRUPTS()
+#define portENABLE_INTERRUPTS()
+#define portENTER_CRITICAL()
+#define portEXIT_CRITICAL()
+#define portSET_INTERRUPT_MASK_FROM_ISR()       0
+#define portCLEAR_INTERRUPT_MASK_FROM_ISR( x )  ( void ) ( x )
+
+#define portTASK_FUNCTION_PROTO( vFunction, pvParameters )  void vFunction( void * pvParameters )
+#define portTASK_FUNCTION( vFunction, pvParameters )        void vFunction( void * pvParameters )
+
+#define portNOP()
+
+#endif /* PORTMACRO_H */
@@ -0,0 +1,340 @@
+/**
+ * Copyright (C) 2025 zhmaksim <zhiharev.maxim.alexandrovich@yandex.ru>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * Сравнение службы таймаутов App (timeout.c) с программными таймерами
+ * FreeRTOS на хосте.
+ *
+ * Таймеры FreeRTOS моделируются операциями службы таймеров над списком
+ * list.c, которые выполняет xTimerStart()/xTimerStop() в задаче службы:
+ * удаление из списка активных и упорядоченная вставка vListInsert()
+ * (prvInsertTimerInActiveList), срабатывание - удаление головы списка
+ * (prvProcessExpiredTimer). Передача команды через очередь и переключение
+ * на задачу службы не учитываются - результат FreeRTOS занижен.
+ *
+ * Сборка и запуск: Tools/timeout_bench.py
+ */
+
+/* Includes ---------------------------------------------------------------- */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "timeout.h"
+#include "list.h"
+
+/* Private macros ---------------------------------------------------------- */
+
+/* Private constants ------------------------------------------------------- */
+
+/* Private types ----------------------------------------------------------- */
+
+/**
+ * @brief           Определение структуры данных таймера теста
+ */
+struct bench_timer {
+    struct timeout timeout;                     /*!< Таймаут службы App */
+
+    ListItem_t item;                            /*!< Элемент списка таймеров FreeRTOS */
+
+    uint32_t expires;                           /*!< Ожидаемый тик срабатывания */
+};
+
+
+/**
+ * @brief           Определение структуры данных результата этапа
+ */
+struct bench_result {
+    const char *name;                           /*!< Этап */
+
+    uint32_t count;                             /*!< Количество операций */
+
+    double wheel;                               /*!< Служба таймаутов (нс/операция) */
+
+    double list;                                /*!< Список FreeRTOS (нс/операция) */
+};
+
+/* Private variables ------------------------------------------------------- */
+
+static uint32_t tick;
+
+static struct bench_timer *timers;
+static uint32_t *delays;
+
+static List_t active_list;
+
+static uint32_t expired;
+static uint32_t errors;
+
+/* Private function prototypes --------------------------------------------- */
+
+static double bench_time(void);
+
+static void bench_callback(void *argument);
+
+static void list_start(struct bench_timer *timer, uint32_t delay);
+
+static void list_stop(struct bench_timer *timer);
+
+static void list_expire(void);
+
+static void wheel_expire(void);
+
+/* Private user code ------------------------------------------------------- */
+
+int main(int argc, char *argv[])
+{
+    uint32_t count = argc > 1 ? strtoul(argv[1], NULL, 0) : 10000;
+    uint32_t span = argc > 2 ? strtoul(argv[2], NULL, 0) : 60000;
+    uint32_t restarts = argc > 3 ? strtoul(argv[3], NULL, 0) : 100000;
+    uint32_t seed = argc > 4 ? strtoul(argv[4], NULL, 0) : 1;
+
+    struct bench_result result[4];
+    double start;
+
+    timers = calloc(count, sizeof(*timers));
+    delays = malloc((count + restarts) * sizeof(*delays));
+
+    if (timers == NULL || delays == NULL || count == 0 || span == 0 || span > TIMEOUT_MAX_DELAY)
+        return 1;
+
+    srand(seed);
+
+    for (uint32_t i = 0; i < count + restarts; i++) {
+        delays[i] = 1 + (uint32_t) rand() % span;
+    }
+
+    timeout_init();
+    vListInitialise(&active_list);
+
+    for (uint32_t i = 0; i < count; i++) {
+        timeout_setup(&timers[i].timeout, bench_callback, &timers[i]);
+        vListInitialiseItem(&timers[i].item);
+        listSET_LIST_ITEM_OWNER(&timers[i].item, &timers[i]);
+    }
+
+    /* Запуск count таймеров */
+    result[0] = (struct bench_result) { "start", count, 0, 0 };
+
+    start = bench_time();
+    for (uint32_t i = 0; i < count; i++) {
+        timeout_start(&timers[i].timeout, delays[i]);
+    }
+    result[0].wheel = bench_time() - start;
+
+    start = bench_time();
+    for (uint32_t i = 0; i < count; i++) {
+        list_start(&timers[i], delays[i]);
+    }
+    result[0].list = bench_time() - start;
+
+    /* Перезапуск при count активных таймерах (таймаут запроса продлевается) */
+    result[1] = (struct bench_result) { "restart", restarts, 0, 0 };
+
+    start = bench_time();
+    for (uint32_t i = 0; i < restarts; i++) {
+        timeout_start(&timers[i % count].timeout, delays[count + i]);
+    }
+    result[1].wheel = bench_time() - start;
+
+    start = bench_time();
+    for (uint32_t i = 0; i < restarts; i++) {
+        list_start(&timers[i % count], delays[count + i]);
+    }
+    result[1].list = bench_time() - start;
+
+    /* Остановка всех таймеров */
+    result[2] = (struct bench_result) { "stop", count, 0, 0 };
+
+    start = bench_time();
+    for (uint32_t i = 0; i < count; i++) {
+        timeout_stop(&timers[i].timeout);
+    }
+    result[2].wheel = bench_time() - start;
+
+    start = bench_time();
+    for (uint32_t i = 0; i < count; i++) {
+        list_stop(&timers[i]);
+    }
+    result[2].list = bench_time() - start;
+
+    /* Срабатывание всех таймеров с проверкой тика срабатывания */
+    result[3] = (struct bench_result) { "expire", count, 0, 0 };
+
+    for (uint32_t i = 0; i < count; i++) {
+        timers[i].expires = tick + delays[i];
+        timeout_start(&timers[i].timeout, delays[i]);
+    }
+
+    start = bench_time();
+    wheel_expire();
+    result[3].wheel = bench_time() - start;
+
+    uint32_t wheel_expired = expired;
+    uint32_t wheel_errors = errors;
+
+    tick = 0;
+    expired = 0;
+    errors = 0;
+
+    for (uint32_t i = 0; i < count; i++) {
+        list_start(&timers[i], delays[i]);
+    }
+
+    start = bench_time();
+    list_expire();
+    result[3].list = bench_time() - start;
+
+    const struct timeout_stats *stats = timeout_get_stats();
+
+    printf("timers %u, delay 1...%u ticks, restarts %u\n\n", count, span, restarts);
+    printf("%-8s %10s %14s %14s %8s\n", "stage", "ops", "wheel ns/op", "list ns/op", "ratio");
+
+    for (uint32_t i = 0; i < sizeof(result) / sizeof(result[0]); i++) {
+        double wheel = result[i].wheel * 1e9 / result[i].count;
+        double list = result[i].list * 1e9 / result[i].count;
+
+        printf("%-8s %10u %14.1f %14.1f %7.1fx\n", result[i].name, result[i].count, wheel, list, list / wheel);
+    }
+
+    printf("\nwheel: expired %u/%u, late or early %u, cascaded %u, batches %u, batch max %u\n",
+           wheel_expired, count, wheel_errors, stats->cascaded, stats->batches, stats->batch_max);
+    printf("list:  expired %u/%u, late or early %u\n", expired, count, errors);
+
+    return wheel_expired == count && expired == count && wheel_errors == 0 && errors == 0 ? 0 : 1;
+}
+/* ------------------------------------------------------------------------- */
+
+/* Функции FreeRTOS, используемые службой таймаутов (без планировщика) */
+
+TickType_t xTaskGetTickCount(void)
+{
+    return tick;
+}
+/* ------------------------------------------------------------------------- */
+
+BaseType_t xTaskCreate(TaskFunction_t pxTaskCode,
+                       const char * const pcName,
+                       const configSTACK_DEPTH_TYPE uxStackDepth,
+                       void * const pvParameters,
+                       UBaseType_t uxPriority,
+                       TaskHandle_t * const pxCreatedTask)
+{
+    /* Задача службы не создается: timeout_process() вызывает тест */
+    *pxCreatedTask = NULL;
+
+    return pdPASS;
+}
+/* ------------------------------------------------------------------------- */
+
+BaseType_t xTaskGenericNotify(TaskHandle_t xTaskToNotify,
+                              UBaseType_t uxIndexToNotify,
+                              uint32_t ulValue,
+                              eNotifyAction eAction,
+                              uint32_t * pulPreviousNotificationValue)
+{
+    return pdPASS;
+}
+/* ------------------------------------------------------------------------- */
+
+uint32_t ulTaskGenericNotifyTake(UBaseType_t uxIndexToWaitOn,
+                                 BaseType_t xClearCountOnExit,
+                                 TickType_t xTicksToWait)
+{
+    return 0;
+}
+/* ------------------------------------------------------------------------- */
+
+static double bench_time(void)
+{
+    struct timespec time;
+
+    clock_gettime(CLOCK_MONOTONIC, &time);
+
+    return time.tv_sec + time.tv_nsec * 1e-9;
+}
+/* ------------------------------------------------------------------------- */
+
+static void bench_callback(void *argument)
+{
+    struct bench_timer *timer = argument;
+
+    if (timer->expires != tick)
+        errors++;
+
+    expired++;
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Запустить таймер FreeRTOS (команда tmrCOMMAND_START в задаче службы)
+ */
+static void list_start(struct bench_timer *timer, uint32_t delay)
+{
+    if (listIS_CONTAINED_WITHIN(NULL, &timer->item) == pdFALSE)
+        uxListRemove(&timer->item);
+
+    timer->expires = tick + delay;
+    listSET_LIST_ITEM_VALUE(&timer->item, timer->expires);
+    vListInsert(&active_list, &timer->item);
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Остановить таймер FreeRTOS (команда tmrCOMMAND_STOP в задаче службы)
+ */
+static void list_stop(struct bench_timer *timer)
+{
+    if (listIS_CONTAINED_WITHIN(NULL, &timer->item) == pdFALSE)
+        uxListRemove(&timer->item);
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Обработать срабатывания FreeRTOS (prvProcessTimerOrBlockTask)
+ */
+static void list_expire(void)
+{
+    while (listLIST_IS_EMPTY(&active_list) == pdFALSE) {
+        tick = listGET_ITEM_VALUE_OF_HEAD_ENTRY(&active_list);
+
+        while (listLIST_IS_EMPTY(&active_list) == pdFALSE
+            && listGET_ITEM_VALUE_OF_HEAD_ENTRY(&active_list) <= tick) {
+            struct bench_timer *timer = listGET_OWNER_OF_HEAD_ENTRY(&active_list);
+
+            uxListRemove(&timer->item);
+            bench_callback(timer);
+        }
+    }
+}
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief           Обработать срабатывания службы таймаутов (задача службы)
+ */
+static void wheel_expire(void)
+{
+    while (true) {
+        uint32_t delay = timeout_process();
+
+        if (delay == portMAX_DELAY)
+            break;
+
+        tick += delay;
+    }
+}
+/* ------------------------------------------------------------------------- */
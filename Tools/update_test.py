@@ -0,0 +1,334 @@
+#!/usr/bin/env python3
+#
+# Copyright (C) 2025 zhmaksim <zhiharev.maxim.alexandrovich@yandex.ru>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+"""
+Проверка Tools/update_tool.py на модели обновления Boot через pty.
+
+Модель повторяет Boot/Application/update/update.c и прием Boot/Application/
+core/usart.c: кадры фиксированного размера в двойной буфер, сброс неполного
+кадра по паузе на линии, стирание сектора следующего кадра заранее
+(erase-ahead), состояние передачи в SRAM_BKP и FLASH (NOR: программирование
+только сбрасывает биты) сохраняются при сбросе. update_tool.py работает
+с подчиненной стороной pty.openpty() как с портом ST-LINK VCP.
+
+Случаи: передача без ошибок, потеря байтов кадра и искаженный кадр
+(повторная синхронизация кадром START с продолжением с записанного сектора),
+сброс Boot посреди передачи с продолжением тем же образом, передача другого
+образа после сброса (с начала).
+
+Пример:
+    Tools/update_test.py
+"""
+
+import argparse
+import os
+import pty
+import random
+import select
+import struct
+import sys
+import threading
+import tty
+import zlib
+
+import update_tool
+from test_check import Check
+
+IMAGE_SLOT_SIZE = 0x00800000
+
+MX25UW_PAGE_SIZE = 0x100
+
+UPDATE_FRAME_SIZE = update_tool.UPDATE_HEADER_SIZE + update_tool.UPDATE_CHUNK_SIZE
+
+(UPDATE_ACK, UPDATE_NAK_CRC, UPDATE_NAK_OFFSET,
+ UPDATE_NAK_PARAM, UPDATE_NAK_FLASH, UPDATE_NAK_VERIFY) = range(6)
+
+# Пауза на линии, по которой модель сбрасывает неполный кадр (с):
+# меньше паузы update_tool.py (UPDATE_IDLE)
+MODEL_IDLE = 0.02
+
+# Ожидание ответа при отключенной модели (с): сокращает тест сброса
+TEST_TIMEOUT = 0.3
+
+
+class Backup:
+    """SRAM_BKP и внешняя FLASH: сохраняются при сбросе Boot."""
+
+    def __init__(self):
+        self.magic = False
+        self.slot = 0
+        self.size = 0
+        self.image_id = 0
+        self.written = 0
+        # Слоты содержат предыдущий образ: без стирания запись его искажает
+        self.flash = [bytearray(IMAGE_SLOT_SIZE) for _ in range(2)]
+
+
+class BootModel:
+    """Обработка кадров update.c, прием кадров usart.c."""
+
+    def __init__(self, fd, backup, lose=None, flip=None, halt_after=None):
+        self.fd = fd
+        self.backup = backup
+        self.lose = lose                # (позиция в потоке, байт): потеря байтов
+        self.flip = flip                # позиция в потоке: искаженный байт
+        self.halt_after = halt_after    # сброс Boot после записи кадров
+        self.position = 0
+        self.rx = bytearray()
+        self.erase_pending = False
+        self.erase_offset = 0
+        self.halted = False
+        self.done = False
+        self.starts = 0
+        self.data_offsets = []
+        self.erase_ahead = 0
+        self.erase_on_demand = 0
+        self.idle_resets = 0
+        self.stop = threading.Event()
+        self.thread = threading.Thread(target=self.run, daemon=True)
+
+    def run(self):
+        while not self.stop.is_set():
+            if not select.select([self.fd], [], [], MODEL_IDLE)[0]:
+                # Пауза посреди кадра - начать прием кадра заново
+                if self.rx:
+                    self.rx.clear()
+                    self.idle_resets += 1
+                continue
+
+            try:
+                chunk = os.read(self.fd, 4096)
+            except OSError:
+                return
+
+            self.receive(chunk)
+
+    def receive(self, chunk):
+        start, self.position = self.position, self.position + len(chunk)
+        data = bytearray(chunk)
+
+        if self.flip is not None and start <= self.flip < self.position:
+            data[self.flip - start] ^= 0x01
+        if self.lose is not None and start <= self.lose[0] < self.position:
+            del data[self.lose[0] - start:self.lose[0] - start + self.lose[1]]
+
+        if self.halted:
+            return
+
+        self.rx += data
+        while len(self.rx) >= UPDATE_FRAME_SIZE and not self.halted:
+            frame, self.rx = bytes(self.rx[:UPDATE_FRAME_SIZE]), self.rx[UPDATE_FRAME_SIZE:]
+            self.process(frame)
+
+    def process(self, frame):
+        magic, frame_type, length, offset, crc = struct.unpack_from(update_tool.UPDATE_HEADER_FORMAT, frame)
+        data = frame[update_tool.UPDATE_HEADER_SIZE:update_tool.UPDATE_HEADER_SIZE + length]
+
+        if magic != update_tool.UPDATE_FRAME_MAGIC or length > update_tool.UPDATE_CHUNK_SIZE:
+            self.respond(frame_type, UPDATE_NAK_CRC)
+        elif crc != zlib.crc32(frame[:update_tool.UPDATE_HEADER_SIZE - 4] + data):
+            self.respond(frame_type, UPDATE_NAK_CRC)
+        elif frame_type == update_tool.UPDATE_FRAME_START:
+            self.start(frame_type, data)
+        elif frame_type == update_tool.UPDATE_FRAME_DATA:
+            self.data(frame_type, offset, data)
+        elif frame_type == update_tool.UPDATE_FRAME_END:
+            self.end(frame_type)
+        else:
+            self.respond(frame_type, UPDATE_NAK_PARAM)
+
+    def start(self, frame_type, data):
+        state = self.backup
+        self.starts += 1
+
+        if len(data) != 12:
+            self.respond(frame_type, UPDATE_NAK_PARAM)
+            return
+
+        slot, size, image_id = struct.unpack("<III", data)
+        if slot >= 2 or size == 0 or size > IMAGE_SLOT_SIZE or size % 4:
+            self.respond(frame_type, UPDATE_NAK_PARAM)
+            return
+
+        # Продолжить передачу того же образа с последнего записанного сектора
+        if not state.magic or (state.slot, state.size, state.image_id) != (slot, size, image_id):
+            state.magic = True
+            state.slot, state.size, state.image_id = slot, size, image_id
+            state.written = 0
+
+        self.start_erase_ahead()
+        self.respond(frame_type, UPDATE_ACK)
+
+    def data(self, frame_type, offset, data):
+        state = self.backup
+
+        if not state.magic:
+            self.respond(frame_type, UPDATE_NAK_PARAM)
+            return
+        if offset != state.written:
+            self.respond(frame_type, UPDATE_NAK_OFFSET)
+            return
+        if len(data) != min(state.size - state.written, update_tool.UPDATE_CHUNK_SIZE):
+            self.respond(frame_type, UPDATE_NAK_PARAM)
+            return
+
+        # Сектор стирается заранее, иначе стереть сейчас
+        if not self.erase_pending or self.erase_offset != state.written:
+            self.erase(state.written)
+            self.erase_on_demand += 1
+        self.erase_pending = False
+
+        flash = state.flash[state.slot]
+        for i in range(0, len(data), MX25UW_PAGE_SIZE):
+            for j, value in enumerate(data[i:i + MX25UW_PAGE_SIZE]):
+                flash[state.written + i + j] &= value
+
+        self.data_offsets.append(offset)
+        state.written += len(data)
+        self.start_erase_ahead()
+        self.respond(frame_type, UPDATE_ACK)
+
+        if self.halt_after is not None and len(self.data_offsets) == self.halt_after:
+            self.halted = True
+
+    def end(self, frame_type):
+        state = self.backup
+
+        if not state.magic or state.written != state.size:
+            self.respond(frame_type, UPDATE_NAK_OFFSET)
+            return
+
+        if zlib.crc32(state.flash[state.slot][:state.size]) != state.image_id:
+            state.magic = False
+            self.respond(frame_type, UPDATE_NAK_VERIFY)
+            return
+
+        state.magic = False
+        self.respond(frame_type, UPDATE_ACK)
+        self.done = True
+
+    def start_erase_ahead(self):
+        state = self.backup
+        if state.written >= state.size:
+            return
+        self.erase(state.written)
+        self.erase_offset = state.written
+        self.erase_pending = True
+        self.erase_ahead += 1
+
+    def erase(self, offset):
+        flash = self.backup.flash[self.backup.slot]
+        flash[offset:offset + update_tool.UPDATE_CHUNK_SIZE] = b"\xff" * update_tool.UPDATE_CHUNK_SIZE
+
+    def respond(self, frame_type, status):
+        offset = self.backup.written if self.backup.magic else 0
+        header = struct.pack("<IHHI", update_tool.UPDATE_RESPONSE_MAGIC, frame_type, status, offset)
+        os.write(self.fd, header + struct.pack("<I", zlib.crc32(header)))
+
+
+def transfer(backup, image, slot, **faults):
+    """Передать образ update_tool.py в модель Boot через pty."""
+    master, slave = pty.openpty()
+    tty.setraw(slave)
+    model = BootModel(master, backup, **faults)
+    model.thread.start()
+
+    link = update_tool.Link(os.ttyname(slave), 921600)
+    updater = update_tool.Updater(link, image, slot)
+    error = None
+
+    try:
+        updater.send(lambda offset: None)
+    except RuntimeError as exception:
+        error = exception
+    finally:
+        model.stop.set()
+        model.thread.join()
+        for fd in (link.fd, slave, master):
+            os.close(fd)
+
+    return model, error
+
+
+def run_tests(sectors, seed):
+    check = Check()
+
+    generator = random.Random(seed)
+    chunk = update_tool.UPDATE_CHUNK_SIZE
+    image = generator.randbytes(sectors * chunk + chunk // 2 + 4)
+    other = generator.randbytes(len(image))
+    frames = -(-len(image) // chunk)
+
+    # Ожидание ответа сокращается: модель после сброса не отвечает
+    update_tool.UPDATE_TIMEOUT = TEST_TIMEOUT
+
+    backup = Backup()
+    model, error = transfer(backup, image, 1)
+    check("clean: transfer", error is None and model.done)
+    check("clean: slot content", backup.flash[1][:len(image)] == image)
+    check("clean: frames in order", model.data_offsets == list(range(0, len(image), chunk)))
+    check("clean: every sector erased ahead", model.erase_on_demand == 0 and model.erase_ahead == frames)
+    check("clean: state cleared", not backup.magic)
+    check("clean: other slot untouched", not any(backup.flash[0][:len(image)]))
+
+    backup = Backup()
+    model, error = transfer(backup, image, 0, lose=(3 * UPDATE_FRAME_SIZE + 1000, 200))
+    check("lost bytes: transfer", error is None and model.done)
+    check("lost bytes: slot content", backup.flash[0][:len(image)] == image)
+    check("lost bytes: resynchronized by START", model.starts > 1)
+    check("lost bytes: resumed at written sector", model.data_offsets == list(range(0, len(image), chunk)))
+    check("lost bytes: every sector erased ahead", model.erase_on_demand == 0)
+
+    backup = Backup()
+    model, error = transfer(backup, image, 0, flip=5 * UPDATE_FRAME_SIZE + 100)
+    check("corrupted frame: transfer", error is None and model.done)
+    check("corrupted frame: slot content", backup.flash[0][:len(image)] == image)
+    check("corrupted frame: resumed at written sector", model.data_offsets == list(range(0, len(image), chunk)))
+
+    halt = frames // 2
+    backup = Backup()
+    model, error = transfer(backup, image, 1, halt_after=halt)
+    check("reset: first session fails", error is not None and not model.done)
+    check("reset: progress kept in SRAM_BKP", backup.magic and backup.written == halt * chunk)
+
+    model, error = transfer(backup, image, 1, lose=(UPDATE_FRAME_SIZE + 2000, 100))
+    check("reset: resumed transfer", error is None and model.done)
+    check("reset: resumed at written sector after lost frame",
+          model.data_offsets == list(range(halt * chunk, len(image), chunk)))
+    check("reset: slot content", backup.flash[1][:len(image)] == image)
+
+    backup = Backup()
+    transfer(backup, image, 1, halt_after=halt)
+    model, error = transfer(backup, other, 1)
+    check("reset: other image starts over", error is None and model.data_offsets[0] == 0)
+    check("reset: other image content", backup.flash[1][:len(other)] == other)
+
+    return check.summary()
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--sectors", type=int, default=12, help="размер тестового образа (секторов)")
+    parser.add_argument("--seed", type=int, default=1, help="начальное значение генератора образа")
+    args = parser.parse_args()
+
+    return run_tests(args.sectors, args.seed)
+
+
+if __name__ == "__main__":
+    sys.exit(main())
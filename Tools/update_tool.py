@@ -0,0 +1,222 @@
+#!/usr/bin/env python3
+#
+# Copyright (C) 2025 zhmaksim <zhiharev.maxim.alexandrovich@yandex.ru>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+"""
+Запись образа App во внешнюю FLASH через Boot по USART (ST-LINK VCP).
+
+Boot входит в режим обновления, если при сбросе нажата кнопка USER или
+ни один слот не содержит корректного образа. Образ (результат
+Tools/image_tool.py) передается кадрами по сектору FLASH, в канале
+одновременно находится до двух кадров: пока Boot программирует один,
+DMA принимает следующий. Прерванная передача того же образа
+продолжается с последнего записанного сектора.
+
+Формат кадров - Boot/Application/update/include/update.h.
+
+Пример:
+    Tools/update_tool.py App_b.img --slot b --port /dev/ttyACM0
+"""
+
+import argparse
+import os
+import select
+import struct
+import sys
+import termios
+import time
+import tty
+import zlib
+
+UPDATE_CHUNK_SIZE = 0x1000
+
+UPDATE_FRAME_MAGIC = 0x46445055
+UPDATE_RESPONSE_MAGIC = 0x52445055
+
+UPDATE_FRAME_START = 1
+UPDATE_FRAME_DATA = 2
+UPDATE_FRAME_END = 3
+
+UPDATE_ACK = 0
+UPDATE_STATUS = ["ACK", "NAK_CRC", "NAK_OFFSET", "NAK_PARAM", "NAK_FLASH", "NAK_VERIFY"]
+
+# magic, type, length, offset, crc
+UPDATE_HEADER_FORMAT = "<IHHII"
+UPDATE_HEADER_SIZE = struct.calcsize(UPDATE_HEADER_FORMAT)
+UPDATE_RESPONSE_SIZE = UPDATE_HEADER_SIZE
+
+UPDATE_WINDOW = 2               # двойной буфер приема Boot
+UPDATE_TIMEOUT = 2.0            # ожидание ответа (с)
+UPDATE_IDLE = 0.05              # пауза, по которой Boot сбрасывает неполный кадр (с)
+UPDATE_RETRIES = 10
+
+IMAGE_SLOT = {"a": 0, "b": 1}
+
+BAUDRATES = {115200: termios.B115200, 230400: termios.B230400,
+             460800: termios.B460800, 921600: termios.B921600}
+
+
+class Link:
+    """Последовательный порт (или pty) в режиме raw."""
+
+    def __init__(self, port, baudrate):
+        self.fd = os.open(port, os.O_RDWR | os.O_NOCTTY)
+        if os.isatty(self.fd):
+            tty.setraw(self.fd)
+            attr = termios.tcgetattr(self.fd)
+            attr[4] = attr[5] = BAUDRATES[baudrate]
+            termios.tcsetattr(self.fd, termios.TCSANOW, attr)
+        self.rx = bytearray()
+
+    def write(self, data):
+        view = memoryview(data)
+        while view:
+            view = view[os.write(self.fd, view):]
+
+    def read(self, size, timeout):
+        deadline = time.monotonic() + timeout
+        while len(self.rx) < size:
+            remaining = deadline - time.monotonic()
+            if remaining <= 0 or not select.select([self.fd], [], [], remaining)[0]:
+                return None
+            self.rx += os.read(self.fd, 4096)
+        data, self.rx = bytes(self.rx[:size]), self.rx[size:]
+        return data
+
+    def drain(self):
+        """Дождаться паузы на линии и отбросить принятые данные."""
+        time.sleep(UPDATE_IDLE)
+        while select.select([self.fd], [], [], UPDATE_IDLE)[0]:
+            os.read(self.fd, 4096)
+        self.rx.clear()
+
+
+def build_frame(frame_type, offset, data):
+    header = struct.pack("<IHHI", UPDATE_FRAME_MAGIC, frame_type, len(data), offset)
+    crc = zlib.crc32(header + data)
+    return header + struct.pack("<I", crc) + data.ljust(UPDATE_CHUNK_SIZE, b"\xff")
+
+
+def parse_response(data):
+    if data is None:
+        return None
+    magic, frame_type, status, offset, crc = struct.unpack(UPDATE_HEADER_FORMAT, data)
+    if magic != UPDATE_RESPONSE_MAGIC or crc != zlib.crc32(data[:UPDATE_HEADER_SIZE - 4]):
+        return None
+    return frame_type, status, offset
+
+
+class Updater:
+    def __init__(self, link, image, slot):
+        self.link = link
+        self.image = image
+        self.slot = slot
+        self.image_id = zlib.crc32(image)
+
+    def request(self, frame_type, offset, data):
+        """Передать кадр и дождаться ответа (с повторами)."""
+        for _ in range(UPDATE_RETRIES):
+            self.link.write(build_frame(frame_type, offset, data))
+            response = parse_response(self.link.read(UPDATE_RESPONSE_SIZE, UPDATE_TIMEOUT))
+            if response is not None and response[1] == UPDATE_ACK:
+                return response[2]
+            if response is not None and UPDATE_STATUS[response[1]] == "NAK_FLASH":
+                raise RuntimeError("flash error")
+            if response is not None and UPDATE_STATUS[response[1]] == "NAK_VERIFY":
+                raise RuntimeError("slot CRC does not match the image, send it again")
+            self.link.drain()
+        raise RuntimeError(f"no response to frame type {frame_type}")
+
+    def start(self):
+        data = struct.pack("<III", self.slot, len(self.image), self.image_id)
+        return self.request(UPDATE_FRAME_START, 0, data)
+
+    def send(self, progress):
+        offset = self.start()
+        if offset:
+            print(f"resuming at {offset} bytes")
+
+        queued = []             # смещения кадров в канале
+        sent = offset
+        retries = 0
+
+        while offset < len(self.image):
+            while len(queued) < UPDATE_WINDOW and sent < len(self.image):
+                self.link.write(build_frame(UPDATE_FRAME_DATA, sent,
+                                            self.image[sent:sent + UPDATE_CHUNK_SIZE]))
+                queued.append(sent)
+                sent += UPDATE_CHUNK_SIZE
+
+            response = parse_response(self.link.read(UPDATE_RESPONSE_SIZE, UPDATE_TIMEOUT))
+
+            if response is not None and response[1] == UPDATE_ACK:
+                queued.pop(0)
+                offset = response[2]
+                retries = 0
+                progress(offset)
+                continue
+
+            if response is not None and UPDATE_STATUS[response[1]] == "NAK_FLASH":
+                raise RuntimeError("flash error")
+
+            # Потеря синхронизации: дождаться паузы и запросить смещение у Boot
+            retries += 1
+            if retries > UPDATE_RETRIES:
+                raise RuntimeError(f"transfer failed at {offset} bytes")
+            self.link.drain()
+            offset = sent = self.start()
+            queued.clear()
+
+        self.request(UPDATE_FRAME_END, len(self.image), b"")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("image", help="образ со заголовком (Tools/image_tool.py)")
+    parser.add_argument("--slot", choices=IMAGE_SLOT, required=True, help="слот образа")
+    parser.add_argument("--port", default="/dev/ttyACM0", help="последовательный порт ST-LINK VCP")
+    parser.add_argument("--baudrate", type=int, choices=BAUDRATES, default=921600,
+                        help="скорость USART (должна совпадать с USART_BAUDRATE)")
+    args = parser.parse_args()
+
+    with open(args.image, "rb") as file:
+        image = file.read()
+
+    # Boot программирует OPI DTR словами, дополнить образ до кратного 4
+    image += b"\xff" * (-len(image) % 4)
+
+    link = Link(args.port, args.baudrate)
+    updater = Updater(link, image, IMAGE_SLOT[args.slot])
+    begin = time.monotonic()
+
+    def progress(offset):
+        print(f"\r{offset}/{len(image)} bytes", end="", flush=True)
+
+    try:
+        updater.send(progress)
+    except RuntimeError as error:
+        print(f"\n{args.image}: {error}", file=sys.stderr)
+        return 1
+
+    elapsed = time.monotonic() - begin
+    print(f"\n{args.image}: slot {args.slot}, {len(image)} bytes in {elapsed:.1f} s "
+          f"({len(image) / elapsed / 1024:.1f} KiB/s)")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())